@@ -1,19 +1,45 @@
 #include "S9xBridge.hpp"
+#include "PixelConverter.hpp"
 
 using namespace SNESOnline;
 
+	// converts the native 16-bit frame into 32-bit pixels with the given byte order
+	static void ConvertFrame(const ScreenFrame& frame, unsigned char* target, int targetPitch, bool bgra)
+	{
+		PixelConverter converter((SourceFormat)frame.format, bgra ? TargetLayout::BGRA : TargetLayout::RGBA);
+		converter.Convert(frame.pixels, frame.pitch, target, targetPitch, frame.width, frame.height);
+	}
+
+	static const ScreenFrame* acquiredFrame = nullptr;
+
+	extern "C" uint64_t gameconsole_acquire_screen(int* width, int* height)
+	{
+		acquiredFrame = &S9xBridge::GetConsole().GetFrames().AcquireLatest();
+
+		*width = acquiredFrame->width;
+		*height = acquiredFrame->height;
+		return acquiredFrame->sequence;
+	}
 
-extern "C" int gameconsole_get_screen_width() { return S9xBridge::screenWidth; }
-extern "C" int gameconsole_get_screen_height() { return S9xBridge::screenHeight; }
+	extern "C" bool gameconsole_convert_screen(void* target, int targetPitch, bool bgra)
+	{
+		if ((acquiredFrame == nullptr) || (acquiredFrame->sequence == 0) || (targetPitch < acquiredFrame->width * 4))
+			return false;
+
+		ConvertFrame(*acquiredFrame, (unsigned char*)target, targetPitch, bgra);
+		return true;
+	}
+
+extern "C" int gameconsole_get_screen_width() { return (acquiredFrame != nullptr) ? acquiredFrame->width : 0; }
+extern "C" int gameconsole_get_screen_height() { return (acquiredFrame != nullptr) ? acquiredFrame->height : 0; }
 
 	extern "C" bool gameconsole_read_screen(int width, int height, int* pixelsRgbX)
 	{
-		if((width < 0) || (height < 0) || (width * height * 4 < S9xBridge::pixels.size())) {
+		if ((acquiredFrame == nullptr) || (width < acquiredFrame->width) || (height < acquiredFrame->height)) {
 			return false;
 		}
 
-		memcpy(pixelsRgbX, S9xBridge::pixels.data(), S9xBridge::pixels.size());
-		return true;
+		return gameconsole_convert_screen(pixelsRgbX, width * 4, false);
 	}
 
 	extern "C" bool gameconsole_reset(const char* romFile, const char* sramFile)
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <cstdint>
+
+namespace SNESOnline
+{
+	// A finished frame as rendered by the emulator, still in its native 16-bit pixel format.
+	struct ScreenFrame
+	{
+		std::vector<uint16_t> storage;
+		uint16_t* pixels = nullptr;	// first visible pixel inside storage
+		int width = 0;
+		int height = 0;
+		int pitch = 0;				// in bytes, like GFX.Pitch
+		int format = 0;				// pixform.h format the emulator rendered in
+		uint64_t sequence = 0;		// 0 means "no frame was published into this slot yet"
+	};
+
+	// Lock-free triple buffer between the emulation thread (producer) and the presenter
+	// (consumer). The emulator renders straight into the back buffer, so publishing a frame
+	// is a pointer exchange and never copies pixels. The consumer always gets the most
+	// recent frame; frames it was too slow for are silently replaced.
+	class FrameExchange
+	{
+	private:
+		static const int FreshBit = 4;
+
+		ScreenFrame frames[3];
+		int back = 0;						// owned by producer
+		int front = 1;						// owned by consumer
+		std::atomic_int middle;				// slot index, plus FreshBit if not yet acquired
+		uint64_t nextSequence = 1;
+
+	public:
+		FrameExchange() : middle(2) { }
+
+		FrameExchange(const FrameExchange&) = delete;
+		FrameExchange& operator=(const FrameExchange&) = delete;
+
+		// allocates all three slots on first use; later calls (ROM reloads) keep them, since the
+		// presenter may still be reading the last frame of the previous session
+		void Init(size_t sizeInBytes, size_t offsetInBytes, int pitch)
+		{
+			if (!frames[0].storage.empty())
+				return;
+
+			for (auto& frame : frames)
+			{
+				frame.storage.assign(sizeInBytes / 2, 0);
+				frame.pixels = frame.storage.data() + offsetInBytes / 2;
+				frame.pitch = pitch;
+			}
+		}
+
+		// producer side; the buffer the emulator is currently rendering into
+		ScreenFrame& GetBackBuffer() { return frames[back]; }
+
+		// producer side; hands out the back buffer and returns the new one to render into
+		ScreenFrame& Publish(int width, int height, int format)
+		{
+			ScreenFrame& frame = frames[back];
+			frame.width = width;
+			frame.height = height;
+			frame.format = format;
+			frame.sequence = nextSequence++;
+
+			back = middle.exchange(back | FreshBit, std::memory_order_acq_rel) & ~FreshBit;
+			return frames[back];
+		}
+
+		// consumer side; the returned frame stays valid until the next call
+		const ScreenFrame& AcquireLatest()
+		{
+			if (middle.load(std::memory_order_acquire) & FreshBit)
+				front = middle.exchange(front, std::memory_order_acq_rel) & ~FreshBit;
+
+			return frames[front];
+		}
+	};
+}
@@ -0,0 +1,337 @@
+#include "PixelConverter.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+	#define PIXELCONV_HAVE_SSE2
+	#include <emmintrin.h>
+
+	#if defined(_MSC_VER)
+		#define PIXELCONV_HAVE_AVX2
+		#define PIXELCONV_TARGET_AVX2
+		#include <intrin.h>
+		#include <immintrin.h>
+	#elif defined(__GNUC__)
+		#define PIXELCONV_HAVE_AVX2
+		#define PIXELCONV_TARGET_AVX2 __attribute__((target("avx2")))
+		#include <immintrin.h>
+	#endif
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+	#define PIXELCONV_HAVE_NEON
+	#include <arm_neon.h>
+#endif
+
+namespace SNESOnline
+{
+	enum { Red, Green, Blue, Alpha };
+
+	///////////////////////////////////////////////////////////////////////////////////////
+	////////// Scalar
+	///////////////////////////////////////////////////////////////////////////////////////
+
+	static inline uint8_t ExpandChannel(uint32_t pixel, int shift, int bits)
+	{
+		if (bits == 0)
+			return 255;
+
+		uint32_t value = (pixel >> shift) & ((1 << bits) - 1);
+
+		// replicate the top bits into the new low bits, so 0x1f becomes 0xff and not 0xf8
+		return (uint8_t)((value << (8 - bits)) | (value >> (2 * bits - 8)));
+	}
+
+	static void ConvertScalar(const ConversionPlan& plan, const uint16_t* src, uint8_t* dst, int count)
+	{
+		for (int i = 0; i < count; i++, dst += 4)
+		{
+			uint8_t channels[4];
+
+			for (int c = 0; c < 4; c++)
+				channels[c] = ExpandChannel(src[i], plan.shift[c], plan.bits[c]);
+
+			dst[0] = channels[plan.order[0]];
+			dst[1] = channels[plan.order[1]];
+			dst[2] = channels[plan.order[2]];
+			dst[3] = channels[plan.order[3]];
+		}
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////
+	////////// SSE2 (8 pixels per iteration)
+	///////////////////////////////////////////////////////////////////////////////////////
+
+#ifdef PIXELCONV_HAVE_SSE2
+	static void ConvertSSE2(const ConversionPlan& plan, const uint16_t* src, uint8_t* dst, int count)
+	{
+		__m128i shift[3], mask[3], left[3], right[3];
+
+		for (int c = 0; c < 3; c++)
+		{
+			shift[c] = _mm_cvtsi32_si128(plan.shift[c]);
+			mask[c] = _mm_set1_epi16((short)((1 << plan.bits[c]) - 1));
+			left[c] = _mm_cvtsi32_si128(8 - plan.bits[c]);
+			right[c] = _mm_cvtsi32_si128(2 * plan.bits[c] - 8);
+		}
+
+		int i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			__m128i pixels = _mm_loadu_si128((const __m128i*)(src + i));
+			__m128i channels[4];
+
+			for (int c = 0; c < 3; c++)
+			{
+				__m128i value = _mm_and_si128(_mm_srl_epi16(pixels, shift[c]), mask[c]);
+				channels[c] = _mm_or_si128(_mm_sll_epi16(value, left[c]), _mm_srl_epi16(value, right[c]));
+			}
+			channels[Alpha] = _mm_set1_epi16(0xff);
+
+			// every 16-bit lane now holds one 8-bit channel; pair them up and interleave to 32 bits
+			__m128i lo = _mm_or_si128(channels[plan.order[0]], _mm_slli_epi16(channels[plan.order[1]], 8));
+			__m128i hi = _mm_or_si128(channels[plan.order[2]], _mm_slli_epi16(channels[plan.order[3]], 8));
+
+			_mm_storeu_si128((__m128i*)(dst + i * 4), _mm_unpacklo_epi16(lo, hi));
+			_mm_storeu_si128((__m128i*)(dst + i * 4 + 16), _mm_unpackhi_epi16(lo, hi));
+		}
+
+		ConvertScalar(plan, src + i, dst + i * 4, count - i);
+	}
+#endif
+
+	///////////////////////////////////////////////////////////////////////////////////////
+	////////// AVX2 (16 pixels per iteration)
+	///////////////////////////////////////////////////////////////////////////////////////
+
+#ifdef PIXELCONV_HAVE_AVX2
+	PIXELCONV_TARGET_AVX2
+	static void ConvertAVX2(const ConversionPlan& plan, const uint16_t* src, uint8_t* dst, int count)
+	{
+		__m128i shift[3], left[3], right[3];
+		__m256i mask[3];
+
+		for (int c = 0; c < 3; c++)
+		{
+			shift[c] = _mm_cvtsi32_si128(plan.shift[c]);
+			mask[c] = _mm256_set1_epi16((short)((1 << plan.bits[c]) - 1));
+			left[c] = _mm_cvtsi32_si128(8 - plan.bits[c]);
+			right[c] = _mm_cvtsi32_si128(2 * plan.bits[c] - 8);
+		}
+
+		int i = 0;
+		for (; i + 16 <= count; i += 16)
+		{
+			__m256i pixels = _mm256_loadu_si256((const __m256i*)(src + i));
+			__m256i channels[4];
+
+			for (int c = 0; c < 3; c++)
+			{
+				__m256i value = _mm256_and_si256(_mm256_srl_epi16(pixels, shift[c]), mask[c]);
+				channels[c] = _mm256_or_si256(_mm256_sll_epi16(value, left[c]), _mm256_srl_epi16(value, right[c]));
+			}
+			channels[Alpha] = _mm256_set1_epi16(0xff);
+
+			__m256i lo = _mm256_or_si256(channels[plan.order[0]], _mm256_slli_epi16(channels[plan.order[1]], 8));
+			__m256i hi = _mm256_or_si256(channels[plan.order[2]], _mm256_slli_epi16(channels[plan.order[3]], 8));
+
+			// unpack works per 128-bit lane, so pixels come out as [0-3, 8-11] and [4-7, 12-15]
+			__m256i first = _mm256_unpacklo_epi16(lo, hi);
+			__m256i second = _mm256_unpackhi_epi16(lo, hi);
+
+			_mm256_storeu_si256((__m256i*)(dst + i * 4), _mm256_permute2x128_si256(first, second, 0x20));
+			_mm256_storeu_si256((__m256i*)(dst + i * 4 + 32), _mm256_permute2x128_si256(first, second, 0x31));
+		}
+
+		ConvertScalar(plan, src + i, dst + i * 4, count - i);
+	}
+
+	static bool IsAVX2Supported()
+	{
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7)
+			return false;
+
+		// the OS must save YMM registers on context switches, otherwise AVX is unusable
+		__cpuid(info, 1);
+		if (!(info[2] & (1 << 27)) || ((_xgetbv(0) & 6) != 6))
+			return false;
+
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#else
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2") != 0;
+#endif
+	}
+#endif
+
+	///////////////////////////////////////////////////////////////////////////////////////
+	////////// NEON (8 pixels per iteration)
+	///////////////////////////////////////////////////////////////////////////////////////
+
+#ifdef PIXELCONV_HAVE_NEON
+	static void ConvertNEON(const ConversionPlan& plan, const uint16_t* src, uint8_t* dst, int count)
+	{
+		int16x8_t shift[3], left[3], right[3];
+		uint16x8_t mask[3];
+
+		// NEON has no variable right shift, shifting left by a negative amount does the job
+		for (int c = 0; c < 3; c++)
+		{
+			shift[c] = vdupq_n_s16((int16_t)-plan.shift[c]);
+			mask[c] = vdupq_n_u16((uint16_t)((1 << plan.bits[c]) - 1));
+			left[c] = vdupq_n_s16((int16_t)(8 - plan.bits[c]));
+			right[c] = vdupq_n_s16((int16_t)-(2 * plan.bits[c] - 8));
+		}
+
+		int i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			uint16x8_t pixels = vld1q_u16(src + i);
+			uint8x8_t channels[4];
+
+			for (int c = 0; c < 3; c++)
+			{
+				uint16x8_t value = vandq_u16(vshlq_u16(pixels, shift[c]), mask[c]);
+				channels[c] = vmovn_u16(vorrq_u16(vshlq_u16(value, left[c]), vshlq_u16(value, right[c])));
+			}
+			channels[Alpha] = vdup_n_u8(0xff);
+
+			uint8x8x4_t interleaved;
+			interleaved.val[0] = channels[plan.order[0]];
+			interleaved.val[1] = channels[plan.order[1]];
+			interleaved.val[2] = channels[plan.order[2]];
+			interleaved.val[3] = channels[plan.order[3]];
+
+			vst4_u8(dst + i * 4, interleaved);
+		}
+
+		ConvertScalar(plan, src + i, dst + i * 4, count - i);
+	}
+#endif
+
+	///////////////////////////////////////////////////////////////////////////////////////
+	////////// Dispatch
+	///////////////////////////////////////////////////////////////////////////////////////
+
+	static bool IsAlwaysSupported() { return true; }
+
+	struct KernelInfo
+	{
+		const char* name;
+		PixelKernel kernel;
+		bool(*isSupported)();
+	};
+
+	// fastest first
+	static const KernelInfo kernels[] =
+	{
+#ifdef PIXELCONV_HAVE_AVX2
+		{ "avx2", ConvertAVX2, IsAVX2Supported },
+#endif
+#ifdef PIXELCONV_HAVE_SSE2
+		{ "sse2", ConvertSSE2, IsAlwaysSupported },
+#endif
+#ifdef PIXELCONV_HAVE_NEON
+		{ "neon", ConvertNEON, IsAlwaysSupported },
+#endif
+		{ "scalar", ConvertScalar, IsAlwaysSupported },
+	};
+
+	static const KernelInfo* FindBestKernel()
+	{
+		for (auto& info : kernels)
+		{
+			if (info.isSupported())
+				return &info;
+		}
+
+		return nullptr;
+	}
+
+	static const KernelInfo& GetBestKernel()
+	{
+		// the scalar kernel is always supported, so there is always a result
+		static const KernelInfo* best = FindBestKernel();
+		return *best;
+	}
+
+	static void SetChannel(ConversionPlan& plan, int channel, int shift, int bits)
+	{
+		plan.shift[channel] = shift;
+		plan.bits[channel] = bits;
+	}
+
+	PixelConverter::PixelConverter(SourceFormat format, TargetLayout layout)
+	{
+		SetChannel(plan, Alpha, 0, 0);
+
+		// see pixform.h; the 565 formats keep their spare bit below the 5-bit middle channel
+		switch (format)
+		{
+		case SourceFormat::RGB565: SetChannel(plan, Red, 11, 5); SetChannel(plan, Green, 6, 5); SetChannel(plan, Blue, 0, 5); break;
+		case SourceFormat::RGB555: SetChannel(plan, Red, 10, 5); SetChannel(plan, Green, 5, 5); SetChannel(plan, Blue, 0, 5); break;
+		case SourceFormat::BGR565: SetChannel(plan, Blue, 11, 5); SetChannel(plan, Green, 6, 5); SetChannel(plan, Red, 0, 5); break;
+		case SourceFormat::BGR555: SetChannel(plan, Blue, 10, 5); SetChannel(plan, Green, 5, 5); SetChannel(plan, Red, 0, 5); break;
+		case SourceFormat::GBR565: SetChannel(plan, Green, 11, 5); SetChannel(plan, Blue, 6, 5); SetChannel(plan, Red, 0, 5); break;
+		case SourceFormat::GBR555: SetChannel(plan, Green, 10, 5); SetChannel(plan, Blue, 5, 5); SetChannel(plan, Red, 0, 5); break;
+		case SourceFormat::RGB5551: SetChannel(plan, Red, 11, 5); SetChannel(plan, Green, 6, 5); SetChannel(plan, Blue, 1, 5); break;
+		}
+
+		switch (layout)
+		{
+		case TargetLayout::RGBA: plan.order[0] = Red; plan.order[1] = Green; plan.order[2] = Blue; plan.order[3] = Alpha; break;
+		case TargetLayout::BGRA: plan.order[0] = Blue; plan.order[1] = Green; plan.order[2] = Red; plan.order[3] = Alpha; break;
+		case TargetLayout::ARGB: plan.order[0] = Alpha; plan.order[1] = Red; plan.order[2] = Green; plan.order[3] = Blue; break;
+		}
+
+		kernel = GetBestKernel().kernel;
+		kernelName = GetBestKernel().name;
+	}
+
+	void PixelConverter::ConvertRow(const uint16_t* src, uint8_t* dst, int count) const
+	{
+		kernel(plan, src, dst, count);
+	}
+
+	void PixelConverter::Convert(const void* src, int srcPitch, void* dst, int dstPitch, int width, int height) const
+	{
+		for (int y = 0; y < height; y++)
+		{
+			kernel(
+				plan,
+				(const uint16_t*)((const uint8_t*)src + y * srcPitch),
+				(uint8_t*)dst + y * dstPitch,
+				width);
+		}
+	}
+
+	bool PixelConverter::SelectKernel(const std::string& name)
+	{
+		for (auto& info : kernels)
+		{
+			if ((name == info.name) && info.isSupported())
+			{
+				kernel = info.kernel;
+				kernelName = info.name;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	std::vector<std::string> PixelConverter::GetAvailableKernels()
+	{
+		std::vector<std::string> result;
+
+		for (auto& info : kernels)
+		{
+			if (info.isSupported())
+				result.push_back(info.name);
+		}
+
+		return result;
+	}
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SNESOnline
+{
+	// 16-bit formats the emulator can render in; same order as the pixform.h enum
+	// used by S9xSetRenderPixelFormat(), so values can be cast directly.
+	enum class SourceFormat
+	{
+		RGB565,
+		RGB555,
+		BGR565,
+		BGR555,
+		GBR565,
+		GBR555,
+		RGB5551,
+	};
+
+	// byte order of the 32-bit target pixels in memory
+	enum class TargetLayout
+	{
+		RGBA,
+		BGRA,
+		ARGB,
+	};
+
+	// Where the channels of a source pixel are and in which order they go to memory.
+	// Only meant to be consumed by the conversion kernels.
+	struct ConversionPlan
+	{
+		int shift[4];		// R, G, B, A position inside the 16-bit source pixel
+		int bits[4];		// R, G, B, A width in bits; alpha has none and is always opaque
+		int order[4];		// channel index (0 = R .. 3 = A) for each target byte
+	};
+
+	typedef void(*PixelKernel)(const ConversionPlan& plan, const uint16_t* src, uint8_t* dst, int count);
+
+	// Converts emulator frames into 32-bit pixels, expanding 5/6-bit channels to 8 bits by bit
+	// replication (so full intensity maps to 255). The fastest kernel the CPU supports is picked
+	// at runtime (AVX2, SSE2, NEON or scalar); others can be selected explicitly for benchmarking.
+	class PixelConverter
+	{
+	private:
+		ConversionPlan plan;
+		PixelKernel kernel;
+		const char* kernelName;
+
+	public:
+		PixelConverter(SourceFormat format, TargetLayout layout);
+
+		void ConvertRow(const uint16_t* src, uint8_t* dst, int count) const;
+		// pitches are in bytes
+		void Convert(const void* src, int srcPitch, void* dst, int dstPitch, int width, int height) const;
+
+		const char* GetKernelName() const { return kernelName; }
+		// returns false if the kernel is unknown or not supported by this CPU
+		bool SelectKernel(const std::string& name);
+
+		// all kernels usable on this CPU, fastest first
+		static std::vector<std::string> GetAvailableKernels();
+	};
+}
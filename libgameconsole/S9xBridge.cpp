@@ -1,23 +1,28 @@
 #include "S9xBridge.hpp"
 
 #include <iostream>
+#include <chrono>
+#include <algorithm>
 
-namespace SNES {
-	extern uint64_t globalSnesTimer;
-}
 namespace SNESOnline
 {
 
 	int S9xBridge::MouseX = 0;
 	int S9xBridge::MouseY = 0;
-	std::vector<unsigned char> S9xBridge::pixels;
-	int S9xBridge::screenWidth = 0;
-	int S9xBridge::screenHeight = 0;
 
 #ifndef __EMSCRIPTEN__
-	std::mutex S9xBridge::mutex;
+	std::atomic_int S9xBridge::audioRequestSize(0);
+
+	// the console keeps at least this many samples (~45ms of stereo audio) ahead of the audio device
+	static const int MinBufferedSamples = 4096;
 #endif
 
+	S9xContext& S9xBridge::GetConsole()
+	{
+		static S9xContext console;
+		return console;
+	}
+
 	void S9xBridge::Log(LogLevel level, std::string message)
 	{
 		switch (level)
@@ -38,42 +43,65 @@ namespace SNESOnline
 
 	void S9xBridge::OnFillAudioBuffer(uint64_t audioTime, int16_t* pcmData, int pcmDataSizeInBytes)
 	{
+		const int requested = pcmDataSizeInBytes / 2;
+		S9xContext& console = GetConsole();
+
+		if (!console.IsStarted())
+			return;
+
 #ifndef __EMSCRIPTEN__
-		std::lock_guard<std::mutex> lock(mutex);
+		audioRequestSize = requested;
+#else
+		// no threads available, so emulation is still driven by the audio callback
+		while (console.GetBufferedSampleCount() < requested)
+			console.RunFrames(1);
 #endif
 
-		//while(SNES::globalSnesTimer < 5300) {
-		//	::SNES::OnFillAudioBuffer(audioTime, pcmData);
-		//}
-
-		::SNES::OnFillAudioBuffer(audioTime, pcmData, pcmDataSizeInBytes);
+		// no lock here, the console thread is expected to stay ahead
+		const int available = (int)console.ReadAudio(pcmData, requested);
+		std::fill(pcmData + available, pcmData + requested, 0);
 	}
 
 	void S9xBridge::Shutdown()
 	{
-#ifndef __EMSCRIPTEN__
-		std::lock_guard<std::mutex> lock(mutex);
-#endif
-		::SNES::ShutdownSnes9X();
+		GetConsole().Shutdown();
 	}
 
 	bool S9xBridge::Startup(std::string romFile, std::string sramFile)
 	{
+		S9xContext& console = GetConsole();
+
+		if (!console.Startup(romFile, sramFile))
+			return false;
+
 #ifndef __EMSCRIPTEN__
-		std::lock_guard<std::mutex> lock(mutex);
+		// pace emulation by the audio device: stay a bit more than two callbacks ahead
+		console.Resume([&console]
+		{
+			return console.GetBufferedSampleCount() < std::max(MinBufferedSamples, 2 * audioRequestSize.load());
+		});
 #endif
-		return ::SNES::StartupSnes9X(romFile, sramFile);
+
+		return true;
 	}
 
-	void S9xBridge::SetGamepadState(int gamePadId, std::vector<SNES::S9xGamepadButtons> pressedButtons)
+	uint64_t S9xBridge::GetAudioUnderrunCount()
 	{
-#ifndef __EMSCRIPTEN__
-		std::lock_guard<std::mutex> lock(mutex);
-#endif
-		std::vector<::SNES::S9xGamepadButtons> btns;
-		for (auto e : pressedButtons)
-			btns.push_back((::SNES::S9xGamepadButtons)e);
+		return GetConsole().GetAudioUnderrunCount();
+	}
 
-		::SNES::S9xSetGamepadState(gamePadId, btns);
+	uint64_t S9xBridge::GetAudioOverrunCount()
+	{
+		return GetConsole().GetAudioOverrunCount();
+	}
+
+	ProfileSummary S9xBridge::GetProfileSummary()
+	{
+		return GetConsole().GetProfileSummary();
+	}
+
+	void S9xBridge::SetGamepadState(int gamePadId, std::vector<SNES::S9xGamepadButtons> pressedButtons)
+	{
+		GetConsole().SetGamepadState(gamePadId, pressedButtons);
 	}
 }
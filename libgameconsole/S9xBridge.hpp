@@ -6,24 +6,12 @@
 #include <memory>
 #include <string>
 #include <array>
+#include <atomic>
+#include <thread>
 
 #include <string.h>
 
-namespace SNES {
-			void ShutdownSnes9X();
-			void OnFillAudioBuffer(uint64_t audioTime, int16_t* pcmData, int pcmDataSizeInBytes);
-			bool StartupSnes9X(std::string romFile, std::string sramFile);
-
-		enum class S9xGamepadButtons
-		{
-			X, B, A, R, L, Y, Start, Select,
-			Left, Up, Down, Right,
-		};
-
-		void S9xSetGamepadState(int gamePadId, std::vector<S9xGamepadButtons> pressedButtons);
-
-
-}
+#include "S9xContext.hpp"
 
 namespace SNESOnline
 {
@@ -42,13 +30,17 @@ namespace SNESOnline
 	public:
 		static int MouseX;
 		static int MouseY;
-		static std::vector<unsigned char> pixels;
-		static int screenWidth;
-		static int screenHeight;
+
+		// the console shown by the player, created on first use
+		static S9xContext& GetConsole();
+
+	private:
 #ifndef __EMSCRIPTEN__
-		static std::mutex mutex;
+		// amount of samples requested by the last audio callback, used to pace the console
+		static std::atomic_int audioRequestSize;
 #endif
 
+	public:
 		static void Log(LogLevel level, std::string message);
 
 		static void DoExit() {}
@@ -57,5 +49,13 @@ namespace SNESOnline
 		static void Shutdown();
 		static bool Startup(std::string romFile, std::string sramFile);
 		static void SetGamepadState(int gamePadId, std::vector<SNES::S9xGamepadButtons> pressedButtons);
+
+		// frame cost percentiles of the console, e.g. for exporting them as metrics
+		static ProfileSummary GetProfileSummary();
+
+		// times the audio callback found less samples than it needed
+		static uint64_t GetAudioUnderrunCount();
+		// times the emulation produced more samples than the audio ring could hold
+		static uint64_t GetAudioOverrunCount();
 	};
 }
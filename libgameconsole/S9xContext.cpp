@@ -0,0 +1,379 @@
+#include "S9xContext.hpp"
+
+#include "snes9x.h"
+#include "snapshot.h"
+#include "rewind.h"
+#include "dirty.h"
+#include "renderpool.h"
+#include "fxemu.h"
+#include "profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace SNESOnline
+{
+	static thread_local S9xContext* currentContext = nullptr;
+
+	S9xContext* S9xContext::GetCurrent()
+	{
+		return currentContext;
+	}
+
+	S9xContext::S9xContext() : started(false)
+	{
+		for (auto& mask : buttonMasks)
+			mask = 0;
+
+#ifndef __EMSCRIPTEN__
+		thread = std::thread(&S9xContext::ThreadProc, this);
+#else
+		currentContext = this;
+#endif
+	}
+
+	S9xContext::~S9xContext()
+	{
+		Shutdown();
+
+#ifndef __EMSCRIPTEN__
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			quit = true;
+		}
+
+		wakeup.notify_one();
+		thread.join();
+#else
+		currentContext = nullptr;
+#endif
+	}
+
+#ifndef __EMSCRIPTEN__
+	void S9xContext::Post(std::function<void()> task)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			tasks.push_back(std::move(task));
+		}
+
+		wakeup.notify_one();
+	}
+
+	void S9xContext::ThreadProc()
+	{
+		currentContext = this;
+
+		while (true)
+		{
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				wakeup.wait(lock, [this] { return quit || running || !tasks.empty(); });
+
+				if (!tasks.empty())
+				{
+					task = std::move(tasks.front());
+					tasks.pop_front();
+				}
+				else if (quit)
+					break;
+			}
+
+			if (task)
+				task();
+			else if (frameGate && !frameGate())
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			else
+				::SNES::RunFrame();
+		}
+	}
+
+	void S9xContext::Resume(std::function<bool()> frameGate)
+	{
+		Post([this, frameGate]
+		{
+			this->frameGate = frameGate;
+			running = started;
+		});
+	}
+
+	void S9xContext::Pause()
+	{
+		Invoke([this] { running = false; });
+	}
+#endif
+
+	bool S9xContext::Startup(std::string romFile, std::string sramFile)
+	{
+		return Invoke([&]
+		{
+#ifndef __EMSCRIPTEN__
+			running = false;
+#endif
+			if (started)
+				::SNES::ShutdownSnes9X();
+
+			started = ::SNES::StartupSnes9X(romFile, sramFile);
+			if (started)
+			{
+				S9xRewindInit(rewindMegabytes, rewindInterval);
+				S9xRenderPoolInit(renderThreads);
+				S9xSuperFXThreadInit(superFXThread);
+			}
+
+			return (bool)started;
+		});
+	}
+
+	void S9xContext::Shutdown()
+	{
+		Invoke([this]
+		{
+#ifndef __EMSCRIPTEN__
+			running = false;
+#endif
+			if (started)
+				::SNES::ShutdownSnes9X();
+
+			started = false;
+		});
+	}
+
+	void S9xContext::RunFrames(int count)
+	{
+		Invoke([this, count]
+		{
+			for (int i = 0; (i < count) && started; i++)
+				::SNES::RunFrame();
+		});
+	}
+
+	bool S9xContext::SaveState(std::vector<uint8_t>& state)
+	{
+		return Invoke([&]
+		{
+			if (!started)
+				return false;
+
+			uint32 size = S9xFreezeSize();
+			if (state.size() < size)
+				state.resize(size);
+
+			return S9xFreezeToMemory(state.data(), (uint32)state.size()) == TRUE;
+		});
+	}
+
+	bool S9xContext::LoadState(const std::vector<uint8_t>& state)
+	{
+		return Invoke([&]
+		{
+			if (!started || (S9xUnfreezeFromMemory(state.data(), (uint32)state.size()) != SUCCESS))
+				return false;
+
+			S9xRewindReset();
+			return true;
+		});
+	}
+
+	bool S9xContext::ExportState(std::string fileName)
+	{
+		return Invoke([&]
+		{
+			return started && S9xFreezeGame(fileName.c_str());
+		});
+	}
+
+	bool S9xContext::ImportState(std::string fileName)
+	{
+		return Invoke([&]
+		{
+			if (!started || !S9xUnfreezeGame(fileName.c_str()))
+				return false;
+
+			S9xRewindReset();
+			return true;
+		});
+	}
+
+	void S9xContext::EnableRewind(int megabytes, int interval)
+	{
+		Invoke([=]
+		{
+			rewindMegabytes = std::max(megabytes, 0);
+			rewindInterval = interval;
+
+			if (started)
+				S9xRewindInit(rewindMegabytes, rewindInterval);
+		});
+	}
+
+	bool S9xContext::RewindStep()
+	{
+		return Invoke([this] { return started && S9xRewindStep(); });
+	}
+
+	RewindStats S9xContext::GetRewindStats()
+	{
+		SRewindStats core;
+		RewindStats stats;
+
+		Invoke([&] { S9xRewindGetStats(&core); });
+
+		stats.capacity = core.Capacity;
+		stats.used = core.Used;
+		stats.stateSize = core.StateSize;
+		stats.snapshots = core.Snapshots;
+		stats.frames = core.Frames;
+		stats.lastDeltaSize = core.LastDeltaSize;
+		stats.captures = core.Captures;
+		stats.evictions = core.Evictions;
+		return stats;
+	}
+
+	void S9xContext::SetRenderThreads(int threads)
+	{
+		Invoke([=]
+		{
+			renderThreads = std::max(threads, 0);
+
+			if (started)
+				S9xRenderPoolInit(renderThreads);
+		});
+	}
+
+	uint64_t S9xContext::GetRenderThreadLines()
+	{
+		return Invoke([] { return (uint64_t)S9xRenderPoolLines(); });
+	}
+
+	void S9xContext::SetSuperFXThread(SuperFXThreadMode mode)
+	{
+		Invoke([=]
+		{
+			superFXThread = (int)mode;
+
+			if (started)
+				S9xSuperFXThreadInit(superFXThread);
+		});
+	}
+
+	SuperFXThreadStats S9xContext::GetSuperFXThreadStats()
+	{
+		SuperFXThreadStats stats;
+
+		Invoke([&]
+		{
+			stats.lines = S9xSuperFXThreadLines();
+			stats.mismatches = S9xSuperFXThreadMismatches();
+		});
+
+		return stats;
+	}
+
+	int S9xContext::GetDirtyPages(int region, std::vector<uint64_t>& bitmap, bool clear)
+	{
+		bitmap.resize(S9X_DIRTY_WORDS);
+
+		return Invoke([&]
+		{
+			uint32 count = S9xGetDirtyPages(region, (uint64*)bitmap.data());
+			if (clear)
+				S9xClearDirtyPages(region);
+
+			return (int)count;
+		});
+	}
+
+	// nearest rank percentile of already sorted values
+	static double Percentile(const std::vector<double>& sorted, double percent)
+	{
+		if (sorted.empty())
+			return 0;
+
+		size_t rank = (size_t)std::ceil(percent / 100 * sorted.size());
+		return sorted[std::max<size_t>(rank, 1) - 1];
+	}
+
+	static ProfileSection SummarizeSection(std::string name, std::vector<double> milliseconds, uint64_t calls)
+	{
+		ProfileSection section;
+
+		std::sort(milliseconds.begin(), milliseconds.end());
+		section.name = name;
+		section.p50 = Percentile(milliseconds, 50);
+		section.p95 = Percentile(milliseconds, 95);
+		section.p99 = Percentile(milliseconds, 99);
+		section.max = milliseconds.empty() ? 0 : milliseconds.back();
+		section.callsPerFrame = milliseconds.empty() ? 0 : (double)calls / milliseconds.size();
+		return section;
+	}
+
+	ProfileSummary S9xContext::GetProfileSummary()
+	{
+		std::vector<SProfileFrame> history(S9X_PROFILE_HISTORY);
+		history.resize(Invoke([&] { return S9xGetProfileHistory(history.data(), (int)history.size()); }));
+
+		ProfileSummary summary;
+		std::vector<double> milliseconds;
+		uint64_t opcodes = 0;
+
+		summary.frames = (int)history.size();
+		if (history.empty())
+			return summary;
+
+		for (auto& frame : history)
+		{
+			milliseconds.push_back(frame.Nanoseconds / 1e6);
+			opcodes += frame.Opcodes;
+		}
+
+		summary.frame = SummarizeSection("frame", milliseconds, history.size());
+		summary.opcodesPerFrame = history.empty() ? 0 : (double)opcodes / history.size();
+
+		for (int i = S9X_PROFILE_NONE + 1; i < S9X_PROFILE_SECTION_COUNT; i++)
+		{
+			uint64_t calls = 0;
+			milliseconds.clear();
+
+			for (auto& frame : history)
+			{
+				milliseconds.push_back(frame.SectionNanoseconds[i] / 1e6);
+				calls += frame.SectionCalls[i];
+			}
+
+			summary.sections.push_back(SummarizeSection(S9xGetProfileSectionName(i), milliseconds, calls));
+		}
+
+		return summary;
+	}
+
+	void S9xContext::SetGamepadState(int gamePadId, const std::vector<SNES::S9xGamepadButtons>& pressedButtons)
+	{
+		using SNES::S9xGamepadButtons;
+
+		uint16_t buttonMask = 0;
+
+		for (auto e : pressedButtons)
+		{
+			switch (e)
+			{
+			case S9xGamepadButtons::A: buttonMask |= SNES_A_MASK; break;
+			case S9xGamepadButtons::B: buttonMask |= SNES_B_MASK; break;
+			case S9xGamepadButtons::X: buttonMask |= SNES_X_MASK; break;
+			case S9xGamepadButtons::Y: buttonMask |= SNES_Y_MASK; break;
+			case S9xGamepadButtons::L: buttonMask |= SNES_TL_MASK; break;
+			case S9xGamepadButtons::R: buttonMask |= SNES_TR_MASK; break;
+			case S9xGamepadButtons::Start: buttonMask |= SNES_START_MASK; break;
+			case S9xGamepadButtons::Select: buttonMask |= SNES_SELECT_MASK; break;
+			case S9xGamepadButtons::Left: buttonMask |= SNES_LEFT_MASK; break;
+			case S9xGamepadButtons::Right: buttonMask |= SNES_RIGHT_MASK; break;
+			case S9xGamepadButtons::Up: buttonMask |= SNES_UP_MASK; break;
+			case S9xGamepadButtons::Down: buttonMask |= SNES_DOWN_MASK; break;
+			}
+		}
+
+		buttonMasks.at(gamePadId) = buttonMask;
+	}
+}
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "FrameExchange.hpp"
+#include "SpscRing.hpp"
+
+namespace SNES {
+		enum class S9xGamepadButtons
+		{
+			X, B, A, R, L, Y, Start, Select,
+			Left, Up, Down, Right,
+		};
+
+		// These operate on the console of the calling thread; go through S9xContext instead.
+		bool StartupSnes9X(std::string romFile, std::string sramFile);
+		void ShutdownSnes9X();
+		void RunFrame();
+}
+
+namespace SNESOnline
+{
+	// cost of one profiler section over the recent frames, times in milliseconds
+	struct ProfileSection
+	{
+		std::string name;
+		double p50 = 0;
+		double p95 = 0;
+		double p99 = 0;
+		double max = 0;
+		double callsPerFrame = 0;
+	};
+
+	struct ProfileSummary
+	{
+		int frames = 0;					// amount of recent frames the summary covers
+		double opcodesPerFrame = 0;
+		ProfileSection frame;			// the whole frame
+		std::vector<ProfileSection> sections;
+	};
+
+	struct RewindStats
+	{
+		size_t capacity = 0;			// bytes kept for the history
+		size_t used = 0;
+		size_t stateSize = 0;			// bytes of one uncompressed snapshot
+		int snapshots = 0;				// steps RewindStep() can go back
+		int frames = 0;					// frames those steps cover
+		size_t lastDeltaSize = 0;
+		uint64_t captures = 0;
+		uint64_t evictions = 0;			// snapshots dropped to make room
+	};
+
+	// same values as S9X_SUPERFX_THREAD_* in fxemu.h
+	enum class SuperFXThreadMode
+	{
+		Off,
+		On,
+		Verify,		// also replays every chunk on the console thread and counts the ones that differ
+	};
+
+	struct SuperFXThreadStats
+	{
+		uint64_t lines = 0;				// chunks of GSU instructions run by the thread
+		uint64_t mismatches = 0;		// Verify only
+	};
+
+	// One emulated console. The snes9x core keeps its state thread-local (see S9X_TLS in port.h),
+	// so every context owns a thread that hosts its console and all calls into the core are
+	// executed there. Any number of contexts can run side by side in one process.
+	//
+	// Frames and audio are handed out lock-free to one consumer thread each. Without threads
+	// (emscripten) there can only be one context and everything runs on the calling thread.
+	class S9xContext
+	{
+	private:
+		FrameExchange frames;
+		// ~370ms of stereo audio; the context thread pushes, the consumer pulls
+		SpscRing<int16_t, 32768> audio;
+		std::array<std::atomic<uint16_t>, 2> buttonMasks;
+		std::atomic_bool started;
+		// settings applied to every ROM loaded, only touched by the context thread
+		int rewindMegabytes = 0;
+		int rewindInterval = 0;
+		int renderThreads = 0;
+		int superFXThread = 0;
+
+#ifndef __EMSCRIPTEN__
+		std::thread thread;
+		std::mutex mutex;
+		std::condition_variable wakeup;
+		std::deque<std::function<void()>> tasks;
+		bool quit = false;
+
+		// only touched by the context thread
+		bool running = false;
+		std::function<bool()> frameGate;
+
+		void ThreadProc();
+		void Post(std::function<void()> task);
+#endif
+
+	public:
+		S9xContext();
+		// shuts the console down and joins the context thread
+		~S9xContext();
+
+		S9xContext(const S9xContext&) = delete;
+		S9xContext& operator=(const S9xContext&) = delete;
+
+		// Runs the action on the context thread and returns its result (or rethrows its exception).
+		// Blocks until done; called from the context thread itself, the action runs inline.
+		template<class Action>
+		auto Invoke(Action action) -> decltype(action())
+		{
+#ifndef __EMSCRIPTEN__
+			if (std::this_thread::get_id() == thread.get_id())
+				return action();
+
+			auto task = std::make_shared<std::packaged_task<decltype(action())()>>(std::move(action));
+			auto result = task->get_future();
+
+			Post([task] { (*task)(); });
+			return result.get();
+#else
+			return action();
+#endif
+		}
+
+		// loads a ROM, replacing whatever ran before; leaves the console paused
+		bool Startup(std::string romFile, std::string sramFile);
+		void Shutdown();
+		bool IsStarted() const { return started; }
+
+		// runs the given amount of frames and returns once they are done
+		void RunFrames(int count);
+
+#ifndef __EMSCRIPTEN__
+		// Lets the context thread run frames on its own until Pause(), Startup() or Shutdown().
+		// Before each frame the gate is asked (on the context thread) whether another frame is
+		// wanted right now; if not, the thread idles for a millisecond and asks again.
+		void Resume(std::function<bool()> frameGate);
+		void Pause();
+#endif
+
+		// Snapshots the console between two frames. The vector only grows if the state doesn't fit,
+		// so reusing it keeps saving free of allocations. Returns false if no ROM is loaded.
+		bool SaveState(std::vector<uint8_t>& state);
+		// restores a state saved by SaveState() while the same ROM was loaded
+		bool LoadState(const std::vector<uint8_t>& state);
+
+		// the regular snes9x snapshot files, compatible with other snes9x builds but much slower
+		bool ExportState(std::string fileName);
+		bool ImportState(std::string fileName);
+
+		// Keeps a snapshot every interval frames in a history of the given size, 0 turns it off.
+		// Applies to the running console and to any ROM loaded later.
+		void EnableRewind(int megabytes, int interval = 4);
+		// goes back to the newest snapshot (or the one before if it was just taken); false if the history is empty
+		bool RewindStep();
+		RewindStats GetRewindStats();
+
+		// Pages of a core memory region written since it was last cleared, one bit per page (see dirty.h
+		// for the regions and page size). Returns the amount of dirty pages; clear starts over afterwards.
+		int GetDirtyPages(int region, std::vector<uint64_t>& bitmap, bool clear);
+
+		// Draws the screen on the given amount of extra threads while the console thread keeps
+		// emulating (see renderpool.h), 0 draws everything on the console thread. Applies to the
+		// running console and to any ROM loaded later.
+		void SetRenderThreads(int threads);
+		// lines drawn by the render threads since they were started
+		uint64_t GetRenderThreadLines();
+
+		// Runs the Super FX of games that have one on an extra thread while the console thread keeps
+		// emulating the CPU (see fxemu.h); the result is the same as without. Applies to the running
+		// console and to any ROM loaded later.
+		void SetSuperFXThread(SuperFXThreadMode mode);
+		// since the thread was started
+		SuperFXThreadStats GetSuperFXThreadStats();
+
+		// may be called from any thread, takes effect with the next frame
+		void SetGamepadState(int gamePadId, const std::vector<SNES::S9xGamepadButtons>& pressedButtons);
+		uint16_t GetButtonMask(int gamePadId) const { return buttonMasks[gamePadId].load(std::memory_order_relaxed); }
+
+		// Percentiles over the frames kept by the core profiler (see profiler.h); empty if it was
+		// compiled out. Runs on the context thread, so it may have to wait for the current frame.
+		ProfileSummary GetProfileSummary();
+
+		// the console renders into the back buffer, the consumer acquires the latest frame
+		FrameExchange& GetFrames() { return frames; }
+
+		// consumer side; returns the amount of samples actually read
+		size_t ReadAudio(int16_t* samples, size_t count) { return audio.Pull(samples, count); }
+		// context thread side
+		void WriteAudio(const int16_t* samples, size_t count) { audio.Push(samples, count); }
+		int GetBufferedSampleCount() const { return (int)audio.Size(); }
+		// times the consumer found less samples than it needed
+		uint64_t GetAudioUnderrunCount() const { return audio.GetUnderrunCount(); }
+		// times the console produced more samples than the audio ring could hold
+		uint64_t GetAudioOverrunCount() const { return audio.GetOverrunCount(); }
+
+		// the context hosted by the calling thread, nullptr if there is none
+		static S9xContext* GetCurrent();
+	};
+}
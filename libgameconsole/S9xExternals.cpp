@@ -9,6 +9,9 @@
 #include "cheats.h"
 #include "display.h"
 #include "conffile.h"
+#include "rewind.h"
+#include "renderpool.h"
+#include "fxemu.h"
 
 #include <sstream>
 #include <algorithm>
@@ -68,8 +71,9 @@ static void assert_always(bool condition) {
 		uint32_t Width, Height;
 	};
 
-	SSurface Src = {};
-	bool8 do_frame_adjust = false;
+	// per console, like the core state
+	thread_local SSurface Src = {};
+	S9X_TLS bool8 do_frame_adjust = false;
 
 	void SetInfoDlgColor(unsigned char r, unsigned char g, unsigned char b)
 	{
@@ -257,8 +261,8 @@ void S9xParsePortConfig(ConfigFile &, int pass) {
 		// otherwise the image processors (filters) might access
 		// some of the old rendered data at the edges.
 		{
-			static int LastWidth = 0;
-			static int LastHeight = 0;
+			static thread_local int LastWidth = 0;
+			static thread_local int LastHeight = 0;
 
 			if (Width < LastWidth)
 			{
@@ -351,7 +355,7 @@ void S9xParsePortConfig(ConfigFile &, int pass) {
 
 	const char *S9xGetFilenameInc(const char *e, enum s9x_getdirtype dirtype)
 	{
-		static char resBuffer[PATH_MAX + 1];
+		static S9X_TLS char resBuffer[PATH_MAX + 1];
 		char dir[_MAX_DIR + 1];
 		char drive[_MAX_DRIVE + 1];
 		char fname[_MAX_FNAME + 1];
@@ -379,7 +383,7 @@ void S9xParsePortConfig(ConfigFile &, int pass) {
 		default:
 			break;
 		case ROMFILENAME_DIR:
-			static char filename[PATH_MAX];
+			static S9X_TLS char filename[PATH_MAX];
 			strcpy(filename, Memory.ROMFilename);
 			if (!filename[0])
 				rv = "./";
@@ -398,14 +402,14 @@ void S9xParsePortConfig(ConfigFile &, int pass) {
 
 	const char *S9xGetDirectory(enum s9x_getdirtype dirtype)
 	{
-		static char path[PATH_MAX] = { 0 };
+		static S9X_TLS char path[PATH_MAX] = { 0 };
 		strncpy(path, S9xGetDirectoryT(dirtype), PATH_MAX - 1);
 		return path;
 	}
 
 	const char *S9xGetFilename(const char *ex, enum s9x_getdirtype dirtype)
 	{
-		static char resBuffer[PATH_MAX + 1];
+		static S9X_TLS char resBuffer[PATH_MAX + 1];
 
 		char dir[_MAX_DIR + 1];
 		char drive[_MAX_DRIVE + 1];
@@ -500,6 +504,9 @@ namespace SNES {
 	{
 		Settings.StopEmulation = true;
 
+		S9xRenderPoolDeinit();
+		S9xSuperFXThreadDeinit();
+		S9xRewindDeinit();
 		Memory.Deinit();
 		S9xGraphicsDeinit();
 		S9xDeinitAPU();
@@ -542,49 +549,28 @@ namespace SNES {
 		return true;
 	}
 
-	static std::vector<int16_t> soundStream;
-
 namespace SNES {
-	uint64_t globalSnesTimer = 0;
+	thread_local uint64_t globalSnesTimer = 0;
 
-	void OnFillAudioBuffer(::uint64_t audioTime, int16_t* pcmData, int pcmDataSizeInBytes)
+	void RunFrame()
 	{
-		static bool wasEmpty = true, waspressed = false;
-
-		if (Settings.StopEmulation)
-			return;
-
-		while (soundStream.size() < (pcmDataSizeInBytes / 2))
-		{
-			globalSnesTimer++;
-			S9xMainLoop();
-		}
-
-		// take samples form our audio buffer
-		std::copy_n(soundStream.begin(), pcmDataSizeInBytes / 2, pcmData);
-		soundStream.erase(soundStream.begin(), soundStream.begin() + (pcmDataSizeInBytes / 2));
+		globalSnesTimer++;
+		S9xMainLoop();
 	}
 }
 	void S9xSoundCallback(void *data)
 	{
-		static std::vector<int16_t> soundBuffer;
+		static thread_local std::vector<int16_t> soundBuffer;
 
 		S9xFinalizeSamples();
 		int availSamples = S9xGetSampleCount();
 		soundBuffer.resize(availSamples);
 
+		// samples that don't fit anymore are dropped and counted as overrun by the ring
 		if (S9xMixSamples((unsigned char*)soundBuffer.data(), soundBuffer.size()))
-		{
-			for (int i = 0; i < soundBuffer.size(); i++)
-				soundStream.push_back(soundBuffer[i]);
-
-			if (soundStream.size() > 44100 * 2 * 10)
-				soundStream.clear(); // something is wrong with our audio thread, so we just forget those samples to not allocate endless memory...
-		}
+			S9xContext::GetCurrent()->WriteAudio(soundBuffer.data(), soundBuffer.size());
 	}
 
-	static std::array<std::vector<S9xGamepadButtons>, 2> pressedButtons;
-
 	void S9xControlsReset(void)
 	{
 	}
@@ -604,42 +590,13 @@ namespace SNES {
 		return 0;
 	}
 
-namespace SNES {
-	void S9xSetGamepadState(int gamePadId, std::vector<S9xGamepadButtons> pressedButtons_)
-	{
-		assert_always((gamePadId >= 0) && (gamePadId <= 1));
-		pressedButtons.at(gamePadId) = pressedButtons_;
-	}
-}
-
 	void S9xDoAutoJoypad(void)
 	{
-		uint16_t buttonMask;
+		S9xContext* context = S9xContext::GetCurrent();
 
 		for (int i = 0; i < 2; i++)
 		{
-			buttonMask = 0;
-
-			for (auto e : pressedButtons[i])
-			{
-				int16_t native = 0;
-				switch (e)
-				{
-				case S9xGamepadButtons::A: native = SNES_A_MASK; break;
-				case S9xGamepadButtons::B: native = SNES_B_MASK; break;
-				case S9xGamepadButtons::X: native = SNES_X_MASK; break;
-				case S9xGamepadButtons::Y: native = SNES_Y_MASK; break;
-				case S9xGamepadButtons::L: native = SNES_TL_MASK; break;
-				case S9xGamepadButtons::R: native = SNES_TR_MASK; break;
-				case S9xGamepadButtons::Start: native = SNES_START_MASK; break;
-				case S9xGamepadButtons::Select: native = SNES_SELECT_MASK; break;
-				case S9xGamepadButtons::Left: native = SNES_LEFT_MASK; break;
-				case S9xGamepadButtons::Right: native = SNES_RIGHT_MASK; break;
-				case S9xGamepadButtons::Up: native = SNES_UP_MASK; break;
-				case S9xGamepadButtons::Down: native = SNES_DOWN_MASK; break;
-				}
-				buttonMask |= native;
-			}
+			uint16_t buttonMask = context->GetButtonMask(i);
 
 			WRITE_WORD(Memory.FillRAM + 0x4218 + i * 2, buttonMask);
 			WRITE_WORD(Memory.FillRAM + 0x421c + i * 2, 0);
@@ -653,34 +610,19 @@ namespace SNES {
 	}
 
 
+	// hands the finished frame to the presenter and continues rendering into a free buffer
 	static void DoRender()
 	{
-		uint16 *lpSrc = reinterpret_cast<uint16 *>(Src.Surface);
-		const unsigned int srcPitch = Src.Pitch >> 1;
-		S9xBridge::screenWidth = Src.Width;
-		S9xBridge::screenHeight = Src.Height;
-
-		S9xBridge::pixels.resize(Src.Width * Src.Height * 4);
-		unsigned char* dstPixels = S9xBridge::pixels.data();
-
-		for (int y = 0, iDst = 0, iSrc = 0; y < Src.Height; y++, lpSrc += srcPitch)
-		{
-			for (int x = 0; x < Src.Width; x++)
-			{
-				uint16 rgb16 = *(lpSrc + x);
-
-				dstPixels[iDst++] = ((((rgb16) >> 11)) << /*RedShift+3*/ 3);
-				dstPixels[iDst++] = ((((rgb16) >> 6) & 0x1f) << /*GreenShift+3*/ 3);
-				dstPixels[iDst++] = (((rgb16)& 0x1f) << /*BlueShift+3*/ 3);
-				dstPixels[iDst++] = 255;
-			}
-		}
+#ifdef GFX_MULTI_FORMAT
+		ScreenFrame& next = S9xContext::GetCurrent()->GetFrames().Publish(Src.Width, Src.Height, GFX.PixelFormat);
+#else
+		ScreenFrame& next = S9xContext::GetCurrent()->GetFrames().Publish(Src.Width, Src.Height, PIXEL_FORMAT);
+#endif
+		GFX.Screen = next.pixels;
 	}
 namespace SNES {
 	bool StartupSnes9X(std::string romFile, std::string sramFile)
 	{
-		static std::vector<unsigned char> screenBuf;
-
 		memset(&Settings, 0, sizeof(Settings));
 
 		Settings.MouseMaster = true;
@@ -697,6 +639,8 @@ namespace SNES {
 		Settings.AutoDisplayMessages = true;
 		Settings.InitialInfoStringTimeout = 120;
 		Settings.HDMATimingHack = 100;
+		Settings.SkipIdleLoops = true;
+		Settings.SA1CatchUp = true;
 		Settings.BlockInvalidVRAMAccessMaster = true;
 
 		Settings.StopEmulation = true;
@@ -704,11 +648,12 @@ namespace SNES {
 		Memory.Init();
 		Memory.PostRomInitFunc = S9xPostRomInit;
 
-		screenBuf.resize(EXT_PITCH * EXT_HEIGHT);
+		FrameExchange& frames = S9xContext::GetCurrent()->GetFrames();
+		frames.Init(EXT_PITCH * EXT_HEIGHT, EXT_OFFSET, EXT_PITCH);
 
 		GFX.Pitch = EXT_PITCH;
 		GFX.RealPPL = EXT_PITCH;
-		GFX.Screen = (uint16*)(screenBuf.data() + EXT_OFFSET);
+		GFX.Screen = frames.GetBackBuffer().pixels;
 
 		S9xInitAPU();
 		S9xSetWinPixelFormat();
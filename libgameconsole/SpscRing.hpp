@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace SNESOnline
+{
+	// Fixed-capacity single-producer/single-consumer ring buffer. One thread may push,
+	// another one may pull, without any locks. Head and tail live on separate cache lines
+	// so producer and consumer don't invalidate each other on every access.
+	//
+	// Pushing into a full ring drops what does not fit and counts an overrun, pulling from
+	// a ring that holds less than requested hands out what is there and counts an underrun.
+	template<class T, size_t Capacity>
+	class SpscRing
+	{
+		static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two.");
+
+	private:
+		static const size_t CacheLineSize = 64;
+		static const size_t Mask = Capacity - 1;
+
+		alignas(CacheLineSize) std::atomic<size_t> head; // written by producer only
+		alignas(CacheLineSize) std::atomic<size_t> tail; // written by consumer only
+		alignas(CacheLineSize) std::atomic<uint64_t> overruns;
+		std::atomic<uint64_t> underruns;
+		alignas(CacheLineSize) T data[Capacity];
+
+	public:
+		SpscRing() : head(0), tail(0), overruns(0), underruns(0) { }
+
+		SpscRing(const SpscRing&) = delete;
+		SpscRing& operator=(const SpscRing&) = delete;
+
+		size_t GetCapacity() const { return Capacity; }
+		uint64_t GetOverrunCount() const { return overruns.load(std::memory_order_relaxed); }
+		uint64_t GetUnderrunCount() const { return underruns.load(std::memory_order_relaxed); }
+
+		// may be called from both sides, the result is only a snapshot
+		size_t Size() const
+		{
+			return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+		}
+
+		// producer side; returns the amount of elements actually stored
+		size_t Push(const T* src, size_t count)
+		{
+			const size_t h = head.load(std::memory_order_relaxed);
+			const size_t free = Capacity - (h - tail.load(std::memory_order_acquire));
+
+			if (count > free)
+			{
+				overruns.fetch_add(1, std::memory_order_relaxed);
+				count = free;
+			}
+
+			const size_t offset = h & Mask;
+			const size_t first = std::min(count, Capacity - offset);
+			std::copy_n(src, first, data + offset);
+			std::copy_n(src + first, count - first, data);
+
+			head.store(h + count, std::memory_order_release);
+			return count;
+		}
+
+		// consumer side; returns the amount of elements actually taken
+		size_t Pull(T* dst, size_t count)
+		{
+			const size_t t = tail.load(std::memory_order_relaxed);
+			const size_t available = head.load(std::memory_order_acquire) - t;
+
+			if (count > available)
+			{
+				underruns.fetch_add(1, std::memory_order_relaxed);
+				count = available;
+			}
+
+			const size_t offset = t & Mask;
+			const size_t first = std::min(count, Capacity - offset);
+			std::copy_n(data + offset, first, dst);
+			std::copy_n(data, count - first, dst + first);
+
+			tail.store(t + count, std::memory_order_release);
+			return count;
+		}
+
+		// consumer side; drops everything currently stored
+		void Clear()
+		{
+			tail.store(head.load(std::memory_order_acquire), std::memory_order_release);
+		}
+	};
+}
@@ -52,7 +52,10 @@ namespace Engine2D
 			THROW GraphicException("Unable to create surface! SDL Error: ", SDL_GetError());
 
 #ifndef __EMSCRIPTEN__
-		texture = SDL_CreateTextureFromSurface(ScreenSurface::sdl_2_0_renderer, surface);
+		if (streaming)
+			texture = SDL_CreateTexture(ScreenSurface::sdl_2_0_renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, width, height);
+		else
+			texture = SDL_CreateTextureFromSurface(ScreenSurface::sdl_2_0_renderer, surface);
 		if (texture == nullptr)
 			THROW GraphicException("Unable to create texture of dimension ", width, "x", height, "! SDL Error: ", SDL_GetError());
 #endif
@@ -178,11 +181,63 @@ namespace Engine2D
 		return true;
 	}
 
+	bool Surface::MapTexturePixels(std::function<void(void* pixels, int pitch)> interlockedCallback)
+	{
+		AssertThread();
+
+#ifndef __EMSCRIPTEN__
+		if (streaming)
+		{
+			void* pixels;
+			int pitch;
+
+			if (SDL_LockTexture(texture, nullptr, &pixels, &pitch) != 0)
+				return false;
+
+			finally texture_unlock([=](){ SDL_UnlockTexture(texture); });
+
+			interlockedCallback(pixels, pitch);
+			return true;
+		}
+#endif
+
+		if (SDL_LockSurface(surface) != 0)
+			return false;
+
+		{
+			finally surface_unlock([=](){ SDL_UnlockSurface(surface); });
+
+			interlockedCallback(surface->pixels, surface->pitch);
+		}
+
+#ifndef __EMSCRIPTEN__
+		if (SDL_UpdateTexture(texture, nullptr, surface->pixels, surface->pitch) != 0)
+			return false;
+#endif
+
+		return true;
+	}
+
+	PixelLayout Surface::GetNativeLayout()
+	{
+#ifdef __EMSCRIPTEN__
+		return PixelLayout::RGBA;
+#else
+		// both the 32-bit default surface format and ARGB8888 are stored as B, G, R, A on little-endian
+		return PixelLayout::BGRA;
+#endif
+	}
+
 	Surface::Surface(int width, int height) : width(width), height(height)
 	{
 		Create();
 	}
 
+	Surface::Surface(int width, int height, bool streaming) : width(width), height(height), streaming(streaming)
+	{
+		Create();
+	}
+
 	Surface::Surface(int width, int height, const std::vector<unsigned char>& data) : width(width), height(height)
 	{
 		Create();
@@ -194,20 +249,13 @@ namespace Engine2D
 			width * height * 4,
 			[&](void* ptr)
 		{
-			auto pixels = (unsigned char*)ptr;
-			for (int y = 0, iSrc = 0, iDst = 0; y < height; y++)
+			// RGBA -> BGRA, a whole pixel at a time so the compiler can vectorize the loop
+			auto pixels = (Uint32*)ptr;
+			auto source = (const Uint32*)data.data();
+			for (int i = 0, count = width * height; i < count; i++)
 			{
-				for (int x = 0; x < width; x++)
-				{
-					auto r = data[iSrc++];
-					auto g = data[iSrc++];
-					auto b = data[iSrc++];
-
-					pixels[iDst++] = b;
-					pixels[iDst++] = g;
-					pixels[iDst++] = r;
-					pixels[iDst++] = data[iSrc++];
-				}
+				Uint32 p = source[i];
+				pixels[i] = (p & 0xFF00FF00) | ((p >> 16) & 0xFF) | ((p & 0xFF) << 16);
 			}
 		});
 	}
@@ -29,6 +29,13 @@ THE SOFTWARE.
 
 namespace Engine2D
 {
+	// byte order of 32-bit pixels as they are laid out in memory
+	enum class PixelLayout
+	{
+		RGBA,
+		BGRA,
+	};
+
 	class Surface final
 	{
 	private:
@@ -41,6 +48,7 @@ namespace Engine2D
 		SDL_Surface* surface = nullptr;
 		SDL_Texture* texture = nullptr;
 		int width = 0, height = 0;
+		bool streaming = false;
 		void* lockedPixels = nullptr;
 
 		Surface(const Surface&) = delete;
@@ -57,8 +65,17 @@ namespace Engine2D
 
 		bool MapPixels(int expectedSizeInBytes, std::function<void(void*)> interlockedCallback);
 
+		// Passes the memory the texture is updated from, along with its pitch in bytes, to the
+		// callback. Pixels must be written in GetNativeLayout() order. For streaming surfaces this
+		// is the locked texture memory itself, so no intermediate copy is involved.
+		bool MapTexturePixels(std::function<void(void* pixels, int pitch)> interlockedCallback);
+
+		static PixelLayout GetNativeLayout();
+
 		~Surface();
 		Surface(int width, int height);
+		// streaming surfaces are meant to be updated every frame via MapTexturePixels()
+		Surface(int width, int height, bool streaming);
 		Surface(int width, int height, const std::vector<unsigned char>& data);
 		Surface(std::string path);
 	};
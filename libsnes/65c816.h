@@ -272,6 +272,6 @@ struct SRegisters
 #define PCl		PC.B.xPCl
 #define PB		PC.B.xPB
 
-extern struct SRegisters	Registers;
+extern S9X_TLS struct SRegisters	Registers;
 
 #endif
@@ -3,6 +3,8 @@
 // snes_spc 0.9.0. http://www.slack.net/~ant/
 
 #include "SNES_SPC.h"
+#include "../port.h"
+#include "../dirty.h"
 
 #include <string.h>
 
@@ -86,6 +88,7 @@ void SNES_SPC::enable_rom( int enable )
 		if ( enable )
 			memcpy( m.hi_ram, &RAM [rom_addr], sizeof m.hi_ram );
 		memcpy( &RAM [rom_addr], (enable ? m.rom : m.hi_ram), rom_size );
+		S9X_DIRTY( S9X_DIRTY_SPCRAM, rom_addr );
 		// TODO: ROM can still get overwritten when DSP writes to echo buffer
 	}
 }
@@ -397,6 +400,7 @@ void SNES_SPC::cpu_write_high( int data, int i, rel_time_t time )
 	if ( i < rom_size )
 	{
 		m.hi_ram [i] = (uint8_t) data;
+		S9X_DIRTY( S9X_DIRTY_SPCRAM, i + rom_addr );
 		if ( m.rom_enabled )
 			RAM [i + rom_addr] = m.rom [i]; // restore overwritten ROM
 	}
@@ -416,6 +420,7 @@ void SNES_SPC::cpu_write( int data, int addr, rel_time_t time )
 	
 	// RAM
 	RAM [addr] = (uint8_t) data;
+	S9X_DIRTY( S9X_DIRTY_SPCRAM, addr );
 	int reg = addr - 0xF0;
 	if ( reg >= 0 ) // 64%
 	{
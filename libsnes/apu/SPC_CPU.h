@@ -80,14 +80,15 @@ Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA */
 #define GET_SP()        (sp - 0x101 - ram)
 
 #if SPC_NO_SP_WRAPAROUND
-#define PUSH16( v )     (sp -= 2, SET_LE16( sp, v ))
-#define PUSH( v )       (void) (*--sp = (uint8_t) (v))
+#define PUSH16( v )     (sp -= 2, SET_LE16( sp, v ), S9X_DIRTY( S9X_DIRTY_SPCRAM, 0x100 ))
+#define PUSH( v )       (void) (*--sp = (uint8_t) (v), S9X_DIRTY( S9X_DIRTY_SPCRAM, 0x100 ))
 #define POP( out )      (void) ((out) = *sp++)
 
 #else
 #define PUSH16( data )\
 {\
 	int addr = (sp -= 2) - ram;\
+	S9X_DIRTY( S9X_DIRTY_SPCRAM, 0x100 );\
 	if ( addr > 0x100 )\
 	{\
 		SET_LE16( sp, data );\
@@ -103,6 +104,7 @@ Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA */
 #define PUSH( data )\
 {\
 	*--sp = (uint8_t) (data);\
+	S9X_DIRTY( S9X_DIRTY_SPCRAM, 0x100 );\
 	if ( sp - ram == 0x100 )\
 		sp += 0x100;\
 }
@@ -232,12 +234,17 @@ loop:
 	
 // Common instructions
 
+// taken branches 4 to 7 bytes back may close a polling loop, see idle_loop
 #define BRANCH( cond )\
 {\
 	pc++;\
 	pc += (BOOST::int8_t) data;\
 	if ( cond )\
+	{\
+		if ( (uint8_t) (data + 7) <= 3 )\
+			goto idle_loop;\
 		goto loop;\
+	}\
 	pc -= (BOOST::int8_t) data;\
 	rel_time -= 2;\
 	goto loop;\
@@ -249,6 +256,115 @@ loop:
 	case 0xD0: // BNE
 		BRANCH( (uint8_t) nz )
 	
+	// Polling loop: a single read of a port, timer or RAM (MOV/CMP reg,dp/abs or CMP dp,#imm,
+	// optionally followed by CMP/AND A,#imm) and the conditional branch back to it, which was just taken.
+	// Until the value read changes, every pass leaves the same registers, so the passes that
+	// surely end before this run does (and before the polled timer ticks) are done at once.
+	idle_loop: {
+		uint8_t const* head = pc;
+		int body = -(BOOST::int8_t) data;
+		int op = head [0];
+		int len;
+		int addr;
+		switch ( op )
+		{
+		case 0xE4: case 0xF8: case 0xEB: case 0x64: case 0x3E: case 0x7E: // reg,dp
+			addr = head [1] + dp;
+			len = 2;
+			break;
+		
+		case 0xE5: case 0xE9: case 0xEC: case 0x65: case 0x1E: case 0x5E: // reg,abs
+			addr = GET_LE16( head + 1 );
+			len = 3;
+			break;
+		
+		case 0x78: // CMP dp,imm
+			addr = head [2] + dp;
+			len = 3;
+			break;
+		
+		default:
+			goto loop;
+		}
+		
+		int imm_op = 0;
+		if ( body == len + 4 && (op == 0xE4 || op == 0xE5) && (head [len] == 0x68 || head [len] == 0x28) )
+			imm_op = head [len];
+		else if ( body != len + 2 )
+			goto loop;
+		
+		// ports and RAM keep their value for the rest of the run, a timer until its next tick
+		int value;
+		Timer* t = 0;
+		if ( (unsigned) (addr - (r_t0out + 0xF0)) < timer_count )
+		{
+			t = &m.timers [addr - (r_t0out + 0xF0)];
+			if ( t->counter )
+				goto loop;
+			value = 0;
+		}
+		else if ( (unsigned) (addr - (r_cpuio0 + 0xF0)) < port_count )
+			value = REGS_IN [addr - 0xF0];
+		else if ( addr < 0xF0 || addr >= 0x100 )
+			value = ram [addr];
+		else
+			goto loop;
+		
+		int new_a = a, new_x = x, new_y = y, new_nz, new_c = c;
+		switch ( op )
+		{
+		case 0xE4: case 0xE5: new_a = new_nz = value; break;
+		case 0xF8: case 0xE9: new_x = new_nz = value; break;
+		case 0xEB: case 0xEC: new_y = new_nz = value; break;
+		case 0x64: case 0x65: new_nz = a - value; new_c = ~new_nz; new_nz &= 0xFF; break;
+		case 0x3E: case 0x1E: new_nz = x - value; new_c = ~new_nz; new_nz &= 0xFF; break;
+		case 0x78:            new_nz = value - head [1]; new_c = ~new_nz; new_nz &= 0xFF; break;
+		default:              new_nz = y - value; new_c = ~new_nz; new_nz &= 0xFF; break;
+		}
+		
+		if ( imm_op == 0x68 )
+		{
+			new_nz = new_a - head [len + 1];
+			new_c = ~new_nz;
+			new_nz &= 0xFF;
+		}
+		else if ( imm_op == 0x28 )
+		{
+			new_nz = new_a &= head [len + 1];
+		}
+		
+		int branch = head [body - 2];
+		bool taken;
+		switch ( branch )
+		{
+		case 0xF0: taken = !(uint8_t) new_nz; break;
+		case 0xD0: taken = (uint8_t) new_nz != 0; break;
+		case 0x30: taken = (new_nz & nz_neg_mask) != 0; break;
+		case 0x10: taken = !(new_nz & nz_neg_mask); break;
+		case 0xB0: taken = (new_c & 0x100) != 0; break;
+		case 0x90: taken = !(new_c & 0x100); break;
+		default:   taken = false; break;
+		}
+		if ( !taken )
+			goto loop;
+		
+		int pass = m.cycle_table [op] + m.cycle_table [branch] + (imm_op ? m.cycle_table [imm_op] : 0);
+		int passes = -rel_time / pass;
+		if ( t && (t->next_time - rel_time - 1) / pass < passes )
+			passes = (t->next_time - rel_time - 1) / pass;
+		
+		if ( rel_time < 0 && passes > 0 )
+		{
+			a  = new_a;
+			x  = new_x;
+			y  = new_y;
+			nz = new_nz;
+			c  = new_c;
+			rel_time += passes * pass;
+		}
+		goto loop;
+	}
+	
 	case 0x3F:{// CALL
 		int old_addr = GET_PC() + 2;
 		SET_PC( READ_PC16( pc ) );
@@ -296,6 +412,7 @@ loop:
 		{
 			int i = dp + temp;
 			ram [i] = (uint8_t) data;
+			S9X_DIRTY( S9X_DIRTY_SPCRAM, i );
 			i -= 0xF0;
 			if ( (unsigned) i < 0x10 ) // 76%
 			{
@@ -319,6 +436,7 @@ loop:
 		{
 			int i = dp + data;
 			ram [i] = (uint8_t) a;
+			S9X_DIRTY( S9X_DIRTY_SPCRAM, i );
 			i -= 0xF0;
 			if ( (unsigned) i < 0x10 ) // 39%
 			{
@@ -886,6 +1004,9 @@ loop:
 
 	case 0x2F: // BRA rel
 		pc += (BOOST::int8_t) data;
+		// branch to itself, nothing changes until the run ends
+		if ( data == 0xFE && rel_time < 0 )
+			rel_time += -rel_time / m.cycle_table [0x2F] * m.cycle_table [0x2F];
 		goto inc_pc_loop;
 	
 	case 0x30: // BMI
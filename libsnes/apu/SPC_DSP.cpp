@@ -1,6 +1,9 @@
 // snes_spc 0.9.0. http://www.slack.net/~ant/
 
 #include "SPC_DSP.h"
+#include "../port.h"
+#include "../profiler.h"
+#include "../dirty.h"
 
 #include "blargg_endian.h"
 #include <string.h>
@@ -721,6 +724,8 @@ inline void SPC_DSP::echo_write( int ch )
 			SET_LE16A( &hi_ram [m.t_echo_ptr + ch * 2 - 0xffc0], m.t_echo_out [ch] );
 		else
 			SET_LE16A( ECHO_PTR( ch ), m.t_echo_out [ch] );
+
+		S9X_DIRTY( S9X_DIRTY_SPCRAM, m.t_echo_ptr );
 	}
 
 	m.t_echo_out [ch] = 0;
@@ -801,6 +806,7 @@ PHASE(31)  V(V4,0)       V(V1,2)\
 void SPC_DSP::run( int clocks_remain )
 {
 	require( clocks_remain > 0 );
+	S9X_PROFILE( S9X_PROFILE_DSP );
 	
 	int const phase = m.phase;
 	m.phase = (phase + clocks_remain) & 31;
@@ -181,6 +181,7 @@
 #include "apu.h"
 #include "snapshot.h"
 #include "display.h"
+#include "profiler.h"
 #include "linear_resampler.h"
 #include "hermite_resampler.h"
 
@@ -193,7 +194,7 @@
 #define APU_DENOMINATOR_PAL			709379
 #define APU_DEFAULT_RESAMPLER		HermiteResampler
 
-SNES_SPC	*spc_core = NULL;
+S9X_TLS SNES_SPC	*spc_core = NULL;
 
 static uint8 APUROM[64] =
 {
@@ -209,30 +210,30 @@ static uint8 APUROM[64] =
 
 namespace spc
 {
-	static apu_callback	sa_callback     = NULL;
-	static void			*extra_data     = NULL;
+	static S9X_TLS apu_callback	sa_callback     = NULL;
+	static S9X_TLS void			*extra_data     = NULL;
 
-	static bool8		sound_in_sync   = TRUE;
-	static bool8		sound_enabled   = FALSE;
+	static S9X_TLS bool8		sound_in_sync   = TRUE;
+	static S9X_TLS bool8		sound_enabled   = FALSE;
 
-	static int			buffer_size;
-	static int			lag_master      = 0;
-	static int			lag             = 0;
+	static S9X_TLS int			buffer_size;
+	static S9X_TLS int			lag_master      = 0;
+	static S9X_TLS int			lag             = 0;
 
-	static uint8		*landing_buffer = NULL;
-	static uint8		*shrink_buffer  = NULL;
+	static S9X_TLS uint8		*landing_buffer = NULL;
+	static S9X_TLS uint8		*shrink_buffer  = NULL;
 
-	static Resampler	*resampler      = NULL;
+	static S9X_TLS Resampler	*resampler      = NULL;
 
-	static int32		reference_time;
-	static uint32		remainder;
+	static S9X_TLS int32		reference_time;
+	static S9X_TLS uint32		remainder;
 
 	static const int	timing_hack_numerator   = SNES_SPC::tempo_unit;
-	static int			timing_hack_denominator = SNES_SPC::tempo_unit;
+	static S9X_TLS int			timing_hack_denominator = SNES_SPC::tempo_unit;
 	/* Set these to NTSC for now. Will change to PAL in S9xAPUTimingSetSpeedup
 	   if necessary on game load. */
-	static uint32		ratio_numerator = APU_NUMERATOR_NTSC;
-	static uint32		ratio_denominator = APU_DENOMINATOR_NTSC;
+	static S9X_TLS uint32		ratio_numerator = APU_NUMERATOR_NTSC;
+	static S9X_TLS uint32		ratio_denominator = APU_DENOMINATOR_NTSC;
 }
 
 static void EightBitize (uint8 *, int);
@@ -282,7 +283,7 @@ static void ReverseStereo (uint8 *src_buffer, int sample_count)
 
 bool8 S9xMixSamples (uint8 *buffer, int sample_count)
 {
-	static int	shrink_buffer_size = -1;
+	static S9X_TLS int	shrink_buffer_size = -1;
 	uint8		*dest;
 
 	if (!Settings.SixteenBitSound || !Settings.Stereo)
@@ -568,6 +569,8 @@ void S9xAPUSetReferenceTime (int32 cpucycles)
 
 void S9xAPUExecute (void)
 {
+	S9X_PROFILE(S9X_PROFILE_APU);
+
 	/* Accumulate partial APU cycles */
 	spc_core->end_frame(S9xAPUGetClock(CPU.Cycles));
 
@@ -214,6 +214,6 @@ void S9xClearSamples (void);
 bool8 S9xMixSamples (uint8 *, int);
 void S9xSetSamplesAvailableCallback (apu_callback, void *);
 
-extern SNES_SPC	*spc_core;
+extern S9X_TLS SNES_SPC	*spc_core;
 
 #endif
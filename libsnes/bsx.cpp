@@ -212,7 +212,7 @@ struct SBSX_RTC
 	int	ticks;
 };
 
-static struct SBSX_RTC	BSX_RTC;
+static S9X_TLS struct SBSX_RTC	BSX_RTC;
 
 // flash card vendor information
 static const uint8	flashcard[20] =
@@ -236,9 +236,9 @@ static const uint8	init2192[32] =	// FIXME
 	00, 00, 00, 00, 00, 00, 00, 00, 00
 };
 
-static bool8	FlashMode;
-static uint32	FlashSize;
-static uint8	*MapROM, *FlashROM;
+static S9X_TLS bool8	FlashMode;
+static S9X_TLS uint32	FlashSize;
+static S9X_TLS uint8	*MapROM, *FlashROM;
 
 static void BSX_Map_SNES (void);
 static void BSX_Map_LoROM (void);
@@ -233,8 +233,8 @@ typedef enum
 	S9X_32_BITS
 }	S9xCheatDataSize;
 
-extern SCheatData	Cheat;
-extern Watch		watches[16];
+extern S9X_TLS SCheatData	Cheat;
+extern S9X_TLS Watch		watches[16];
 
 void S9xApplyCheat (uint32);
 void S9xApplyCheats (void);
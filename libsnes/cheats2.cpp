@@ -179,6 +179,7 @@
 #include "snes9x.h"
 #include "memmap.h"
 #include "cheats.h"
+#include "fxemu.h"
 
 static uint8 S9xGetByteFree (uint32);
 static void S9xSetByteFree (uint8, uint32);
@@ -256,6 +257,9 @@ void S9xDeleteCheats (void)
 
 void S9xRemoveCheat (uint32 which1)
 {
+	S9xSuperFXSync();
+	S9xSA1Sync();
+
 	if (Cheat.c[which1].saved)
 	{
 		uint32	address = Cheat.c[which1].address;
@@ -264,7 +268,11 @@ void S9xRemoveCheat (uint32 which1)
 		uint8	*ptr = Memory.Map[block];
 
 		if (ptr >= (uint8 *) CMemory::MAP_LAST)
+		{
 			*(ptr + (address & 0xffff)) = Cheat.c[which1].saved_byte;
+			S9xFlushBlockCache();
+			S9xInvalidateHDMAPrograms();
+		}
 		else
 			S9xSetByteFree(Cheat.c[which1].saved_byte, address);
 	}
@@ -297,6 +305,9 @@ void S9xDisableCheat (uint32 which1)
 
 void S9xApplyCheat (uint32 which1)
 {
+	S9xSuperFXSync();
+	S9xSA1Sync();
+
 	uint32	address = Cheat.c[which1].address;
 
 	if (!Cheat.c[which1].saved)
@@ -309,7 +320,11 @@ void S9xApplyCheat (uint32 which1)
 	uint8	*ptr = Memory.Map[block];
 
 	if (ptr >= (uint8 *) CMemory::MAP_LAST)
+	{
 		*(ptr + (address & 0xffff)) = Cheat.c[which1].byte;
+		S9xFlushBlockCache();
+		S9xInvalidateHDMAPrograms();
+	}
 	else
 		S9xSetByteFree(Cheat.c[which1].byte, address);
 }
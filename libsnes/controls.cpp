@@ -236,8 +236,8 @@ using namespace	std;
 #define FLAG_IOBIT1				(Memory.FillRAM[0x4213] & 0x80)
 #define FLAG_IOBIT(n)			((n) ? (FLAG_IOBIT1) : (FLAG_IOBIT0))
 
-bool8	pad_read = 0, pad_read_last = 0;
-uint8	read_idx[2 /* ports */][2 /* per port */];
+S9X_TLS bool8	pad_read = 0, pad_read_last = 0;
+S9X_TLS uint8	read_idx[2 /* ports */][2 /* per port */];
 
 struct exemulti
 {
@@ -253,7 +253,7 @@ struct crosshair
 	uint8				fg, bg;
 };
 
-static struct
+static S9X_TLS struct
 {
 	int16				x, y;
 	int16				V_adj;
@@ -263,7 +263,7 @@ static struct
 	bool8				mapped;
 }	pseudopointer[8];
 
-static struct
+static S9X_TLS struct
 {
 	uint16				buttons;
 	uint16				turbos;
@@ -272,7 +272,7 @@ static struct
 	uint8				turbo_ct;
 }	joypad[8];
 
-static struct
+static S9X_TLS struct
 {
 	uint8				delta_x, delta_y;
 	int16				old_x, old_y;
@@ -282,7 +282,7 @@ static struct
 	struct crosshair	crosshair;
 }	mouse[2];
 
-static struct
+static S9X_TLS struct
 {
 	int16				x, y;
 	uint8				phys_buttons;
@@ -292,7 +292,7 @@ static struct
 	struct crosshair	crosshair;
 }	superscope;
 
-static struct
+static S9X_TLS struct
 {
 	int16				x[2], y[2];
 	uint8				buttons;
@@ -301,21 +301,21 @@ static struct
 	struct crosshair	crosshair[2];
 }	justifier;
 
-static struct
+static S9X_TLS struct
 {
 	int8				pads[4];
 }	mp5[2];
 
-static set<struct exemulti *>		exemultis;
-static set<uint32>					pollmap[NUMCTLS + 1];
-static map<uint32, s9xcommand_t>	keymap;
-static vector<s9xcommand_t *>		multis;
-static uint8						turbo_time;
-static uint8						pseudobuttons[256];
-static bool8						FLAG_LATCH = FALSE;
-static int32						curcontrollers[2] = { NONE,    NONE };
-static int32						newcontrollers[2] = { JOYPAD0, NONE };
-static char							buf[256];
+static S9X_TLS_CLASS set<struct exemulti *>		exemultis;
+static S9X_TLS_CLASS set<uint32>					pollmap[NUMCTLS + 1];
+static S9X_TLS_CLASS map<uint32, s9xcommand_t>	keymap;
+static S9X_TLS_CLASS vector<s9xcommand_t *>		multis;
+static S9X_TLS uint8						turbo_time;
+static S9X_TLS uint8						pseudobuttons[256];
+static S9X_TLS bool8						FLAG_LATCH = FALSE;
+static S9X_TLS int32						curcontrollers[2] = { NONE,    NONE };
+static S9X_TLS int32						newcontrollers[2] = { JOYPAD0, NONE };
+static S9X_TLS char							buf[256];
 
 static const char	*color_names[32] =
 {
@@ -868,7 +868,7 @@ void S9xGetController (int port, enum controllers *controller, int8 *id1, int8 *
 
 void S9xReportControllers (void)
 {
-	static char	mes[128];
+	static S9X_TLS char	mes[128];
 	char		*c = mes;
 
 	S9xVerifyControllers();
@@ -186,6 +186,7 @@
 #include "snapshot.h"
 #include "cheats.h"
 #include "logger.h"
+#include "dirty.h"
 #ifdef DEBUGGER
 #include "debug.h"
 #endif
@@ -247,6 +248,7 @@ static void S9xSoftResetCPU (void)
 
 	ICPU.ShiftedPB = 0;
 	ICPU.ShiftedDB = 0;
+	ICPU.IdleLoop.Armed = FALSE;
 	SetFlags(MemoryFlag | IndexFlag | IRQ | Emulation);
 	ClearFlags(Decimal);
 
@@ -269,6 +271,9 @@ static void S9xSoftResetCPU (void)
 
 void S9xReset (void)
 {
+	S9xSuperFXSync();
+	S9xSA1Sync();
+
 	S9xResetSaveTimer(FALSE);
 	S9xResetLogger();
 
@@ -302,10 +307,14 @@ void S9xReset (void)
 		S9xResetSRTC();
 
 	S9xInitCheatData();
+	S9xMarkAllPagesDirty();
 }
 
 void S9xSoftReset (void)
 {
+	S9xSuperFXSync();
+	S9xSA1Sync();
+
 	S9xResetSaveTimer(FALSE);
 
 	ZeroMemory(Memory.FillRAM, 0x8000);
@@ -336,4 +345,5 @@ void S9xSoftReset (void)
 		S9xResetSRTC();
 
 	S9xInitCheatData();
+	S9xMarkAllPagesDirty();
 }
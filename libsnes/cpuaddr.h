@@ -394,7 +394,7 @@ static inline uint32 Direct (AccessMode a)								// d
 
 static inline uint32 DirectIndirectSlow (AccessMode a)					// (d)
 {
-	uint32	addr = S9xGetWord(DirectSlow(READ), (!CheckEmulation() || Registers.DL) ? WRAP_BANK : WRAP_PAGE);
+	uint32	addr = S9xGetWordBank0(DirectSlow(READ), (!CheckEmulation() || Registers.DL) ? WRAP_BANK : WRAP_PAGE);
 	if (a & READ)
 		OpenBus = (uint8) (addr >> 8);
 	addr |= ICPU.ShiftedDB;
@@ -404,7 +404,7 @@ static inline uint32 DirectIndirectSlow (AccessMode a)					// (d)
 
 static inline uint32 DirectIndirectE0 (AccessMode a)					// (d)
 {
-	uint32	addr = S9xGetWord(Direct(READ));
+	uint32	addr = S9xGetWordBank0(Direct(READ));
 	if (a & READ)
 		OpenBus = (uint8) (addr >> 8);
 	addr |= ICPU.ShiftedDB;
@@ -414,7 +414,7 @@ static inline uint32 DirectIndirectE0 (AccessMode a)					// (d)
 
 static inline uint32 DirectIndirectE1 (AccessMode a)					// (d)
 {
-	uint32	addr = S9xGetWord(DirectSlow(READ), Registers.DL ? WRAP_BANK : WRAP_PAGE);
+	uint32	addr = S9xGetWordBank0(DirectSlow(READ), Registers.DL ? WRAP_BANK : WRAP_PAGE);
 	if (a & READ)
 		OpenBus = (uint8) (addr >> 8);
 	addr |= ICPU.ShiftedDB;
@@ -460,9 +460,9 @@ static inline uint32 DirectIndirectIndexedE1 (AccessMode a)				// (d),Y
 static inline uint32 DirectIndirectLongSlow (AccessMode a)				// [d]
 {
 	uint16	addr = DirectSlow(READ);
-	uint32	addr2 = S9xGetWord(addr);
+	uint32	addr2 = S9xGetWordBank0(addr);
 	OpenBus = addr2 >> 8;
-	addr2 |= (OpenBus = S9xGetByte(addr + 2)) << 16;
+	addr2 |= (OpenBus = S9xGetByteBank0(addr + 2)) << 16;
 
 	return (addr2);
 }
@@ -470,9 +470,9 @@ static inline uint32 DirectIndirectLongSlow (AccessMode a)				// [d]
 static inline uint32 DirectIndirectLong (AccessMode a)					// [d]
 {
 	uint16	addr = Direct(READ);
-	uint32	addr2 = S9xGetWord(addr);
+	uint32	addr2 = S9xGetWordBank0(addr);
 	OpenBus = addr2 >> 8;
-	addr2 |= (OpenBus = S9xGetByte(addr + 2)) << 16;
+	addr2 |= (OpenBus = S9xGetByteBank0(addr + 2)) << 16;
 
 	return (addr2);
 }
@@ -563,7 +563,7 @@ static inline uint32 DirectIndexedYE1 (AccessMode a)					// d,Y
 
 static inline uint32 DirectIndexedIndirectSlow (AccessMode a)			// (d,X)
 {
-	uint32	addr = S9xGetWord(DirectIndexedXSlow(READ), (!CheckEmulation() || Registers.DL) ? WRAP_BANK : WRAP_PAGE);
+	uint32	addr = S9xGetWordBank0(DirectIndexedXSlow(READ), (!CheckEmulation() || Registers.DL) ? WRAP_BANK : WRAP_PAGE);
 	if (a & READ)
 		OpenBus = (uint8) (addr >> 8);
 
@@ -572,7 +572,7 @@ static inline uint32 DirectIndexedIndirectSlow (AccessMode a)			// (d,X)
 
 static inline uint32 DirectIndexedIndirectE0 (AccessMode a)				// (d,X)
 {
-	uint32	addr = S9xGetWord(DirectIndexedXE0(READ));
+	uint32	addr = S9xGetWordBank0(DirectIndexedXE0(READ));
 	if (a & READ)
 		OpenBus = (uint8) (addr >> 8);
 
@@ -581,7 +581,7 @@ static inline uint32 DirectIndexedIndirectE0 (AccessMode a)				// (d,X)
 
 static inline uint32 DirectIndexedIndirectE1 (AccessMode a)				// (d,X)
 {
-	uint32	addr = S9xGetWord(DirectIndexedXE1(READ), Registers.DL ? WRAP_BANK : WRAP_PAGE);
+	uint32	addr = S9xGetWordBank0(DirectIndexedXE1(READ), Registers.DL ? WRAP_BANK : WRAP_PAGE);
 	if (a & READ)
 		OpenBus = (uint8) (addr >> 8);
 
@@ -668,7 +668,7 @@ static inline uint32 StackRelative (AccessMode a)						// d,S
 
 static inline uint32 StackRelativeIndirectIndexedSlow (AccessMode a)	// (d,S),Y
 {
-	uint32	addr = S9xGetWord(StackRelativeSlow(READ));
+	uint32	addr = S9xGetWordBank0(StackRelativeSlow(READ));
 	if (a & READ)
 		OpenBus = (uint8) (addr >> 8);
 	addr = (addr + Registers.Y.W + ICPU.ShiftedDB) & 0xffffff;
@@ -679,7 +679,7 @@ static inline uint32 StackRelativeIndirectIndexedSlow (AccessMode a)	// (d,S),Y
 
 static inline uint32 StackRelativeIndirectIndexed (AccessMode a)		// (d,S),Y
 {
-	uint32	addr = S9xGetWord(StackRelative(READ));
+	uint32	addr = S9xGetWordBank0(StackRelative(READ));
 	if (a & READ)
 		OpenBus = (uint8) (addr >> 8);
 	addr = (addr + Registers.Y.W + ICPU.ShiftedDB) & 0xffffff;
@@ -688,4 +688,24 @@ static inline uint32 StackRelativeIndirectIndexed (AccessMode a)		// (d,S),Y
 	return (addr);
 }
 
+// Modes whose effective address never leaves bank 0, cpumacro.h sends their operands through
+// the bank 0 accessors in getset.h.
+template <uint32 (*Addr) (AccessMode)> struct S9xBank0Mode { enum { value = 0 }; };
+
+#define S9X_BANK0_MODE(Addr) \
+template <> struct S9xBank0Mode<Addr> { enum { value = 1 }; };
+
+S9X_BANK0_MODE(DirectSlow)
+S9X_BANK0_MODE(Direct)
+S9X_BANK0_MODE(DirectIndexedXSlow)
+S9X_BANK0_MODE(DirectIndexedXE0)
+S9X_BANK0_MODE(DirectIndexedXE1)
+S9X_BANK0_MODE(DirectIndexedYSlow)
+S9X_BANK0_MODE(DirectIndexedYE0)
+S9X_BANK0_MODE(DirectIndexedYE1)
+S9X_BANK0_MODE(StackRelativeSlow)
+S9X_BANK0_MODE(StackRelative)
+
+#undef S9X_BANK0_MODE
+
 #endif
@@ -183,6 +183,8 @@
 #include "apu/apu.h"
 #include "fxemu.h"
 #include "snapshot.h"
+#include "profiler.h"
+#include "rewind.h"
 #ifdef DEBUGGER
 #include "debug.h"
 #include "missing.h"
@@ -193,43 +195,15 @@ static inline void S9xReschedule (void);
 
 void S9xMainLoop (void)
 {
+	S9X_PROFILE_BEGIN_FRAME();
+
+#ifdef S9X_THREADED_DISPATCH
+	S9xMainLoopThreaded();
+#else
 	for (;;)
 	{
-		if (CPU.NMILine)
-		{
-			if (Timings.NMITriggerPos <= CPU.Cycles)
-			{
-				CPU.NMILine = FALSE;
-				Timings.NMITriggerPos = 0xffff;
-				if (CPU.WaitingForInterrupt)
-				{
-					CPU.WaitingForInterrupt = FALSE;
-					Registers.PCw++;
-				}
-
-				S9xOpcode_NMI();
-			}
-		}
-
-		if (CPU.IRQTransition || CPU.IRQExternal)
-		{
-			if (CPU.IRQPending)
-				CPU.IRQPending--;
-			else
-			{
-				if (CPU.WaitingForInterrupt)
-				{
-					CPU.WaitingForInterrupt = FALSE;
-					Registers.PCw++;
-				}
-
-				CPU.IRQTransition = FALSE;
-				CPU.IRQPending = Timings.IRQPendCount;
-
-				if (!CheckFlag(IRQ))
-					S9xOpcode_IRQ();
-			}
-		}
+		if (CPU.NMILine || CPU.IRQTransition || CPU.IRQExternal || CPU.IRQExternalPending)
+			S9xDoInterruptLines();
 
 	#ifdef DEBUGGER
 		if ((CPU.Flags & BREAK_FLAG) && !(CPU.Flags & SINGLE_STEP_FLAG))
@@ -292,11 +266,17 @@ void S9xMainLoop (void)
 		}
 
 		Registers.PCw++;
+		S9X_PROFILE_OPCODE();
 		(*Opcodes[Op].S9xOpcode)();
 
 		if (Settings.SA1)
-			S9xSA1MainLoop();
+			S9xSA1Step();
 	}
+#endif
+
+	// the frame ends with everything in place
+	S9xSuperFXSync();
+	S9xSA1Sync();
 
 	S9xPackStatus();
 
@@ -308,6 +288,222 @@ void S9xMainLoop (void)
 		S9xSyncSpeed();
 		CPU.Flags &= ~SCAN_KEYS_FLAG;
 	}
+
+	S9xRewindFrame();
+
+	S9X_PROFILE_END_FRAME();
+}
+
+// services the NMI and IRQ lines before the next opcode
+void S9xDoInterruptLines (void)
+{
+	if (CPU.IRQExternalPending)
+	{
+		if (Settings.SA1)
+			S9xSA1CheckIRQ();
+		else
+			S9xSuperFXCheckIRQ();
+	}
+
+	if (CPU.NMILine)
+	{
+		if (Timings.NMITriggerPos <= CPU.Cycles)
+		{
+			CPU.NMILine = FALSE;
+			Timings.NMITriggerPos = 0xffff;
+			if (CPU.WaitingForInterrupt)
+			{
+				CPU.WaitingForInterrupt = FALSE;
+				Registers.PCw++;
+			}
+
+			ICPU.IdleLoop.Armed = FALSE;
+			S9xOpcode_NMI();
+		}
+	}
+
+	if (CPU.IRQTransition || CPU.IRQExternal)
+	{
+		if (CPU.IRQPending)
+			CPU.IRQPending--;
+		else
+		{
+			if (CPU.WaitingForInterrupt)
+			{
+				CPU.WaitingForInterrupt = FALSE;
+				Registers.PCw++;
+			}
+
+			CPU.IRQTransition = FALSE;
+			CPU.IRQPending = Timings.IRQPendCount;
+
+			if (!CheckFlag(IRQ))
+			{
+				ICPU.IdleLoop.Armed = FALSE;
+				S9xOpcode_IRQ();
+			}
+		}
+	}
+}
+
+// Reads an idle loop may poll: plain memory, which nothing but the S-CPU writes between two events
+// on carts without SA-1 or SuperFX, and HVBJOY, which only changes at the events and the H-blank edges.
+static bool8 S9xIdleLoopRead (uint32 Address, bool8 *hblank)
+{
+	uint8	*GetAddress = Memory.Map[(Address & 0xffffff) >> MEMMAP_SHIFT];
+
+	if (GetAddress >= (uint8 *) CMemory::MAP_LAST)
+		return (TRUE);
+
+	if (GetAddress == (uint8 *) CMemory::MAP_CPU && (Address & 0xffff) == 0x4212)
+	{
+		*hblank = TRUE;
+		return (TRUE);
+	}
+
+	return (FALSE);
+}
+
+// Whether the loop body, from the branch target up to and including the branch, only works on
+// registers and reads what S9xIdleLoopRead() allows. Branches inside have to stay in the body.
+static bool8 S9xIdleLoopBody (uint16 to, uint16 from, bool8 *hblank)
+{
+	uint32	starts = 0, targets = 0;
+
+	if (from - to > 32)
+		return (FALSE);
+
+	for (uint16 pc = to; pc < from; )
+	{
+		uint8	op = CPU.PCBase[pc];
+		uint8	*operand = CPU.PCBase + pc + 1;
+		uint8	length = ICPU.S9xOpLengths[op];
+		uint32	address = 0, next = 0;
+		int		bytes = 0;		// size of the memory operand, if any
+
+		if ((pc & MEMMAP_MASK) + length >= MEMMAP_BLOCK_SIZE || pc + length > from)
+			return (FALSE);
+
+		starts |= 1u << (pc - to);
+
+		switch (op)
+		{
+			// registers and flags only; not TCD, the d operands below use D as it is now
+			case 0x0a: case 0x18: case 0x1a: case 0x2a: case 0x38: case 0x3a: case 0x4a: case 0x6a:
+			case 0x7b: case 0x88: case 0x8a: case 0x98: case 0x9b: case 0xa8: case 0xaa: case 0xb8:
+			case 0xbb: case 0xc8: case 0xca: case 0xe8: case 0xea: case 0xeb:
+			// immediate
+			case 0x09: case 0x29: case 0x49: case 0x69: case 0x89: case 0xa0: case 0xa2: case 0xa9:
+			case 0xc0: case 0xc9: case 0xe0: case 0xe9:
+				break;
+
+			case 0x10: case 0x30: case 0x50: case 0x70: case 0x80: case 0x90: case 0xb0: case 0xd0: case 0xf0:
+			{
+				uint16	target = pc + 2 + (int8) operand[0];
+				if (target < to || target >= from)
+					return (FALSE);
+
+				targets |= 1u << (target - to);
+				break;
+			}
+
+			// reads of A sized operands, d, a and l
+			case 0x05: case 0x24: case 0x25: case 0x45: case 0x65: case 0xa5: case 0xc5: case 0xe5:
+				bytes = CheckMemory() ? 1 : 2;
+				address = (uint16) (Registers.D.W + operand[0]);
+				next = (uint16) (address + 1);
+				break;
+
+			case 0x0d: case 0x2c: case 0x2d: case 0x4d: case 0x6d: case 0xad: case 0xcd: case 0xed:
+				bytes = CheckMemory() ? 1 : 2;
+				address = ICPU.ShiftedDB | READ_WORD(operand);
+				next = address + 1;
+				break;
+
+			case 0x0f: case 0x2f: case 0x4f: case 0x6f: case 0xaf: case 0xcf: case 0xef:
+				bytes = CheckMemory() ? 1 : 2;
+				address = READ_3WORD(operand);
+				next = address + 1;
+				break;
+
+			// reads of X or Y sized operands, d and a
+			case 0xa4: case 0xa6: case 0xc4: case 0xe4:
+				bytes = CheckIndex() ? 1 : 2;
+				address = (uint16) (Registers.D.W + operand[0]);
+				next = (uint16) (address + 1);
+				break;
+
+			case 0xac: case 0xae: case 0xcc: case 0xec:
+				bytes = CheckIndex() ? 1 : 2;
+				address = ICPU.ShiftedDB | READ_WORD(operand);
+				next = address + 1;
+				break;
+
+			default:
+				return (FALSE);
+		}
+
+		if (bytes && (!S9xIdleLoopRead(address, hblank) || (bytes == 2 && !S9xIdleLoopRead(next, hblank))))
+			return (FALSE);
+
+		pc += length;
+	}
+
+	return ((targets & ~starts) == 0);
+}
+
+// Called for a backward branch inside the current memory block, before it's taken. If the same
+// branch was taken last time with the same registers and flags, nothing happened in between (no
+// event, no interrupt) and the body can't write or see anything change, every further pass would
+// repeat the last one exactly. As many of those as fit before the next event, IRQ timer position
+// or HVBJOY change are then skipped by only moving the cycle counters; the emulated state ends up
+// the same as running them, so this is safe for movies, rewind and netplay.
+void S9xIdleLoopBranch (uint16 to)
+{
+	struct SIdleLoop	&loop = ICPU.IdleLoop;
+	int32				pass = CPU.Cycles - loop.Cycles;
+	bool8				hblank = FALSE;
+
+	if (loop.Armed && pass > 0 && CPU.PrevCycles - loop.PrevCycles == pass &&
+		CPU.NextEvent == loop.NextEvent && CPU.V_Counter == loop.V_Counter &&
+		ICPU._Carry == loop._Carry && ICPU._Zero == loop._Zero && ICPU._Negative == loop._Negative && ICPU._Overflow == loop._Overflow &&
+		OpenBus == loop.OpenBus && CPU.PCBase == loop.PCBase && memcmp(&Registers, &loop.Regs, sizeof(Registers)) == 0 &&
+		!CPU.NMILine && !CPU.IRQLine && !CPU.IRQTransition && !CPU.IRQExternal && !Settings.SA1 && !Settings.SuperFX &&
+		S9xIdleLoopBody(to, Registers.PCw, &hblank))
+	{
+		int32	bound = CPU.NextEvent;
+
+		if (PPU.HTimerEnabled && PPU.HTimerPosition > loop.Cycles && PPU.HTimerPosition < bound)
+			bound = PPU.HTimerPosition;
+
+		if (hblank)
+		{
+			if (Timings.HBlankEnd > loop.Cycles && Timings.HBlankEnd < bound)
+				bound = Timings.HBlankEnd;
+			if (Timings.HBlankStart > loop.Cycles && Timings.HBlankStart < bound)
+				bound = Timings.HBlankStart;
+		}
+
+		if (bound > CPU.Cycles)
+		{
+			int32	skip = (bound - 1 - CPU.Cycles) / pass * pass;
+			CPU.Cycles += skip;
+			CPU.PrevCycles += skip;
+		}
+	}
+
+	loop.Armed = TRUE;
+	loop.Cycles = CPU.Cycles;
+	loop.PrevCycles = CPU.PrevCycles;
+	loop.NextEvent = CPU.NextEvent;
+	loop.V_Counter = CPU.V_Counter;
+	loop._Carry = ICPU._Carry;
+	loop._Zero = ICPU._Zero;
+	loop._Negative = ICPU._Negative;
+	loop._Overflow = ICPU._Overflow;
+	loop.OpenBus = OpenBus;
+	loop.PCBase = CPU.PCBase;
+	memcpy(&loop.Regs, &Registers, sizeof(Registers));
 }
 
 static inline void S9xReschedule (void)
@@ -394,6 +590,8 @@ void S9xDoHEventProcessing (void)
 				SuperFX.oneLineDone = FALSE;
 			}
 
+			// like the APU, the SA-1 catches up once a scanline at the latest
+			S9xSA1Sync();
 			S9xAPUEndScanline();
 			CPU.Cycles -= Timings.H_Max;
 			CPU.PrevCycles -= Timings.H_Max;
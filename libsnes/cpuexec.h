@@ -184,11 +184,56 @@
 #include "debug.h"
 #endif
 
+// S9xMainLoop() dispatches through computed goto labels instead of the SOpcodes tables where
+// the compiler supports it; define S9X_NO_THREADED_DISPATCH to keep the plain table calls.
+#if defined(__GNUC__) && !defined(DEBUGGER) && !defined(S9X_NO_THREADED_DISPATCH)
+#define S9X_THREADED_DISPATCH
+#endif
+
 struct SOpcodes
 {
 	void (*S9xOpcode) (void);
 };
 
+#ifdef S9X_THREADED_DISPATCH
+// Pre-decoded runs of ROM code for S9xMainLoopThreaded(), keyed by where the first opcode sits in
+// host memory and the opcode table. The host address stays the same through bank remaps, so only
+// changes to the ROM bytes themselves need S9xFlushBlockCache().
+#define S9X_BLOCK_CACHE_SIZE	4096
+#define S9X_BLOCK_OPS			16
+
+struct SBlockOp
+{
+	uint8		*Host;		// CPU.PCBase + PC of the opcode
+	const void	*Label;
+};
+
+struct SBlock
+{
+	uint8			*Start;
+	struct SOpcodes	*Opcodes;
+	uint32			Generation;
+	struct SBlockOp	Ops[S9X_BLOCK_OPS + 1];	// ends with a NULL Host
+};
+#endif
+
+// What the last backward branch left behind, see S9xIdleLoopBranch().
+struct SIdleLoop
+{
+	bool8	Armed;
+	int32	Cycles;
+	int32	PrevCycles;
+	int32	NextEvent;
+	int32	V_Counter;
+	uint8	_Carry;
+	uint8	_Zero;
+	uint8	_Negative;
+	uint8	_Overflow;
+	uint8	OpenBus;
+	uint8	*PCBase;
+	struct SRegisters	Regs;
+};
+
 struct SICPU
 {
 	struct SOpcodes	*S9xOpcodes;
@@ -201,9 +246,14 @@ struct SICPU
 	uint32	ShiftedDB;
 	uint32	Frame;
 	uint32	FrameAdvanceCount;
+	struct SIdleLoop	IdleLoop;
+#ifdef S9X_THREADED_DISPATCH
+	struct SBlock	*Blocks;
+	uint32	BlockGeneration;
+#endif
 };
 
-extern struct SICPU		ICPU;
+extern S9X_TLS struct SICPU		ICPU;
 
 extern struct SOpcodes	S9xOpcodesE1[256];
 extern struct SOpcodes	S9xOpcodesM1X1[256];
@@ -217,6 +267,14 @@ extern uint8			S9xOpLengthsM0X1[256];
 extern uint8			S9xOpLengthsM0X0[256];
 
 void S9xMainLoop (void);
+void S9xDoInterruptLines (void);
+void S9xIdleLoopBranch (uint16);
+#ifdef S9X_THREADED_DISPATCH
+void S9xMainLoopThreaded (void);
+void S9xFlushBlockCache (void);
+#else
+static inline void S9xFlushBlockCache (void) { }
+#endif
 void S9xReset (void);
 void S9xSoftReset (void);
 void S9xDoHEventProcessing (void);
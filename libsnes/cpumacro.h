@@ -179,17 +179,48 @@
 #ifndef _CPUMACRO_H_
 #define _CPUMACRO_H_
 
+// Operands of the direct page and stack modes (see S9xBank0Mode) go through the bank 0 accessors.
+template <bool Bank0>
+static inline uint8 GetByte (uint32 Address)
+{
+	return (Bank0 ? S9xGetByteBank0(Address) : S9xGetByte(Address));
+}
+
+template <bool Bank0>
+static inline uint16 GetWord (uint32 Address, enum s9xwrap_t w)
+{
+	return (Bank0 ? S9xGetWordBank0(Address, w) : S9xGetWord(Address, w));
+}
+
+template <bool Bank0>
+static inline void SetByte (uint8 Byte, uint32 Address)
+{
+	if (Bank0)
+		S9xSetByteBank0(Byte, Address);
+	else
+		S9xSetByte(Byte, Address);
+}
+
+template <bool Bank0>
+static inline void SetWord (uint16 Word, uint32 Address, enum s9xwrap_t w, enum s9xwriteorder_t o = WRITE_01)
+{
+	if (Bank0)
+		S9xSetWordBank0(Word, Address, w, o);
+	else
+		S9xSetWord(Word, Address, w, o);
+}
+
 #define rOP8(OP, ADDR, WRAP, FUNC) \
 static void Op##OP (void) \
 { \
-	uint8	val = OpenBus = S9xGetByte(ADDR(READ)); \
+	uint8	val = OpenBus = GetByte<S9xBank0Mode<ADDR>::value>(ADDR(READ)); \
 	FUNC(val); \
 }
 
 #define rOP16(OP, ADDR, WRAP, FUNC) \
 static void Op##OP (void) \
 { \
-	uint16	val = S9xGetWord(ADDR(READ), WRAP); \
+	uint16	val = GetWord<S9xBank0Mode<ADDR>::value>(ADDR(READ), WRAP); \
 	OpenBus = (uint8) (val >> 8); \
 	FUNC(val); \
 }
@@ -199,12 +230,12 @@ static void Op##OP (void) \
 { \
 	if (Check##COND()) \
 	{ \
-		uint8	val = OpenBus = S9xGetByte(ADDR(READ)); \
+		uint8	val = OpenBus = GetByte<S9xBank0Mode<ADDR>::value>(ADDR(READ)); \
 		FUNC(val); \
 	} \
 	else \
 	{ \
-		uint16	val = S9xGetWord(ADDR(READ), WRAP); \
+		uint16	val = GetWord<S9xBank0Mode<ADDR>::value>(ADDR(READ), WRAP); \
 		OpenBus = (uint8) (val >> 8); \
 		FUNC(val); \
 	} \
@@ -219,22 +250,22 @@ rOPC(OP, Index, ADDR, WRAP, FUNC)
 #define wOP8(OP, ADDR, WRAP, FUNC) \
 static void Op##OP (void) \
 { \
-	FUNC##8(ADDR(WRITE)); \
+	FUNC##8<S9xBank0Mode<ADDR>::value>(ADDR(WRITE)); \
 }
 
 #define wOP16(OP, ADDR, WRAP, FUNC) \
 static void Op##OP (void) \
 { \
-	FUNC##16(ADDR(WRITE), WRAP); \
+	FUNC##16<S9xBank0Mode<ADDR>::value>(ADDR(WRITE), WRAP); \
 }
 
 #define wOPC(OP, COND, ADDR, WRAP, FUNC) \
 static void Op##OP (void) \
 { \
 	if (Check##COND()) \
-		FUNC##8(ADDR(WRITE)); \
+		FUNC##8<S9xBank0Mode<ADDR>::value>(ADDR(WRITE)); \
 	else \
-		FUNC##16(ADDR(WRITE), WRAP); \
+		FUNC##16<S9xBank0Mode<ADDR>::value>(ADDR(WRITE), WRAP); \
 }
 
 #define wOPM(OP, ADDR, WRAP, FUNC) \
@@ -246,27 +277,36 @@ wOPC(OP, Index, ADDR, WRAP, FUNC)
 #define mOP8(OP, ADDR, WRAP, FUNC) \
 static void Op##OP (void) \
 { \
-	FUNC##8(ADDR(MODIFY)); \
+	FUNC##8<S9xBank0Mode<ADDR>::value>(ADDR(MODIFY)); \
 }
 
 #define mOP16(OP, ADDR, WRAP, FUNC) \
 static void Op##OP (void) \
 { \
-	FUNC##16(ADDR(MODIFY), WRAP); \
+	FUNC##16<S9xBank0Mode<ADDR>::value>(ADDR(MODIFY), WRAP); \
 }
 
 #define mOPC(OP, COND, ADDR, WRAP, FUNC) \
 static void Op##OP (void) \
 { \
 	if (Check##COND()) \
-		FUNC##8(ADDR(MODIFY)); \
+		FUNC##8<S9xBank0Mode<ADDR>::value>(ADDR(MODIFY)); \
 	else \
-		FUNC##16(ADDR(MODIFY), WRAP); \
+		FUNC##16<S9xBank0Mode<ADDR>::value>(ADDR(MODIFY), WRAP); \
 }
 
 #define mOPM(OP, ADDR, WRAP, FUNC) \
 mOPC(OP, Memory, ADDR, WRAP, FUNC)
 
+// backward branches of the S-CPU may be spinning on memory that can't change, see S9xIdleLoopBranch()
+#if !defined(SA1_OPCODES) && !defined(DEBUGGER)
+#define CheckIdleLoop(to) \
+	if ((to) < Registers.PCw && Settings.SkipIdleLoops) \
+		S9xIdleLoopBranch(to)
+#else
+#define CheckIdleLoop(to)
+#endif
+
 #define bOP(OP, REL, COND, CHK, E) \
 static void Op##OP (void) \
 { \
@@ -280,7 +320,10 @@ static void Op##OP (void) \
 		if ((Registers.PCw & ~MEMMAP_MASK) != (newPC.W & ~MEMMAP_MASK)) \
 			S9xSetPCBase(ICPU.ShiftedPB + newPC.W); \
 		else \
+		{ \
+			CheckIdleLoop(newPC.W); \
 			Registers.PCw = newPC.W; \
+		} \
 	} \
 }
 
@@ -435,24 +478,26 @@ static inline void AND (uint8 Work8)
 	SetZN(Registers.AL);
 }
 
+template <bool Bank0>
 static inline void ASL16 (uint32 OpAddress, s9xwrap_t w)
 {
-	uint16	Work16 = S9xGetWord(OpAddress, w);
+	uint16	Work16 = GetWord<Bank0>(OpAddress, w);
 	ICPU._Carry = (Work16 & 0x8000) != 0;
 	Work16 <<= 1;
 	AddCycles(ONE_CYCLE);
-	S9xSetWord(Work16, OpAddress, w, WRITE_10);
+	SetWord<Bank0>(Work16, OpAddress, w, WRITE_10);
 	OpenBus = Work16 & 0xff;
 	SetZN(Work16);
 }
 
+template <bool Bank0>
 static inline void ASL8 (uint32 OpAddress)
 {
-	uint8	Work8 = S9xGetByte(OpAddress);
+	uint8	Work8 = GetByte<Bank0>(OpAddress);
 	ICPU._Carry = (Work8 & 0x80) != 0;
 	Work8 <<= 1;
 	AddCycles(ONE_CYCLE);
-	S9xSetByte(Work8, OpAddress);
+	SetByte<Bank0>(Work8, OpAddress);
 	OpenBus = Work8;
 	SetZN(Work8);
 }
@@ -513,20 +558,22 @@ static inline void CPY (uint8 val)
 	SetZN((uint8) Int16);
 }
 
+template <bool Bank0>
 static inline void DEC16 (uint32 OpAddress, s9xwrap_t w)
 {
-	uint16	Work16 = S9xGetWord(OpAddress, w) - 1;
+	uint16	Work16 = GetWord<Bank0>(OpAddress, w) - 1;
 	AddCycles(ONE_CYCLE);
-	S9xSetWord(Work16, OpAddress, w, WRITE_10);
+	SetWord<Bank0>(Work16, OpAddress, w, WRITE_10);
 	OpenBus = Work16 & 0xff;
 	SetZN(Work16);
 }
 
+template <bool Bank0>
 static inline void DEC8 (uint32 OpAddress)
 {
-	uint8	Work8 = S9xGetByte(OpAddress) - 1;
+	uint8	Work8 = GetByte<Bank0>(OpAddress) - 1;
 	AddCycles(ONE_CYCLE);
-	S9xSetByte(Work8, OpAddress);
+	SetByte<Bank0>(Work8, OpAddress);
 	OpenBus = Work8;
 	SetZN(Work8);
 }
@@ -543,20 +590,22 @@ static inline void EOR (uint8 val)
 	SetZN(Registers.AL);
 }
 
+template <bool Bank0>
 static inline void INC16 (uint32 OpAddress, s9xwrap_t w)
 {
-	uint16	Work16 = S9xGetWord(OpAddress, w) + 1;
+	uint16	Work16 = GetWord<Bank0>(OpAddress, w) + 1;
 	AddCycles(ONE_CYCLE);
-	S9xSetWord(Work16, OpAddress, w, WRITE_10);
+	SetWord<Bank0>(Work16, OpAddress, w, WRITE_10);
 	OpenBus = Work16 & 0xff;
 	SetZN(Work16);
 }
 
+template <bool Bank0>
 static inline void INC8 (uint32 OpAddress)
 {
-	uint8	Work8 = S9xGetByte(OpAddress) + 1;
+	uint8	Work8 = GetByte<Bank0>(OpAddress) + 1;
 	AddCycles(ONE_CYCLE);
-	S9xSetByte(Work8, OpAddress);
+	SetByte<Bank0>(Work8, OpAddress);
 	OpenBus = Work8;
 	SetZN(Work8);
 }
@@ -597,24 +646,26 @@ static inline void LDY (uint8 val)
 	SetZN(Registers.YL);
 }
 
+template <bool Bank0>
 static inline void LSR16 (uint32 OpAddress, s9xwrap_t w)
 {
-	uint16	Work16 = S9xGetWord(OpAddress, w);
+	uint16	Work16 = GetWord<Bank0>(OpAddress, w);
 	ICPU._Carry = Work16 & 1;
 	Work16 >>= 1;
 	AddCycles(ONE_CYCLE);
-	S9xSetWord(Work16, OpAddress, w, WRITE_10);
+	SetWord<Bank0>(Work16, OpAddress, w, WRITE_10);
 	OpenBus = Work16 & 0xff;
 	SetZN(Work16);
 }
 
+template <bool Bank0>
 static inline void LSR8 (uint32 OpAddress)
 {
-	uint8	Work8 = S9xGetByte(OpAddress);
+	uint8	Work8 = GetByte<Bank0>(OpAddress);
 	ICPU._Carry = Work8 & 1;
 	Work8 >>= 1;
 	AddCycles(ONE_CYCLE);
-	S9xSetByte(Work8, OpAddress);
+	SetByte<Bank0>(Work8, OpAddress);
 	OpenBus = Work8;
 	SetZN(Work8);
 }
@@ -631,44 +682,48 @@ static inline void ORA (uint8 val)
 	SetZN(Registers.AL);
 }
 
+template <bool Bank0>
 static inline void ROL16 (uint32 OpAddress, s9xwrap_t w)
 {
-	uint32	Work32 = (((uint32) S9xGetWord(OpAddress, w)) << 1) | CheckCarry();
+	uint32	Work32 = (((uint32) GetWord<Bank0>(OpAddress, w)) << 1) | CheckCarry();
 	ICPU._Carry = Work32 >= 0x10000;
 	AddCycles(ONE_CYCLE);
-	S9xSetWord((uint16) Work32, OpAddress, w, WRITE_10);
+	SetWord<Bank0>((uint16) Work32, OpAddress, w, WRITE_10);
 	OpenBus = Work32 & 0xff;
 	SetZN((uint16) Work32);
 }
 
+template <bool Bank0>
 static inline void ROL8 (uint32 OpAddress)
 {
-	uint16	Work16 = (((uint16) S9xGetByte(OpAddress)) << 1) | CheckCarry();
+	uint16	Work16 = (((uint16) GetByte<Bank0>(OpAddress)) << 1) | CheckCarry();
 	ICPU._Carry = Work16 >= 0x100;
 	AddCycles(ONE_CYCLE);
-	S9xSetByte((uint8) Work16, OpAddress);
+	SetByte<Bank0>((uint8) Work16, OpAddress);
 	OpenBus = Work16 & 0xff;
 	SetZN((uint8) Work16);
 }
 
+template <bool Bank0>
 static inline void ROR16 (uint32 OpAddress, s9xwrap_t w)
 {
-	uint32	Work32 = ((uint32) S9xGetWord(OpAddress, w)) | (((uint32) CheckCarry()) << 16);
+	uint32	Work32 = ((uint32) GetWord<Bank0>(OpAddress, w)) | (((uint32) CheckCarry()) << 16);
 	ICPU._Carry = Work32 & 1;
 	Work32 >>= 1;
 	AddCycles(ONE_CYCLE);
-	S9xSetWord((uint16) Work32, OpAddress, w, WRITE_10);
+	SetWord<Bank0>((uint16) Work32, OpAddress, w, WRITE_10);
 	OpenBus = Work32 & 0xff;
 	SetZN((uint16) Work32);
 }
 
+template <bool Bank0>
 static inline void ROR8 (uint32 OpAddress)
 {
-	uint16	Work16 = ((uint16) S9xGetByte(OpAddress)) | (((uint16) CheckCarry()) << 8);
+	uint16	Work16 = ((uint16) GetByte<Bank0>(OpAddress)) | (((uint16) CheckCarry()) << 8);
 	ICPU._Carry = Work16 & 1;
 	Work16 >>= 1;
 	AddCycles(ONE_CYCLE);
-	S9xSetByte((uint8) Work16, OpAddress);
+	SetByte<Bank0>((uint8) Work16, OpAddress);
 	OpenBus = Work16 & 0xff;
 	SetZN((uint8) Work16);
 }
@@ -801,91 +856,103 @@ static inline void SBC (uint8 Work8)
 	}
 }
 
+template <bool Bank0>
 static inline void STA16 (uint32 OpAddress, enum s9xwrap_t w)
 {
-	S9xSetWord(Registers.A.W, OpAddress, w);
+	SetWord<Bank0>(Registers.A.W, OpAddress, w);
 	OpenBus = Registers.AH;
 }
 
+template <bool Bank0>
 static inline void STA8 (uint32 OpAddress)
 {
-	S9xSetByte(Registers.AL, OpAddress);
+	SetByte<Bank0>(Registers.AL, OpAddress);
 	OpenBus = Registers.AL;
 }
 
+template <bool Bank0>
 static inline void STX16 (uint32 OpAddress, enum s9xwrap_t w)
 {
-	S9xSetWord(Registers.X.W, OpAddress, w);
+	SetWord<Bank0>(Registers.X.W, OpAddress, w);
 	OpenBus = Registers.XH;
 }
 
+template <bool Bank0>
 static inline void STX8 (uint32 OpAddress)
 {
-	S9xSetByte(Registers.XL, OpAddress);
+	SetByte<Bank0>(Registers.XL, OpAddress);
 	OpenBus = Registers.XL;
 }
 
+template <bool Bank0>
 static inline void STY16 (uint32 OpAddress, enum s9xwrap_t w)
 {
-	S9xSetWord(Registers.Y.W, OpAddress, w);
+	SetWord<Bank0>(Registers.Y.W, OpAddress, w);
 	OpenBus = Registers.YH;
 }
 
+template <bool Bank0>
 static inline void STY8 (uint32 OpAddress)
 {
-	S9xSetByte(Registers.YL, OpAddress);
+	SetByte<Bank0>(Registers.YL, OpAddress);
 	OpenBus = Registers.YL;
 }
 
+template <bool Bank0>
 static inline void STZ16 (uint32 OpAddress, enum s9xwrap_t w)
 {
-	S9xSetWord(0, OpAddress, w);
+	SetWord<Bank0>(0, OpAddress, w);
 	OpenBus = 0;
 }
 
+template <bool Bank0>
 static inline void STZ8 (uint32 OpAddress)
 {
-	S9xSetByte(0, OpAddress);
+	SetByte<Bank0>(0, OpAddress);
 	OpenBus = 0;
 }
 
+template <bool Bank0>
 static inline void TSB16 (uint32 OpAddress, enum s9xwrap_t w)
 {
-	uint16	Work16 = S9xGetWord(OpAddress, w);
+	uint16	Work16 = GetWord<Bank0>(OpAddress, w);
 	ICPU._Zero = (Work16 & Registers.A.W) != 0;
 	Work16 |= Registers.A.W;
 	AddCycles(ONE_CYCLE);
-	S9xSetWord(Work16, OpAddress, w, WRITE_10);
+	SetWord<Bank0>(Work16, OpAddress, w, WRITE_10);
 	OpenBus = Work16 & 0xff;
 }
 
+template <bool Bank0>
 static inline void TSB8 (uint32 OpAddress)
 {
-	uint8	Work8 = S9xGetByte(OpAddress);
+	uint8	Work8 = GetByte<Bank0>(OpAddress);
 	ICPU._Zero = Work8 & Registers.AL;
 	Work8 |= Registers.AL;
 	AddCycles(ONE_CYCLE);
-	S9xSetByte(Work8, OpAddress);
+	SetByte<Bank0>(Work8, OpAddress);
 	OpenBus = Work8;
 }
 
+template <bool Bank0>
 static inline void TRB16 (uint32 OpAddress, enum s9xwrap_t w)
 {
-	uint16	Work16 = S9xGetWord(OpAddress, w);
+	uint16	Work16 = GetWord<Bank0>(OpAddress, w);
 	ICPU._Zero = (Work16 & Registers.A.W) != 0;
 	Work16 &= ~Registers.A.W;
 	AddCycles(ONE_CYCLE);
-	S9xSetWord(Work16, OpAddress, w, WRITE_10);
+	SetWord<Bank0>(Work16, OpAddress, w, WRITE_10);
 	OpenBus = Work16 & 0xff;
 }
 
+template <bool Bank0>
 static inline void TRB8 (uint32 OpAddress)
 {
-	uint8	Work8 = S9xGetByte(OpAddress);
+	uint8	Work8 = GetByte<Bank0>(OpAddress);
 	ICPU._Zero = Work8 & Registers.AL;
 	Work8 &= ~Registers.AL;
 	AddCycles(ONE_CYCLE);
-	S9xSetByte(Work8, OpAddress);
+	SetByte<Bank0>(Work8, OpAddress);
 	OpenBus = Work8;
 }
 
@@ -179,6 +179,7 @@
 #include "snes9x.h"
 #include "memmap.h"
 #include "apu/apu.h"
+#include "profiler.h"
 
 // for "Magic WDM" features
 #ifdef DEBUGGER	
@@ -1774,19 +1775,19 @@ static void OpEA (void)
 /* PUSH Instructions ******************************************************* */
 
 #define PushW(w) \
-	S9xSetWord(w, Registers.S.W - 1, WRAP_BANK, WRITE_10); \
+	S9xSetWordBank0(w, Registers.S.W - 1, WRAP_BANK, WRITE_10); \
 	Registers.S.W -= 2;
 
 #define PushWE(w) \
 	Registers.SL--; \
-	S9xSetWord(w, Registers.S.W, WRAP_PAGE, WRITE_10); \
+	S9xSetWordBank0(w, Registers.S.W, WRAP_PAGE, WRITE_10); \
 	Registers.SL--;
 
 #define PushB(b) \
-	S9xSetByte(b, Registers.S.W--);
+	S9xSetByteBank0(b, Registers.S.W--);
 
 #define PushBE(b) \
-	S9xSetByte(b, Registers.S.W); \
+	S9xSetByteBank0(b, Registers.S.W); \
 	Registers.SL--;
 
 // PEA
@@ -2125,20 +2126,20 @@ static void Op5ASlow (void)
 /* PULL Instructions ******************************************************* */
 
 #define PullW(w) \
-	w = S9xGetWord(Registers.S.W + 1, WRAP_BANK); \
+	w = S9xGetWordBank0(Registers.S.W + 1, WRAP_BANK); \
 	Registers.S.W += 2;
 
 #define PullWE(w) \
 	Registers.SL++; \
-	w = S9xGetWord(Registers.S.W, WRAP_PAGE); \
+	w = S9xGetWordBank0(Registers.S.W, WRAP_PAGE); \
 	Registers.SL++;
 
 #define PullB(b) \
-	b = S9xGetByte(++Registers.S.W);
+	b = S9xGetByteBank0(++Registers.S.W);
 
 #define PullBE(b) \
 	Registers.SL++; \
-	b = S9xGetByte(Registers.S.W);
+	b = S9xGetByteBank0(Registers.S.W);
 
 // PLA
 static void Op68E1 (void)
@@ -2759,6 +2760,11 @@ void S9xOpcode_IRQ (void)
 	#endif
 #endif
 
+#ifndef SA1_OPCODES
+	// the SA-1 may have overwritten the vector
+	S9xSA1Sync();
+#endif
+
 	// IRQ and NMI do an opcode fetch as their first "IO" cycle.
 	AddCycles(CPU.MemSpeed + ONE_CYCLE);
 
@@ -2834,6 +2840,11 @@ void S9xOpcode_NMI (void)
 	#endif
 #endif
 
+#ifndef SA1_OPCODES
+	// the SA-1 may have overwritten the vector
+	S9xSA1Sync();
+#endif
+
 	// IRQ and NMI do an opcode fetch as their first "IO" cycle.
 	AddCycles(CPU.MemSpeed + ONE_CYCLE);
 
@@ -3549,338 +3560,572 @@ static void Op42 (void)
 
 /* CPU-S9xOpcodes Definitions ************************************************/
 
+// one OP(T, handler) per opcode, T names the table; also expanded into the labels of S9xMainLoopThreaded()
+#define S9X_OPCODES_M1X1(OP, T) \
+	OP(T, Op00)        OP(T, Op01E0M1)    OP(T, Op02)        OP(T, Op03M1)      OP(T, Op04M1) \
+	OP(T, Op05M1)      OP(T, Op06M1)      OP(T, Op07M1)      OP(T, Op08E0)      OP(T, Op09M1) \
+	OP(T, Op0AM1)      OP(T, Op0BE0)      OP(T, Op0CM1)      OP(T, Op0DM1)      OP(T, Op0EM1) \
+	OP(T, Op0FM1)      OP(T, Op10E0)      OP(T, Op11E0M1X1)  OP(T, Op12E0M1)    OP(T, Op13M1) \
+	OP(T, Op14M1)      OP(T, Op15E0M1)    OP(T, Op16E0M1)    OP(T, Op17M1)      OP(T, Op18) \
+	OP(T, Op19M1X1)    OP(T, Op1AM1)      OP(T, Op1B)        OP(T, Op1CM1)      OP(T, Op1DM1X1) \
+	OP(T, Op1EM1X1)    OP(T, Op1FM1)      OP(T, Op20E0)      OP(T, Op21E0M1)    OP(T, Op22E0) \
+	OP(T, Op23M1)      OP(T, Op24M1)      OP(T, Op25M1)      OP(T, Op26M1)      OP(T, Op27M1) \
+	OP(T, Op28E0)      OP(T, Op29M1)      OP(T, Op2AM1)      OP(T, Op2BE0)      OP(T, Op2CM1) \
+	OP(T, Op2DM1)      OP(T, Op2EM1)      OP(T, Op2FM1)      OP(T, Op30E0)      OP(T, Op31E0M1X1) \
+	OP(T, Op32E0M1)    OP(T, Op33M1)      OP(T, Op34E0M1)    OP(T, Op35E0M1)    OP(T, Op36E0M1) \
+	OP(T, Op37M1)      OP(T, Op38)        OP(T, Op39M1X1)    OP(T, Op3AM1)      OP(T, Op3B) \
+	OP(T, Op3CM1X1)    OP(T, Op3DM1X1)    OP(T, Op3EM1X1)    OP(T, Op3FM1)      OP(T, Op40Slow) \
+	OP(T, Op41E0M1)    OP(T, Op42)        OP(T, Op43M1)      OP(T, Op44X1)      OP(T, Op45M1) \
+	OP(T, Op46M1)      OP(T, Op47M1)      OP(T, Op48E0M1)    OP(T, Op49M1)      OP(T, Op4AM1) \
+	OP(T, Op4BE0)      OP(T, Op4C)        OP(T, Op4DM1)      OP(T, Op4EM1)      OP(T, Op4FM1) \
+	OP(T, Op50E0)      OP(T, Op51E0M1X1)  OP(T, Op52E0M1)    OP(T, Op53M1)      OP(T, Op54X1) \
+	OP(T, Op55E0M1)    OP(T, Op56E0M1)    OP(T, Op57M1)      OP(T, Op58)        OP(T, Op59M1X1) \
+	OP(T, Op5AE0X1)    OP(T, Op5B)        OP(T, Op5C)        OP(T, Op5DM1X1)    OP(T, Op5EM1X1) \
+	OP(T, Op5FM1)      OP(T, Op60E0)      OP(T, Op61E0M1)    OP(T, Op62E0)      OP(T, Op63M1) \
+	OP(T, Op64M1)      OP(T, Op65M1)      OP(T, Op66M1)      OP(T, Op67M1)      OP(T, Op68E0M1) \
+	OP(T, Op69M1)      OP(T, Op6AM1)      OP(T, Op6BE0)      OP(T, Op6C)        OP(T, Op6DM1) \
+	OP(T, Op6EM1)      OP(T, Op6FM1)      OP(T, Op70E0)      OP(T, Op71E0M1X1)  OP(T, Op72E0M1) \
+	OP(T, Op73M1)      OP(T, Op74E0M1)    OP(T, Op75E0M1)    OP(T, Op76E0M1)    OP(T, Op77M1) \
+	OP(T, Op78)        OP(T, Op79M1X1)    OP(T, Op7AE0X1)    OP(T, Op7B)        OP(T, Op7C) \
+	OP(T, Op7DM1X1)    OP(T, Op7EM1X1)    OP(T, Op7FM1)      OP(T, Op80E0)      OP(T, Op81E0M1) \
+	OP(T, Op82)        OP(T, Op83M1)      OP(T, Op84X1)      OP(T, Op85M1)      OP(T, Op86X1) \
+	OP(T, Op87M1)      OP(T, Op88X1)      OP(T, Op89M1)      OP(T, Op8AM1)      OP(T, Op8BE0) \
+	OP(T, Op8CX1)      OP(T, Op8DM1)      OP(T, Op8EX1)      OP(T, Op8FM1)      OP(T, Op90E0) \
+	OP(T, Op91E0M1X1)  OP(T, Op92E0M1)    OP(T, Op93M1)      OP(T, Op94E0X1)    OP(T, Op95E0M1) \
+	OP(T, Op96E0X1)    OP(T, Op97M1)      OP(T, Op98M1)      OP(T, Op99M1X1)    OP(T, Op9A) \
+	OP(T, Op9BX1)      OP(T, Op9CM1)      OP(T, Op9DM1X1)    OP(T, Op9EM1X1)    OP(T, Op9FM1) \
+	OP(T, OpA0X1)      OP(T, OpA1E0M1)    OP(T, OpA2X1)      OP(T, OpA3M1)      OP(T, OpA4X1) \
+	OP(T, OpA5M1)      OP(T, OpA6X1)      OP(T, OpA7M1)      OP(T, OpA8X1)      OP(T, OpA9M1) \
+	OP(T, OpAAX1)      OP(T, OpABE0)      OP(T, OpACX1)      OP(T, OpADM1)      OP(T, OpAEX1) \
+	OP(T, OpAFM1)      OP(T, OpB0E0)      OP(T, OpB1E0M1X1)  OP(T, OpB2E0M1)    OP(T, OpB3M1) \
+	OP(T, OpB4E0X1)    OP(T, OpB5E0M1)    OP(T, OpB6E0X1)    OP(T, OpB7M1)      OP(T, OpB8) \
+	OP(T, OpB9M1X1)    OP(T, OpBAX1)      OP(T, OpBBX1)      OP(T, OpBCX1)      OP(T, OpBDM1X1) \
+	OP(T, OpBEX1)      OP(T, OpBFM1)      OP(T, OpC0X1)      OP(T, OpC1E0M1)    OP(T, OpC2) \
+	OP(T, OpC3M1)      OP(T, OpC4X1)      OP(T, OpC5M1)      OP(T, OpC6M1)      OP(T, OpC7M1) \
+	OP(T, OpC8X1)      OP(T, OpC9M1)      OP(T, OpCAX1)      OP(T, OpCB)        OP(T, OpCCX1) \
+	OP(T, OpCDM1)      OP(T, OpCEM1)      OP(T, OpCFM1)      OP(T, OpD0E0)      OP(T, OpD1E0M1X1) \
+	OP(T, OpD2E0M1)    OP(T, OpD3M1)      OP(T, OpD4E0)      OP(T, OpD5E0M1)    OP(T, OpD6E0M1) \
+	OP(T, OpD7M1)      OP(T, OpD8)        OP(T, OpD9M1X1)    OP(T, OpDAE0X1)    OP(T, OpDB) \
+	OP(T, OpDC)        OP(T, OpDDM1X1)    OP(T, OpDEM1X1)    OP(T, OpDFM1)      OP(T, OpE0X1) \
+	OP(T, OpE1E0M1)    OP(T, OpE2)        OP(T, OpE3M1)      OP(T, OpE4X1)      OP(T, OpE5M1) \
+	OP(T, OpE6M1)      OP(T, OpE7M1)      OP(T, OpE8X1)      OP(T, OpE9M1)      OP(T, OpEA) \
+	OP(T, OpEB)        OP(T, OpECX1)      OP(T, OpEDM1)      OP(T, OpEEM1)      OP(T, OpEFM1) \
+	OP(T, OpF0E0)      OP(T, OpF1E0M1X1)  OP(T, OpF2E0M1)    OP(T, OpF3M1)      OP(T, OpF4E0) \
+	OP(T, OpF5E0M1)    OP(T, OpF6E0M1)    OP(T, OpF7M1)      OP(T, OpF8)        OP(T, OpF9M1X1) \
+	OP(T, OpFAE0X1)    OP(T, OpFB)        OP(T, OpFCE0)      OP(T, OpFDM1X1)    OP(T, OpFEM1X1) \
+	OP(T, OpFFM1)
+
+#define S9X_OPCODES_E1(OP, T) \
+	OP(T, Op00)        OP(T, Op01E1)      OP(T, Op02)        OP(T, Op03M1)      OP(T, Op04M1) \
+	OP(T, Op05M1)      OP(T, Op06M1)      OP(T, Op07M1)      OP(T, Op08E1)      OP(T, Op09M1) \
+	OP(T, Op0AM1)      OP(T, Op0BE1)      OP(T, Op0CM1)      OP(T, Op0DM1)      OP(T, Op0EM1) \
+	OP(T, Op0FM1)      OP(T, Op10E1)      OP(T, Op11E1)      OP(T, Op12E1)      OP(T, Op13M1) \
+	OP(T, Op14M1)      OP(T, Op15E1)      OP(T, Op16E1)      OP(T, Op17M1)      OP(T, Op18) \
+	OP(T, Op19M1X1)    OP(T, Op1AM1)      OP(T, Op1B)        OP(T, Op1CM1)      OP(T, Op1DM1X1) \
+	OP(T, Op1EM1X1)    OP(T, Op1FM1)      OP(T, Op20E1)      OP(T, Op21E1)      OP(T, Op22E1) \
+	OP(T, Op23M1)      OP(T, Op24M1)      OP(T, Op25M1)      OP(T, Op26M1)      OP(T, Op27M1) \
+	OP(T, Op28E1)      OP(T, Op29M1)      OP(T, Op2AM1)      OP(T, Op2BE1)      OP(T, Op2CM1) \
+	OP(T, Op2DM1)      OP(T, Op2EM1)      OP(T, Op2FM1)      OP(T, Op30E1)      OP(T, Op31E1) \
+	OP(T, Op32E1)      OP(T, Op33M1)      OP(T, Op34E1)      OP(T, Op35E1)      OP(T, Op36E1) \
+	OP(T, Op37M1)      OP(T, Op38)        OP(T, Op39M1X1)    OP(T, Op3AM1)      OP(T, Op3B) \
+	OP(T, Op3CM1X1)    OP(T, Op3DM1X1)    OP(T, Op3EM1X1)    OP(T, Op3FM1)      OP(T, Op40Slow) \
+	OP(T, Op41E1)      OP(T, Op42)        OP(T, Op43M1)      OP(T, Op44X1)      OP(T, Op45M1) \
+	OP(T, Op46M1)      OP(T, Op47M1)      OP(T, Op48E1)      OP(T, Op49M1)      OP(T, Op4AM1) \
+	OP(T, Op4BE1)      OP(T, Op4C)        OP(T, Op4DM1)      OP(T, Op4EM1)      OP(T, Op4FM1) \
+	OP(T, Op50E1)      OP(T, Op51E1)      OP(T, Op52E1)      OP(T, Op53M1)      OP(T, Op54X1) \
+	OP(T, Op55E1)      OP(T, Op56E1)      OP(T, Op57M1)      OP(T, Op58)        OP(T, Op59M1X1) \
+	OP(T, Op5AE1)      OP(T, Op5B)        OP(T, Op5C)        OP(T, Op5DM1X1)    OP(T, Op5EM1X1) \
+	OP(T, Op5FM1)      OP(T, Op60E1)      OP(T, Op61E1)      OP(T, Op62E1)      OP(T, Op63M1) \
+	OP(T, Op64M1)      OP(T, Op65M1)      OP(T, Op66M1)      OP(T, Op67M1)      OP(T, Op68E1) \
+	OP(T, Op69M1)      OP(T, Op6AM1)      OP(T, Op6BE1)      OP(T, Op6C)        OP(T, Op6DM1) \
+	OP(T, Op6EM1)      OP(T, Op6FM1)      OP(T, Op70E1)      OP(T, Op71E1)      OP(T, Op72E1) \
+	OP(T, Op73M1)      OP(T, Op74E1)      OP(T, Op75E1)      OP(T, Op76E1)      OP(T, Op77M1) \
+	OP(T, Op78)        OP(T, Op79M1X1)    OP(T, Op7AE1)      OP(T, Op7B)        OP(T, Op7C) \
+	OP(T, Op7DM1X1)    OP(T, Op7EM1X1)    OP(T, Op7FM1)      OP(T, Op80E1)      OP(T, Op81E1) \
+	OP(T, Op82)        OP(T, Op83M1)      OP(T, Op84X1)      OP(T, Op85M1)      OP(T, Op86X1) \
+	OP(T, Op87M1)      OP(T, Op88X1)      OP(T, Op89M1)      OP(T, Op8AM1)      OP(T, Op8BE1) \
+	OP(T, Op8CX1)      OP(T, Op8DM1)      OP(T, Op8EX1)      OP(T, Op8FM1)      OP(T, Op90E1) \
+	OP(T, Op91E1)      OP(T, Op92E1)      OP(T, Op93M1)      OP(T, Op94E1)      OP(T, Op95E1) \
+	OP(T, Op96E1)      OP(T, Op97M1)      OP(T, Op98M1)      OP(T, Op99M1X1)    OP(T, Op9A) \
+	OP(T, Op9BX1)      OP(T, Op9CM1)      OP(T, Op9DM1X1)    OP(T, Op9EM1X1)    OP(T, Op9FM1) \
+	OP(T, OpA0X1)      OP(T, OpA1E1)      OP(T, OpA2X1)      OP(T, OpA3M1)      OP(T, OpA4X1) \
+	OP(T, OpA5M1)      OP(T, OpA6X1)      OP(T, OpA7M1)      OP(T, OpA8X1)      OP(T, OpA9M1) \
+	OP(T, OpAAX1)      OP(T, OpABE1)      OP(T, OpACX1)      OP(T, OpADM1)      OP(T, OpAEX1) \
+	OP(T, OpAFM1)      OP(T, OpB0E1)      OP(T, OpB1E1)      OP(T, OpB2E1)      OP(T, OpB3M1) \
+	OP(T, OpB4E1)      OP(T, OpB5E1)      OP(T, OpB6E1)      OP(T, OpB7M1)      OP(T, OpB8) \
+	OP(T, OpB9M1X1)    OP(T, OpBAX1)      OP(T, OpBBX1)      OP(T, OpBCX1)      OP(T, OpBDM1X1) \
+	OP(T, OpBEX1)      OP(T, OpBFM1)      OP(T, OpC0X1)      OP(T, OpC1E1)      OP(T, OpC2) \
+	OP(T, OpC3M1)      OP(T, OpC4X1)      OP(T, OpC5M1)      OP(T, OpC6M1)      OP(T, OpC7M1) \
+	OP(T, OpC8X1)      OP(T, OpC9M1)      OP(T, OpCAX1)      OP(T, OpCB)        OP(T, OpCCX1) \
+	OP(T, OpCDM1)      OP(T, OpCEM1)      OP(T, OpCFM1)      OP(T, OpD0E1)      OP(T, OpD1E1) \
+	OP(T, OpD2E1)      OP(T, OpD3M1)      OP(T, OpD4E1)      OP(T, OpD5E1)      OP(T, OpD6E1) \
+	OP(T, OpD7M1)      OP(T, OpD8)        OP(T, OpD9M1X1)    OP(T, OpDAE1)      OP(T, OpDB) \
+	OP(T, OpDC)        OP(T, OpDDM1X1)    OP(T, OpDEM1X1)    OP(T, OpDFM1)      OP(T, OpE0X1) \
+	OP(T, OpE1E1)      OP(T, OpE2)        OP(T, OpE3M1)      OP(T, OpE4X1)      OP(T, OpE5M1) \
+	OP(T, OpE6M1)      OP(T, OpE7M1)      OP(T, OpE8X1)      OP(T, OpE9M1)      OP(T, OpEA) \
+	OP(T, OpEB)        OP(T, OpECX1)      OP(T, OpEDM1)      OP(T, OpEEM1)      OP(T, OpEFM1) \
+	OP(T, OpF0E1)      OP(T, OpF1E1)      OP(T, OpF2E1)      OP(T, OpF3M1)      OP(T, OpF4E1) \
+	OP(T, OpF5E1)      OP(T, OpF6E1)      OP(T, OpF7M1)      OP(T, OpF8)        OP(T, OpF9M1X1) \
+	OP(T, OpFAE1)      OP(T, OpFB)        OP(T, OpFCE1)      OP(T, OpFDM1X1)    OP(T, OpFEM1X1) \
+	OP(T, OpFFM1)
+
+#define S9X_OPCODES_M1X0(OP, T) \
+	OP(T, Op00)        OP(T, Op01E0M1)    OP(T, Op02)        OP(T, Op03M1)      OP(T, Op04M1) \
+	OP(T, Op05M1)      OP(T, Op06M1)      OP(T, Op07M1)      OP(T, Op08E0)      OP(T, Op09M1) \
+	OP(T, Op0AM1)      OP(T, Op0BE0)      OP(T, Op0CM1)      OP(T, Op0DM1)      OP(T, Op0EM1) \
+	OP(T, Op0FM1)      OP(T, Op10E0)      OP(T, Op11E0M1X0)  OP(T, Op12E0M1)    OP(T, Op13M1) \
+	OP(T, Op14M1)      OP(T, Op15E0M1)    OP(T, Op16E0M1)    OP(T, Op17M1)      OP(T, Op18) \
+	OP(T, Op19M1X0)    OP(T, Op1AM1)      OP(T, Op1B)        OP(T, Op1CM1)      OP(T, Op1DM1X0) \
+	OP(T, Op1EM1X0)    OP(T, Op1FM1)      OP(T, Op20E0)      OP(T, Op21E0M1)    OP(T, Op22E0) \
+	OP(T, Op23M1)      OP(T, Op24M1)      OP(T, Op25M1)      OP(T, Op26M1)      OP(T, Op27M1) \
+	OP(T, Op28E0)      OP(T, Op29M1)      OP(T, Op2AM1)      OP(T, Op2BE0)      OP(T, Op2CM1) \
+	OP(T, Op2DM1)      OP(T, Op2EM1)      OP(T, Op2FM1)      OP(T, Op30E0)      OP(T, Op31E0M1X0) \
+	OP(T, Op32E0M1)    OP(T, Op33M1)      OP(T, Op34E0M1)    OP(T, Op35E0M1)    OP(T, Op36E0M1) \
+	OP(T, Op37M1)      OP(T, Op38)        OP(T, Op39M1X0)    OP(T, Op3AM1)      OP(T, Op3B) \
+	OP(T, Op3CM1X0)    OP(T, Op3DM1X0)    OP(T, Op3EM1X0)    OP(T, Op3FM1)      OP(T, Op40Slow) \
+	OP(T, Op41E0M1)    OP(T, Op42)        OP(T, Op43M1)      OP(T, Op44X0)      OP(T, Op45M1) \
+	OP(T, Op46M1)      OP(T, Op47M1)      OP(T, Op48E0M1)    OP(T, Op49M1)      OP(T, Op4AM1) \
+	OP(T, Op4BE0)      OP(T, Op4C)        OP(T, Op4DM1)      OP(T, Op4EM1)      OP(T, Op4FM1) \
+	OP(T, Op50E0)      OP(T, Op51E0M1X0)  OP(T, Op52E0M1)    OP(T, Op53M1)      OP(T, Op54X0) \
+	OP(T, Op55E0M1)    OP(T, Op56E0M1)    OP(T, Op57M1)      OP(T, Op58)        OP(T, Op59M1X0) \
+	OP(T, Op5AE0X0)    OP(T, Op5B)        OP(T, Op5C)        OP(T, Op5DM1X0)    OP(T, Op5EM1X0) \
+	OP(T, Op5FM1)      OP(T, Op60E0)      OP(T, Op61E0M1)    OP(T, Op62E0)      OP(T, Op63M1) \
+	OP(T, Op64M1)      OP(T, Op65M1)      OP(T, Op66M1)      OP(T, Op67M1)      OP(T, Op68E0M1) \
+	OP(T, Op69M1)      OP(T, Op6AM1)      OP(T, Op6BE0)      OP(T, Op6C)        OP(T, Op6DM1) \
+	OP(T, Op6EM1)      OP(T, Op6FM1)      OP(T, Op70E0)      OP(T, Op71E0M1X0)  OP(T, Op72E0M1) \
+	OP(T, Op73M1)      OP(T, Op74E0M1)    OP(T, Op75E0M1)    OP(T, Op76E0M1)    OP(T, Op77M1) \
+	OP(T, Op78)        OP(T, Op79M1X0)    OP(T, Op7AE0X0)    OP(T, Op7B)        OP(T, Op7C) \
+	OP(T, Op7DM1X0)    OP(T, Op7EM1X0)    OP(T, Op7FM1)      OP(T, Op80E0)      OP(T, Op81E0M1) \
+	OP(T, Op82)        OP(T, Op83M1)      OP(T, Op84X0)      OP(T, Op85M1)      OP(T, Op86X0) \
+	OP(T, Op87M1)      OP(T, Op88X0)      OP(T, Op89M1)      OP(T, Op8AM1)      OP(T, Op8BE0) \
+	OP(T, Op8CX0)      OP(T, Op8DM1)      OP(T, Op8EX0)      OP(T, Op8FM1)      OP(T, Op90E0) \
+	OP(T, Op91E0M1X0)  OP(T, Op92E0M1)    OP(T, Op93M1)      OP(T, Op94E0X0)    OP(T, Op95E0M1) \
+	OP(T, Op96E0X0)    OP(T, Op97M1)      OP(T, Op98M1)      OP(T, Op99M1X0)    OP(T, Op9A) \
+	OP(T, Op9BX0)      OP(T, Op9CM1)      OP(T, Op9DM1X0)    OP(T, Op9EM1X0)    OP(T, Op9FM1) \
+	OP(T, OpA0X0)      OP(T, OpA1E0M1)    OP(T, OpA2X0)      OP(T, OpA3M1)      OP(T, OpA4X0) \
+	OP(T, OpA5M1)      OP(T, OpA6X0)      OP(T, OpA7M1)      OP(T, OpA8X0)      OP(T, OpA9M1) \
+	OP(T, OpAAX0)      OP(T, OpABE0)      OP(T, OpACX0)      OP(T, OpADM1)      OP(T, OpAEX0) \
+	OP(T, OpAFM1)      OP(T, OpB0E0)      OP(T, OpB1E0M1X0)  OP(T, OpB2E0M1)    OP(T, OpB3M1) \
+	OP(T, OpB4E0X0)    OP(T, OpB5E0M1)    OP(T, OpB6E0X0)    OP(T, OpB7M1)      OP(T, OpB8) \
+	OP(T, OpB9M1X0)    OP(T, OpBAX0)      OP(T, OpBBX0)      OP(T, OpBCX0)      OP(T, OpBDM1X0) \
+	OP(T, OpBEX0)      OP(T, OpBFM1)      OP(T, OpC0X0)      OP(T, OpC1E0M1)    OP(T, OpC2) \
+	OP(T, OpC3M1)      OP(T, OpC4X0)      OP(T, OpC5M1)      OP(T, OpC6M1)      OP(T, OpC7M1) \
+	OP(T, OpC8X0)      OP(T, OpC9M1)      OP(T, OpCAX0)      OP(T, OpCB)        OP(T, OpCCX0) \
+	OP(T, OpCDM1)      OP(T, OpCEM1)      OP(T, OpCFM1)      OP(T, OpD0E0)      OP(T, OpD1E0M1X0) \
+	OP(T, OpD2E0M1)    OP(T, OpD3M1)      OP(T, OpD4E0)      OP(T, OpD5E0M1)    OP(T, OpD6E0M1) \
+	OP(T, OpD7M1)      OP(T, OpD8)        OP(T, OpD9M1X0)    OP(T, OpDAE0X0)    OP(T, OpDB) \
+	OP(T, OpDC)        OP(T, OpDDM1X0)    OP(T, OpDEM1X0)    OP(T, OpDFM1)      OP(T, OpE0X0) \
+	OP(T, OpE1E0M1)    OP(T, OpE2)        OP(T, OpE3M1)      OP(T, OpE4X0)      OP(T, OpE5M1) \
+	OP(T, OpE6M1)      OP(T, OpE7M1)      OP(T, OpE8X0)      OP(T, OpE9M1)      OP(T, OpEA) \
+	OP(T, OpEB)        OP(T, OpECX0)      OP(T, OpEDM1)      OP(T, OpEEM1)      OP(T, OpEFM1) \
+	OP(T, OpF0E0)      OP(T, OpF1E0M1X0)  OP(T, OpF2E0M1)    OP(T, OpF3M1)      OP(T, OpF4E0) \
+	OP(T, OpF5E0M1)    OP(T, OpF6E0M1)    OP(T, OpF7M1)      OP(T, OpF8)        OP(T, OpF9M1X0) \
+	OP(T, OpFAE0X0)    OP(T, OpFB)        OP(T, OpFCE0)      OP(T, OpFDM1X0)    OP(T, OpFEM1X0) \
+	OP(T, OpFFM1)
+
+#define S9X_OPCODES_M0X0(OP, T) \
+	OP(T, Op00)        OP(T, Op01E0M0)    OP(T, Op02)        OP(T, Op03M0)      OP(T, Op04M0) \
+	OP(T, Op05M0)      OP(T, Op06M0)      OP(T, Op07M0)      OP(T, Op08E0)      OP(T, Op09M0) \
+	OP(T, Op0AM0)      OP(T, Op0BE0)      OP(T, Op0CM0)      OP(T, Op0DM0)      OP(T, Op0EM0) \
+	OP(T, Op0FM0)      OP(T, Op10E0)      OP(T, Op11E0M0X0)  OP(T, Op12E0M0)    OP(T, Op13M0) \
+	OP(T, Op14M0)      OP(T, Op15E0M0)    OP(T, Op16E0M0)    OP(T, Op17M0)      OP(T, Op18) \
+	OP(T, Op19M0X0)    OP(T, Op1AM0)      OP(T, Op1B)        OP(T, Op1CM0)      OP(T, Op1DM0X0) \
+	OP(T, Op1EM0X0)    OP(T, Op1FM0)      OP(T, Op20E0)      OP(T, Op21E0M0)    OP(T, Op22E0) \
+	OP(T, Op23M0)      OP(T, Op24M0)      OP(T, Op25M0)      OP(T, Op26M0)      OP(T, Op27M0) \
+	OP(T, Op28E0)      OP(T, Op29M0)      OP(T, Op2AM0)      OP(T, Op2BE0)      OP(T, Op2CM0) \
+	OP(T, Op2DM0)      OP(T, Op2EM0)      OP(T, Op2FM0)      OP(T, Op30E0)      OP(T, Op31E0M0X0) \
+	OP(T, Op32E0M0)    OP(T, Op33M0)      OP(T, Op34E0M0)    OP(T, Op35E0M0)    OP(T, Op36E0M0) \
+	OP(T, Op37M0)      OP(T, Op38)        OP(T, Op39M0X0)    OP(T, Op3AM0)      OP(T, Op3B) \
+	OP(T, Op3CM0X0)    OP(T, Op3DM0X0)    OP(T, Op3EM0X0)    OP(T, Op3FM0)      OP(T, Op40Slow) \
+	OP(T, Op41E0M0)    OP(T, Op42)        OP(T, Op43M0)      OP(T, Op44X0)      OP(T, Op45M0) \
+	OP(T, Op46M0)      OP(T, Op47M0)      OP(T, Op48E0M0)    OP(T, Op49M0)      OP(T, Op4AM0) \
+	OP(T, Op4BE0)      OP(T, Op4C)        OP(T, Op4DM0)      OP(T, Op4EM0)      OP(T, Op4FM0) \
+	OP(T, Op50E0)      OP(T, Op51E0M0X0)  OP(T, Op52E0M0)    OP(T, Op53M0)      OP(T, Op54X0) \
+	OP(T, Op55E0M0)    OP(T, Op56E0M0)    OP(T, Op57M0)      OP(T, Op58)        OP(T, Op59M0X0) \
+	OP(T, Op5AE0X0)    OP(T, Op5B)        OP(T, Op5C)        OP(T, Op5DM0X0)    OP(T, Op5EM0X0) \
+	OP(T, Op5FM0)      OP(T, Op60E0)      OP(T, Op61E0M0)    OP(T, Op62E0)      OP(T, Op63M0) \
+	OP(T, Op64M0)      OP(T, Op65M0)      OP(T, Op66M0)      OP(T, Op67M0)      OP(T, Op68E0M0) \
+	OP(T, Op69M0)      OP(T, Op6AM0)      OP(T, Op6BE0)      OP(T, Op6C)        OP(T, Op6DM0) \
+	OP(T, Op6EM0)      OP(T, Op6FM0)      OP(T, Op70E0)      OP(T, Op71E0M0X0)  OP(T, Op72E0M0) \
+	OP(T, Op73M0)      OP(T, Op74E0M0)    OP(T, Op75E0M0)    OP(T, Op76E0M0)    OP(T, Op77M0) \
+	OP(T, Op78)        OP(T, Op79M0X0)    OP(T, Op7AE0X0)    OP(T, Op7B)        OP(T, Op7C) \
+	OP(T, Op7DM0X0)    OP(T, Op7EM0X0)    OP(T, Op7FM0)      OP(T, Op80E0)      OP(T, Op81E0M0) \
+	OP(T, Op82)        OP(T, Op83M0)      OP(T, Op84X0)      OP(T, Op85M0)      OP(T, Op86X0) \
+	OP(T, Op87M0)      OP(T, Op88X0)      OP(T, Op89M0)      OP(T, Op8AM0)      OP(T, Op8BE0) \
+	OP(T, Op8CX0)      OP(T, Op8DM0)      OP(T, Op8EX0)      OP(T, Op8FM0)      OP(T, Op90E0) \
+	OP(T, Op91E0M0X0)  OP(T, Op92E0M0)    OP(T, Op93M0)      OP(T, Op94E0X0)    OP(T, Op95E0M0) \
+	OP(T, Op96E0X0)    OP(T, Op97M0)      OP(T, Op98M0)      OP(T, Op99M0X0)    OP(T, Op9A) \
+	OP(T, Op9BX0)      OP(T, Op9CM0)      OP(T, Op9DM0X0)    OP(T, Op9EM0X0)    OP(T, Op9FM0) \
+	OP(T, OpA0X0)      OP(T, OpA1E0M0)    OP(T, OpA2X0)      OP(T, OpA3M0)      OP(T, OpA4X0) \
+	OP(T, OpA5M0)      OP(T, OpA6X0)      OP(T, OpA7M0)      OP(T, OpA8X0)      OP(T, OpA9M0) \
+	OP(T, OpAAX0)      OP(T, OpABE0)      OP(T, OpACX0)      OP(T, OpADM0)      OP(T, OpAEX0) \
+	OP(T, OpAFM0)      OP(T, OpB0E0)      OP(T, OpB1E0M0X0)  OP(T, OpB2E0M0)    OP(T, OpB3M0) \
+	OP(T, OpB4E0X0)    OP(T, OpB5E0M0)    OP(T, OpB6E0X0)    OP(T, OpB7M0)      OP(T, OpB8) \
+	OP(T, OpB9M0X0)    OP(T, OpBAX0)      OP(T, OpBBX0)      OP(T, OpBCX0)      OP(T, OpBDM0X0) \
+	OP(T, OpBEX0)      OP(T, OpBFM0)      OP(T, OpC0X0)      OP(T, OpC1E0M0)    OP(T, OpC2) \
+	OP(T, OpC3M0)      OP(T, OpC4X0)      OP(T, OpC5M0)      OP(T, OpC6M0)      OP(T, OpC7M0) \
+	OP(T, OpC8X0)      OP(T, OpC9M0)      OP(T, OpCAX0)      OP(T, OpCB)        OP(T, OpCCX0) \
+	OP(T, OpCDM0)      OP(T, OpCEM0)      OP(T, OpCFM0)      OP(T, OpD0E0)      OP(T, OpD1E0M0X0) \
+	OP(T, OpD2E0M0)    OP(T, OpD3M0)      OP(T, OpD4E0)      OP(T, OpD5E0M0)    OP(T, OpD6E0M0) \
+	OP(T, OpD7M0)      OP(T, OpD8)        OP(T, OpD9M0X0)    OP(T, OpDAE0X0)    OP(T, OpDB) \
+	OP(T, OpDC)        OP(T, OpDDM0X0)    OP(T, OpDEM0X0)    OP(T, OpDFM0)      OP(T, OpE0X0) \
+	OP(T, OpE1E0M0)    OP(T, OpE2)        OP(T, OpE3M0)      OP(T, OpE4X0)      OP(T, OpE5M0) \
+	OP(T, OpE6M0)      OP(T, OpE7M0)      OP(T, OpE8X0)      OP(T, OpE9M0)      OP(T, OpEA) \
+	OP(T, OpEB)        OP(T, OpECX0)      OP(T, OpEDM0)      OP(T, OpEEM0)      OP(T, OpEFM0) \
+	OP(T, OpF0E0)      OP(T, OpF1E0M0X0)  OP(T, OpF2E0M0)    OP(T, OpF3M0)      OP(T, OpF4E0) \
+	OP(T, OpF5E0M0)    OP(T, OpF6E0M0)    OP(T, OpF7M0)      OP(T, OpF8)        OP(T, OpF9M0X0) \
+	OP(T, OpFAE0X0)    OP(T, OpFB)        OP(T, OpFCE0)      OP(T, OpFDM0X0)    OP(T, OpFEM0X0) \
+	OP(T, OpFFM0)
+
+#define S9X_OPCODES_M0X1(OP, T) \
+	OP(T, Op00)        OP(T, Op01E0M0)    OP(T, Op02)        OP(T, Op03M0)      OP(T, Op04M0) \
+	OP(T, Op05M0)      OP(T, Op06M0)      OP(T, Op07M0)      OP(T, Op08E0)      OP(T, Op09M0) \
+	OP(T, Op0AM0)      OP(T, Op0BE0)      OP(T, Op0CM0)      OP(T, Op0DM0)      OP(T, Op0EM0) \
+	OP(T, Op0FM0)      OP(T, Op10E0)      OP(T, Op11E0M0X1)  OP(T, Op12E0M0)    OP(T, Op13M0) \
+	OP(T, Op14M0)      OP(T, Op15E0M0)    OP(T, Op16E0M0)    OP(T, Op17M0)      OP(T, Op18) \
+	OP(T, Op19M0X1)    OP(T, Op1AM0)      OP(T, Op1B)        OP(T, Op1CM0)      OP(T, Op1DM0X1) \
+	OP(T, Op1EM0X1)    OP(T, Op1FM0)      OP(T, Op20E0)      OP(T, Op21E0M0)    OP(T, Op22E0) \
+	OP(T, Op23M0)      OP(T, Op24M0)      OP(T, Op25M0)      OP(T, Op26M0)      OP(T, Op27M0) \
+	OP(T, Op28E0)      OP(T, Op29M0)      OP(T, Op2AM0)      OP(T, Op2BE0)      OP(T, Op2CM0) \
+	OP(T, Op2DM0)      OP(T, Op2EM0)      OP(T, Op2FM0)      OP(T, Op30E0)      OP(T, Op31E0M0X1) \
+	OP(T, Op32E0M0)    OP(T, Op33M0)      OP(T, Op34E0M0)    OP(T, Op35E0M0)    OP(T, Op36E0M0) \
+	OP(T, Op37M0)      OP(T, Op38)        OP(T, Op39M0X1)    OP(T, Op3AM0)      OP(T, Op3B) \
+	OP(T, Op3CM0X1)    OP(T, Op3DM0X1)    OP(T, Op3EM0X1)    OP(T, Op3FM0)      OP(T, Op40Slow) \
+	OP(T, Op41E0M0)    OP(T, Op42)        OP(T, Op43M0)      OP(T, Op44X1)      OP(T, Op45M0) \
+	OP(T, Op46M0)      OP(T, Op47M0)      OP(T, Op48E0M0)    OP(T, Op49M0)      OP(T, Op4AM0) \
+	OP(T, Op4BE0)      OP(T, Op4C)        OP(T, Op4DM0)      OP(T, Op4EM0)      OP(T, Op4FM0) \
+	OP(T, Op50E0)      OP(T, Op51E0M0X1)  OP(T, Op52E0M0)    OP(T, Op53M0)      OP(T, Op54X1) \
+	OP(T, Op55E0M0)    OP(T, Op56E0M0)    OP(T, Op57M0)      OP(T, Op58)        OP(T, Op59M0X1) \
+	OP(T, Op5AE0X1)    OP(T, Op5B)        OP(T, Op5C)        OP(T, Op5DM0X1)    OP(T, Op5EM0X1) \
+	OP(T, Op5FM0)      OP(T, Op60E0)      OP(T, Op61E0M0)    OP(T, Op62E0)      OP(T, Op63M0) \
+	OP(T, Op64M0)      OP(T, Op65M0)      OP(T, Op66M0)      OP(T, Op67M0)      OP(T, Op68E0M0) \
+	OP(T, Op69M0)      OP(T, Op6AM0)      OP(T, Op6BE0)      OP(T, Op6C)        OP(T, Op6DM0) \
+	OP(T, Op6EM0)      OP(T, Op6FM0)      OP(T, Op70E0)      OP(T, Op71E0M0X1)  OP(T, Op72E0M0) \
+	OP(T, Op73M0)      OP(T, Op74E0M0)    OP(T, Op75E0M0)    OP(T, Op76E0M0)    OP(T, Op77M0) \
+	OP(T, Op78)        OP(T, Op79M0X1)    OP(T, Op7AE0X1)    OP(T, Op7B)        OP(T, Op7C) \
+	OP(T, Op7DM0X1)    OP(T, Op7EM0X1)    OP(T, Op7FM0)      OP(T, Op80E0)      OP(T, Op81E0M0) \
+	OP(T, Op82)        OP(T, Op83M0)      OP(T, Op84X1)      OP(T, Op85M0)      OP(T, Op86X1) \
+	OP(T, Op87M0)      OP(T, Op88X1)      OP(T, Op89M0)      OP(T, Op8AM0)      OP(T, Op8BE0) \
+	OP(T, Op8CX1)      OP(T, Op8DM0)      OP(T, Op8EX1)      OP(T, Op8FM0)      OP(T, Op90E0) \
+	OP(T, Op91E0M0X1)  OP(T, Op92E0M0)    OP(T, Op93M0)      OP(T, Op94E0X1)    OP(T, Op95E0M0) \
+	OP(T, Op96E0X1)    OP(T, Op97M0)      OP(T, Op98M0)      OP(T, Op99M0X1)    OP(T, Op9A) \
+	OP(T, Op9BX1)      OP(T, Op9CM0)      OP(T, Op9DM0X1)    OP(T, Op9EM0X1)    OP(T, Op9FM0) \
+	OP(T, OpA0X1)      OP(T, OpA1E0M0)    OP(T, OpA2X1)      OP(T, OpA3M0)      OP(T, OpA4X1) \
+	OP(T, OpA5M0)      OP(T, OpA6X1)      OP(T, OpA7M0)      OP(T, OpA8X1)      OP(T, OpA9M0) \
+	OP(T, OpAAX1)      OP(T, OpABE0)      OP(T, OpACX1)      OP(T, OpADM0)      OP(T, OpAEX1) \
+	OP(T, OpAFM0)      OP(T, OpB0E0)      OP(T, OpB1E0M0X1)  OP(T, OpB2E0M0)    OP(T, OpB3M0) \
+	OP(T, OpB4E0X1)    OP(T, OpB5E0M0)    OP(T, OpB6E0X1)    OP(T, OpB7M0)      OP(T, OpB8) \
+	OP(T, OpB9M0X1)    OP(T, OpBAX1)      OP(T, OpBBX1)      OP(T, OpBCX1)      OP(T, OpBDM0X1) \
+	OP(T, OpBEX1)      OP(T, OpBFM0)      OP(T, OpC0X1)      OP(T, OpC1E0M0)    OP(T, OpC2) \
+	OP(T, OpC3M0)      OP(T, OpC4X1)      OP(T, OpC5M0)      OP(T, OpC6M0)      OP(T, OpC7M0) \
+	OP(T, OpC8X1)      OP(T, OpC9M0)      OP(T, OpCAX1)      OP(T, OpCB)        OP(T, OpCCX1) \
+	OP(T, OpCDM0)      OP(T, OpCEM0)      OP(T, OpCFM0)      OP(T, OpD0E0)      OP(T, OpD1E0M0X1) \
+	OP(T, OpD2E0M0)    OP(T, OpD3M0)      OP(T, OpD4E0)      OP(T, OpD5E0M0)    OP(T, OpD6E0M0) \
+	OP(T, OpD7M0)      OP(T, OpD8)        OP(T, OpD9M0X1)    OP(T, OpDAE0X1)    OP(T, OpDB) \
+	OP(T, OpDC)        OP(T, OpDDM0X1)    OP(T, OpDEM0X1)    OP(T, OpDFM0)      OP(T, OpE0X1) \
+	OP(T, OpE1E0M0)    OP(T, OpE2)        OP(T, OpE3M0)      OP(T, OpE4X1)      OP(T, OpE5M0) \
+	OP(T, OpE6M0)      OP(T, OpE7M0)      OP(T, OpE8X1)      OP(T, OpE9M0)      OP(T, OpEA) \
+	OP(T, OpEB)        OP(T, OpECX1)      OP(T, OpEDM0)      OP(T, OpEEM0)      OP(T, OpEFM0) \
+	OP(T, OpF0E0)      OP(T, OpF1E0M0X1)  OP(T, OpF2E0M0)    OP(T, OpF3M0)      OP(T, OpF4E0) \
+	OP(T, OpF5E0M0)    OP(T, OpF6E0M0)    OP(T, OpF7M0)      OP(T, OpF8)        OP(T, OpF9M0X1) \
+	OP(T, OpFAE0X1)    OP(T, OpFB)        OP(T, OpFCE0)      OP(T, OpFDM0X1)    OP(T, OpFEM0X1) \
+	OP(T, OpFFM0)
+
+#define S9X_OPCODES_SLOW(OP, T) \
+	OP(T, Op00)        OP(T, Op01Slow)    OP(T, Op02)        OP(T, Op03Slow)    OP(T, Op04Slow) \
+	OP(T, Op05Slow)    OP(T, Op06Slow)    OP(T, Op07Slow)    OP(T, Op08Slow)    OP(T, Op09Slow) \
+	OP(T, Op0ASlow)    OP(T, Op0BSlow)    OP(T, Op0CSlow)    OP(T, Op0DSlow)    OP(T, Op0ESlow) \
+	OP(T, Op0FSlow)    OP(T, Op10Slow)    OP(T, Op11Slow)    OP(T, Op12Slow)    OP(T, Op13Slow) \
+	OP(T, Op14Slow)    OP(T, Op15Slow)    OP(T, Op16Slow)    OP(T, Op17Slow)    OP(T, Op18) \
+	OP(T, Op19Slow)    OP(T, Op1ASlow)    OP(T, Op1B)        OP(T, Op1CSlow)    OP(T, Op1DSlow) \
+	OP(T, Op1ESlow)    OP(T, Op1FSlow)    OP(T, Op20Slow)    OP(T, Op21Slow)    OP(T, Op22Slow) \
+	OP(T, Op23Slow)    OP(T, Op24Slow)    OP(T, Op25Slow)    OP(T, Op26Slow)    OP(T, Op27Slow) \
+	OP(T, Op28Slow)    OP(T, Op29Slow)    OP(T, Op2ASlow)    OP(T, Op2BSlow)    OP(T, Op2CSlow) \
+	OP(T, Op2DSlow)    OP(T, Op2ESlow)    OP(T, Op2FSlow)    OP(T, Op30Slow)    OP(T, Op31Slow) \
+	OP(T, Op32Slow)    OP(T, Op33Slow)    OP(T, Op34Slow)    OP(T, Op35Slow)    OP(T, Op36Slow) \
+	OP(T, Op37Slow)    OP(T, Op38)        OP(T, Op39Slow)    OP(T, Op3ASlow)    OP(T, Op3B) \
+	OP(T, Op3CSlow)    OP(T, Op3DSlow)    OP(T, Op3ESlow)    OP(T, Op3FSlow)    OP(T, Op40Slow) \
+	OP(T, Op41Slow)    OP(T, Op42)        OP(T, Op43Slow)    OP(T, Op44Slow)    OP(T, Op45Slow) \
+	OP(T, Op46Slow)    OP(T, Op47Slow)    OP(T, Op48Slow)    OP(T, Op49Slow)    OP(T, Op4ASlow) \
+	OP(T, Op4BSlow)    OP(T, Op4CSlow)    OP(T, Op4DSlow)    OP(T, Op4ESlow)    OP(T, Op4FSlow) \
+	OP(T, Op50Slow)    OP(T, Op51Slow)    OP(T, Op52Slow)    OP(T, Op53Slow)    OP(T, Op54Slow) \
+	OP(T, Op55Slow)    OP(T, Op56Slow)    OP(T, Op57Slow)    OP(T, Op58)        OP(T, Op59Slow) \
+	OP(T, Op5ASlow)    OP(T, Op5B)        OP(T, Op5CSlow)    OP(T, Op5DSlow)    OP(T, Op5ESlow) \
+	OP(T, Op5FSlow)    OP(T, Op60Slow)    OP(T, Op61Slow)    OP(T, Op62Slow)    OP(T, Op63Slow) \
+	OP(T, Op64Slow)    OP(T, Op65Slow)    OP(T, Op66Slow)    OP(T, Op67Slow)    OP(T, Op68Slow) \
+	OP(T, Op69Slow)    OP(T, Op6ASlow)    OP(T, Op6BSlow)    OP(T, Op6CSlow)    OP(T, Op6DSlow) \
+	OP(T, Op6ESlow)    OP(T, Op6FSlow)    OP(T, Op70Slow)    OP(T, Op71Slow)    OP(T, Op72Slow) \
+	OP(T, Op73Slow)    OP(T, Op74Slow)    OP(T, Op75Slow)    OP(T, Op76Slow)    OP(T, Op77Slow) \
+	OP(T, Op78)        OP(T, Op79Slow)    OP(T, Op7ASlow)    OP(T, Op7B)        OP(T, Op7CSlow) \
+	OP(T, Op7DSlow)    OP(T, Op7ESlow)    OP(T, Op7FSlow)    OP(T, Op80Slow)    OP(T, Op81Slow) \
+	OP(T, Op82Slow)    OP(T, Op83Slow)    OP(T, Op84Slow)    OP(T, Op85Slow)    OP(T, Op86Slow) \
+	OP(T, Op87Slow)    OP(T, Op88Slow)    OP(T, Op89Slow)    OP(T, Op8ASlow)    OP(T, Op8BSlow) \
+	OP(T, Op8CSlow)    OP(T, Op8DSlow)    OP(T, Op8ESlow)    OP(T, Op8FSlow)    OP(T, Op90Slow) \
+	OP(T, Op91Slow)    OP(T, Op92Slow)    OP(T, Op93Slow)    OP(T, Op94Slow)    OP(T, Op95Slow) \
+	OP(T, Op96Slow)    OP(T, Op97Slow)    OP(T, Op98Slow)    OP(T, Op99Slow)    OP(T, Op9A) \
+	OP(T, Op9BSlow)    OP(T, Op9CSlow)    OP(T, Op9DSlow)    OP(T, Op9ESlow)    OP(T, Op9FSlow) \
+	OP(T, OpA0Slow)    OP(T, OpA1Slow)    OP(T, OpA2Slow)    OP(T, OpA3Slow)    OP(T, OpA4Slow) \
+	OP(T, OpA5Slow)    OP(T, OpA6Slow)    OP(T, OpA7Slow)    OP(T, OpA8Slow)    OP(T, OpA9Slow) \
+	OP(T, OpAASlow)    OP(T, OpABSlow)    OP(T, OpACSlow)    OP(T, OpADSlow)    OP(T, OpAESlow) \
+	OP(T, OpAFSlow)    OP(T, OpB0Slow)    OP(T, OpB1Slow)    OP(T, OpB2Slow)    OP(T, OpB3Slow) \
+	OP(T, OpB4Slow)    OP(T, OpB5Slow)    OP(T, OpB6Slow)    OP(T, OpB7Slow)    OP(T, OpB8) \
+	OP(T, OpB9Slow)    OP(T, OpBASlow)    OP(T, OpBBSlow)    OP(T, OpBCSlow)    OP(T, OpBDSlow) \
+	OP(T, OpBESlow)    OP(T, OpBFSlow)    OP(T, OpC0Slow)    OP(T, OpC1Slow)    OP(T, OpC2Slow) \
+	OP(T, OpC3Slow)    OP(T, OpC4Slow)    OP(T, OpC5Slow)    OP(T, OpC6Slow)    OP(T, OpC7Slow) \
+	OP(T, OpC8Slow)    OP(T, OpC9Slow)    OP(T, OpCASlow)    OP(T, OpCB)        OP(T, OpCCSlow) \
+	OP(T, OpCDSlow)    OP(T, OpCESlow)    OP(T, OpCFSlow)    OP(T, OpD0Slow)    OP(T, OpD1Slow) \
+	OP(T, OpD2Slow)    OP(T, OpD3Slow)    OP(T, OpD4Slow)    OP(T, OpD5Slow)    OP(T, OpD6Slow) \
+	OP(T, OpD7Slow)    OP(T, OpD8)        OP(T, OpD9Slow)    OP(T, OpDASlow)    OP(T, OpDB) \
+	OP(T, OpDCSlow)    OP(T, OpDDSlow)    OP(T, OpDESlow)    OP(T, OpDFSlow)    OP(T, OpE0Slow) \
+	OP(T, OpE1Slow)    OP(T, OpE2Slow)    OP(T, OpE3Slow)    OP(T, OpE4Slow)    OP(T, OpE5Slow) \
+	OP(T, OpE6Slow)    OP(T, OpE7Slow)    OP(T, OpE8Slow)    OP(T, OpE9Slow)    OP(T, OpEA) \
+	OP(T, OpEB)        OP(T, OpECSlow)    OP(T, OpEDSlow)    OP(T, OpEESlow)    OP(T, OpEFSlow) \
+	OP(T, OpF0Slow)    OP(T, OpF1Slow)    OP(T, OpF2Slow)    OP(T, OpF3Slow)    OP(T, OpF4Slow) \
+	OP(T, OpF5Slow)    OP(T, OpF6Slow)    OP(T, OpF7Slow)    OP(T, OpF8)        OP(T, OpF9Slow) \
+	OP(T, OpFASlow)    OP(T, OpFB)        OP(T, OpFCSlow)    OP(T, OpFDSlow)    OP(T, OpFESlow) \
+	OP(T, OpFFSlow)
+
+#define S9X_OPCODE_ENTRY(T, Handler)	{ Handler },
+
 struct SOpcodes S9xOpcodesM1X1[256] =
 {
-	{ Op00 },        { Op01E0M1 },    { Op02 },        { Op03M1 },      { Op04M1 },
-	{ Op05M1 },      { Op06M1 },      { Op07M1 },      { Op08E0 },      { Op09M1 },
-	{ Op0AM1 },      { Op0BE0 },      { Op0CM1 },      { Op0DM1 },      { Op0EM1 },
-	{ Op0FM1 },      { Op10E0 },      { Op11E0M1X1 },  { Op12E0M1 },    { Op13M1 },
-	{ Op14M1 },      { Op15E0M1 },    { Op16E0M1 },    { Op17M1 },      { Op18 },
-	{ Op19M1X1 },    { Op1AM1 },      { Op1B },        { Op1CM1 },      { Op1DM1X1 },
-	{ Op1EM1X1 },    { Op1FM1 },      { Op20E0 },      { Op21E0M1 },    { Op22E0 },
-	{ Op23M1 },      { Op24M1 },      { Op25M1 },      { Op26M1 },      { Op27M1 },
-	{ Op28E0 },      { Op29M1 },      { Op2AM1 },      { Op2BE0 },      { Op2CM1 },
-	{ Op2DM1 },      { Op2EM1 },      { Op2FM1 },      { Op30E0 },      { Op31E0M1X1 },
-	{ Op32E0M1 },    { Op33M1 },      { Op34E0M1 },    { Op35E0M1 },    { Op36E0M1 },
-	{ Op37M1 },      { Op38 },        { Op39M1X1 },    { Op3AM1 },      { Op3B },
-	{ Op3CM1X1 },    { Op3DM1X1 },    { Op3EM1X1 },    { Op3FM1 },      { Op40Slow },
-	{ Op41E0M1 },    { Op42 },        { Op43M1 },      { Op44X1 },      { Op45M1 },
-	{ Op46M1 },      { Op47M1 },      { Op48E0M1 },    { Op49M1 },      { Op4AM1 },
-	{ Op4BE0 },      { Op4C },        { Op4DM1 },      { Op4EM1 },      { Op4FM1 },
-	{ Op50E0 },      { Op51E0M1X1 },  { Op52E0M1 },    { Op53M1 },      { Op54X1 },
-	{ Op55E0M1 },    { Op56E0M1 },    { Op57M1 },      { Op58 },        { Op59M1X1 },
-	{ Op5AE0X1 },    { Op5B },        { Op5C },        { Op5DM1X1 },    { Op5EM1X1 },
-	{ Op5FM1 },      { Op60E0 },      { Op61E0M1 },    { Op62E0 },      { Op63M1 },
-	{ Op64M1 },      { Op65M1 },      { Op66M1 },      { Op67M1 },      { Op68E0M1 },
-	{ Op69M1 },      { Op6AM1 },      { Op6BE0 },      { Op6C },        { Op6DM1 },
-	{ Op6EM1 },      { Op6FM1 },      { Op70E0 },      { Op71E0M1X1 },  { Op72E0M1 },
-	{ Op73M1 },      { Op74E0M1 },    { Op75E0M1 },    { Op76E0M1 },    { Op77M1 },
-	{ Op78 },        { Op79M1X1 },    { Op7AE0X1 },    { Op7B },        { Op7C },
-	{ Op7DM1X1 },    { Op7EM1X1 },    { Op7FM1 },      { Op80E0 },      { Op81E0M1 },
-	{ Op82 },        { Op83M1 },      { Op84X1 },      { Op85M1 },      { Op86X1 },
-	{ Op87M1 },      { Op88X1 },      { Op89M1 },      { Op8AM1 },      { Op8BE0 },
-	{ Op8CX1 },      { Op8DM1 },      { Op8EX1 },      { Op8FM1 },      { Op90E0 },
-	{ Op91E0M1X1 },  { Op92E0M1 },    { Op93M1 },      { Op94E0X1 },    { Op95E0M1 },
-	{ Op96E0X1 },    { Op97M1 },      { Op98M1 },      { Op99M1X1 },    { Op9A },
-	{ Op9BX1 },      { Op9CM1 },      { Op9DM1X1 },    { Op9EM1X1 },    { Op9FM1 },
-	{ OpA0X1 },      { OpA1E0M1 },    { OpA2X1 },      { OpA3M1 },      { OpA4X1 },
-	{ OpA5M1 },      { OpA6X1 },      { OpA7M1 },      { OpA8X1 },      { OpA9M1 },
-	{ OpAAX1 },      { OpABE0 },      { OpACX1 },      { OpADM1 },      { OpAEX1 },
-	{ OpAFM1 },      { OpB0E0 },      { OpB1E0M1X1 },  { OpB2E0M1 },    { OpB3M1 },
-	{ OpB4E0X1 },    { OpB5E0M1 },    { OpB6E0X1 },    { OpB7M1 },      { OpB8 },
-	{ OpB9M1X1 },    { OpBAX1 },      { OpBBX1 },      { OpBCX1 },      { OpBDM1X1 },
-	{ OpBEX1 },      { OpBFM1 },      { OpC0X1 },      { OpC1E0M1 },    { OpC2 },
-	{ OpC3M1 },      { OpC4X1 },      { OpC5M1 },      { OpC6M1 },      { OpC7M1 },
-	{ OpC8X1 },      { OpC9M1 },      { OpCAX1 },      { OpCB },        { OpCCX1 },
-	{ OpCDM1 },      { OpCEM1 },      { OpCFM1 },      { OpD0E0 },      { OpD1E0M1X1 },
-	{ OpD2E0M1 },    { OpD3M1 },      { OpD4E0 },      { OpD5E0M1 },    { OpD6E0M1 },
-	{ OpD7M1 },      { OpD8 },        { OpD9M1X1 },    { OpDAE0X1 },    { OpDB },
-	{ OpDC },        { OpDDM1X1 },    { OpDEM1X1 },    { OpDFM1 },      { OpE0X1 },
-	{ OpE1E0M1 },    { OpE2 },        { OpE3M1 },      { OpE4X1 },      { OpE5M1 },
-	{ OpE6M1 },      { OpE7M1 },      { OpE8X1 },      { OpE9M1 },      { OpEA },
-	{ OpEB },        { OpECX1 },      { OpEDM1 },      { OpEEM1 },      { OpEFM1 },
-	{ OpF0E0 },      { OpF1E0M1X1 },  { OpF2E0M1 },    { OpF3M1 },      { OpF4E0 },
-	{ OpF5E0M1 },    { OpF6E0M1 },    { OpF7M1 },      { OpF8 },        { OpF9M1X1 },
-	{ OpFAE0X1 },    { OpFB },        { OpFCE0 },      { OpFDM1X1 },    { OpFEM1X1 },
-	{ OpFFM1 }
+	S9X_OPCODES_M1X1(S9X_OPCODE_ENTRY, M1X1)
 };
 
 struct SOpcodes S9xOpcodesE1[256] =
 {
-	{ Op00 },        { Op01E1 },      { Op02 },        { Op03M1 },      { Op04M1 },
-	{ Op05M1 },      { Op06M1 },      { Op07M1 },      { Op08E1 },      { Op09M1 },
-	{ Op0AM1 },      { Op0BE1 },      { Op0CM1 },      { Op0DM1 },      { Op0EM1 },
-	{ Op0FM1 },      { Op10E1 },      { Op11E1 },      { Op12E1 },      { Op13M1 },
-	{ Op14M1 },      { Op15E1 },      { Op16E1 },      { Op17M1 },      { Op18 },
-	{ Op19M1X1 },    { Op1AM1 },      { Op1B },        { Op1CM1 },      { Op1DM1X1 },
-	{ Op1EM1X1 },    { Op1FM1 },      { Op20E1 },      { Op21E1 },      { Op22E1 },
-	{ Op23M1 },      { Op24M1 },      { Op25M1 },      { Op26M1 },      { Op27M1 },
-	{ Op28E1 },      { Op29M1 },      { Op2AM1 },      { Op2BE1 },      { Op2CM1 },
-	{ Op2DM1 },      { Op2EM1 },      { Op2FM1 },      { Op30E1 },      { Op31E1 },
-	{ Op32E1 },      { Op33M1 },      { Op34E1 },      { Op35E1 },      { Op36E1 },
-	{ Op37M1 },      { Op38 },        { Op39M1X1 },    { Op3AM1 },      { Op3B },
-	{ Op3CM1X1 },    { Op3DM1X1 },    { Op3EM1X1 },    { Op3FM1 },      { Op40Slow },
-	{ Op41E1 },      { Op42 },        { Op43M1 },      { Op44X1 },      { Op45M1 },
-	{ Op46M1 },      { Op47M1 },      { Op48E1 },      { Op49M1 },      { Op4AM1 },
-	{ Op4BE1 },      { Op4C },        { Op4DM1 },      { Op4EM1 },      { Op4FM1 },
-	{ Op50E1 },      { Op51E1 },      { Op52E1 },      { Op53M1 },      { Op54X1 },
-	{ Op55E1 },      { Op56E1 },      { Op57M1 },      { Op58 },        { Op59M1X1 },
-	{ Op5AE1 },      { Op5B },        { Op5C },        { Op5DM1X1 },    { Op5EM1X1 },
-	{ Op5FM1 },      { Op60E1 },      { Op61E1 },      { Op62E1 },      { Op63M1 },
-	{ Op64M1 },      { Op65M1 },      { Op66M1 },      { Op67M1 },      { Op68E1 },
-	{ Op69M1 },      { Op6AM1 },      { Op6BE1 },      { Op6C },        { Op6DM1 },
-	{ Op6EM1 },      { Op6FM1 },      { Op70E1 },      { Op71E1 },      { Op72E1 },
-	{ Op73M1 },      { Op74E1 },      { Op75E1 },      { Op76E1 },      { Op77M1 },
-	{ Op78 },        { Op79M1X1 },    { Op7AE1 },      { Op7B },        { Op7C },
-	{ Op7DM1X1 },    { Op7EM1X1 },    { Op7FM1 },      { Op80E1 },      { Op81E1 },
-	{ Op82 },        { Op83M1 },      { Op84X1 },      { Op85M1 },      { Op86X1 },
-	{ Op87M1 },      { Op88X1 },      { Op89M1 },      { Op8AM1 },      { Op8BE1 },
-	{ Op8CX1 },      { Op8DM1 },      { Op8EX1 },      { Op8FM1 },      { Op90E1 },
-	{ Op91E1 },      { Op92E1 },      { Op93M1 },      { Op94E1 },      { Op95E1 },
-	{ Op96E1 },      { Op97M1 },      { Op98M1 },      { Op99M1X1 },    { Op9A },
-	{ Op9BX1 },      { Op9CM1 },      { Op9DM1X1 },    { Op9EM1X1 },    { Op9FM1 },
-	{ OpA0X1 },      { OpA1E1 },      { OpA2X1 },      { OpA3M1 },      { OpA4X1 },
-	{ OpA5M1 },      { OpA6X1 },      { OpA7M1 },      { OpA8X1 },      { OpA9M1 },
-	{ OpAAX1 },      { OpABE1 },      { OpACX1 },      { OpADM1 },      { OpAEX1 },
-	{ OpAFM1 },      { OpB0E1 },      { OpB1E1 },      { OpB2E1 },      { OpB3M1 },
-	{ OpB4E1 },      { OpB5E1 },      { OpB6E1 },      { OpB7M1 },      { OpB8 },
-	{ OpB9M1X1 },    { OpBAX1 },      { OpBBX1 },      { OpBCX1 },      { OpBDM1X1 },
-	{ OpBEX1 },      { OpBFM1 },      { OpC0X1 },      { OpC1E1 },      { OpC2 },
-	{ OpC3M1 },      { OpC4X1 },      { OpC5M1 },      { OpC6M1 },      { OpC7M1 },
-	{ OpC8X1 },      { OpC9M1 },      { OpCAX1 },      { OpCB },        { OpCCX1 },
-	{ OpCDM1 },      { OpCEM1 },      { OpCFM1 },      { OpD0E1 },      { OpD1E1 },
-	{ OpD2E1 },      { OpD3M1 },      { OpD4E1 },      { OpD5E1 },      { OpD6E1 },
-	{ OpD7M1 },      { OpD8 },        { OpD9M1X1 },    { OpDAE1 },      { OpDB },
-	{ OpDC },        { OpDDM1X1 },    { OpDEM1X1 },    { OpDFM1 },      { OpE0X1 },
-	{ OpE1E1 },      { OpE2 },        { OpE3M1 },      { OpE4X1 },      { OpE5M1 },
-	{ OpE6M1 },      { OpE7M1 },      { OpE8X1 },      { OpE9M1 },      { OpEA },
-	{ OpEB },        { OpECX1 },      { OpEDM1 },      { OpEEM1 },      { OpEFM1 },
-	{ OpF0E1 },      { OpF1E1 },      { OpF2E1 },      { OpF3M1 },      { OpF4E1 },
-	{ OpF5E1 },      { OpF6E1 },      { OpF7M1 },      { OpF8 },        { OpF9M1X1 },
-	{ OpFAE1 },      { OpFB },        { OpFCE1 },      { OpFDM1X1 },    { OpFEM1X1 },
-	{ OpFFM1 }
+	S9X_OPCODES_E1(S9X_OPCODE_ENTRY, E1)
 };
 
 struct SOpcodes S9xOpcodesM1X0[256] =
 {
-	{ Op00 },        { Op01E0M1 },    { Op02 },        { Op03M1 },      { Op04M1 },
-	{ Op05M1 },      { Op06M1 },      { Op07M1 },      { Op08E0 },      { Op09M1 },
-	{ Op0AM1 },      { Op0BE0 },      { Op0CM1 },      { Op0DM1 },      { Op0EM1 },
-	{ Op0FM1 },      { Op10E0 },      { Op11E0M1X0 },  { Op12E0M1 },    { Op13M1 },
-	{ Op14M1 },      { Op15E0M1 },    { Op16E0M1 },    { Op17M1 },      { Op18 },
-	{ Op19M1X0 },    { Op1AM1 },      { Op1B },        { Op1CM1 },      { Op1DM1X0 },
-	{ Op1EM1X0 },    { Op1FM1 },      { Op20E0 },      { Op21E0M1 },    { Op22E0 },
-	{ Op23M1 },      { Op24M1 },      { Op25M1 },      { Op26M1 },      { Op27M1 },
-	{ Op28E0 },      { Op29M1 },      { Op2AM1 },      { Op2BE0 },      { Op2CM1 },
-	{ Op2DM1 },      { Op2EM1 },      { Op2FM1 },      { Op30E0 },      { Op31E0M1X0 },
-	{ Op32E0M1 },    { Op33M1 },      { Op34E0M1 },    { Op35E0M1 },    { Op36E0M1 },
-	{ Op37M1 },      { Op38 },        { Op39M1X0 },    { Op3AM1 },      { Op3B },
-	{ Op3CM1X0 },    { Op3DM1X0 },    { Op3EM1X0 },    { Op3FM1 },      { Op40Slow },
-	{ Op41E0M1 },    { Op42 },        { Op43M1 },      { Op44X0 },      { Op45M1 },
-	{ Op46M1 },      { Op47M1 },      { Op48E0M1 },    { Op49M1 },      { Op4AM1 },
-	{ Op4BE0 },      { Op4C },        { Op4DM1 },      { Op4EM1 },      { Op4FM1 },
-	{ Op50E0 },      { Op51E0M1X0 },  { Op52E0M1 },    { Op53M1 },      { Op54X0 },
-	{ Op55E0M1 },    { Op56E0M1 },    { Op57M1 },      { Op58 },        { Op59M1X0 },
-	{ Op5AE0X0 },    { Op5B },        { Op5C },        { Op5DM1X0 },    { Op5EM1X0 },
-	{ Op5FM1 },      { Op60E0 },      { Op61E0M1 },    { Op62E0 },      { Op63M1 },
-	{ Op64M1 },      { Op65M1 },      { Op66M1 },      { Op67M1 },      { Op68E0M1 },
-	{ Op69M1 },      { Op6AM1 },      { Op6BE0 },      { Op6C },        { Op6DM1 },
-	{ Op6EM1 },      { Op6FM1 },      { Op70E0 },      { Op71E0M1X0 },  { Op72E0M1 },
-	{ Op73M1 },      { Op74E0M1 },    { Op75E0M1 },    { Op76E0M1 },    { Op77M1 },
-	{ Op78 },        { Op79M1X0 },    { Op7AE0X0 },    { Op7B },        { Op7C },
-	{ Op7DM1X0 },    { Op7EM1X0 },    { Op7FM1 },      { Op80E0 },      { Op81E0M1 },
-	{ Op82 },        { Op83M1 },      { Op84X0 },      { Op85M1 },      { Op86X0 },
-	{ Op87M1 },      { Op88X0 },      { Op89M1 },      { Op8AM1 },      { Op8BE0 },
-	{ Op8CX0 },      { Op8DM1 },      { Op8EX0 },      { Op8FM1 },      { Op90E0 },
-	{ Op91E0M1X0 },  { Op92E0M1 },    { Op93M1 },      { Op94E0X0 },    { Op95E0M1 },
-	{ Op96E0X0 },    { Op97M1 },      { Op98M1 },      { Op99M1X0 },    { Op9A },
-	{ Op9BX0 },      { Op9CM1 },      { Op9DM1X0 },    { Op9EM1X0 },    { Op9FM1 },
-	{ OpA0X0 },      { OpA1E0M1 },    { OpA2X0 },      { OpA3M1 },      { OpA4X0 },
-	{ OpA5M1 },      { OpA6X0 },      { OpA7M1 },      { OpA8X0 },      { OpA9M1 },
-	{ OpAAX0 },      { OpABE0 },      { OpACX0 },      { OpADM1 },      { OpAEX0 },
-	{ OpAFM1 },      { OpB0E0 },      { OpB1E0M1X0 },  { OpB2E0M1 },    { OpB3M1 },
-	{ OpB4E0X0 },    { OpB5E0M1 },    { OpB6E0X0 },    { OpB7M1 },      { OpB8 },
-	{ OpB9M1X0 },    { OpBAX0 },      { OpBBX0 },      { OpBCX0 },      { OpBDM1X0 },
-	{ OpBEX0 },      { OpBFM1 },      { OpC0X0 },      { OpC1E0M1 },    { OpC2 },
-	{ OpC3M1 },      { OpC4X0 },      { OpC5M1 },      { OpC6M1 },      { OpC7M1 },
-	{ OpC8X0 },      { OpC9M1 },      { OpCAX0 },      { OpCB },        { OpCCX0 },
-	{ OpCDM1 },      { OpCEM1 },      { OpCFM1 },      { OpD0E0 },      { OpD1E0M1X0 },
-	{ OpD2E0M1 },    { OpD3M1 },      { OpD4E0 },      { OpD5E0M1 },    { OpD6E0M1 },
-	{ OpD7M1 },      { OpD8 },        { OpD9M1X0 },    { OpDAE0X0 },    { OpDB },
-	{ OpDC },        { OpDDM1X0 },    { OpDEM1X0 },    { OpDFM1 },      { OpE0X0 },
-	{ OpE1E0M1 },    { OpE2 },        { OpE3M1 },      { OpE4X0 },      { OpE5M1 },
-	{ OpE6M1 },      { OpE7M1 },      { OpE8X0 },      { OpE9M1 },      { OpEA },
-	{ OpEB },        { OpECX0 },      { OpEDM1 },      { OpEEM1 },      { OpEFM1 },
-	{ OpF0E0 },      { OpF1E0M1X0 },  { OpF2E0M1 },    { OpF3M1 },      { OpF4E0 },
-	{ OpF5E0M1 },    { OpF6E0M1 },    { OpF7M1 },      { OpF8 },        { OpF9M1X0 },
-	{ OpFAE0X0 },    { OpFB },        { OpFCE0 },      { OpFDM1X0 },    { OpFEM1X0 },
-	{ OpFFM1 }
+	S9X_OPCODES_M1X0(S9X_OPCODE_ENTRY, M1X0)
 };
 
 struct SOpcodes S9xOpcodesM0X0[256] =
 {
-	{ Op00 },        { Op01E0M0 },    { Op02 },        { Op03M0 },      { Op04M0 },
-	{ Op05M0 },      { Op06M0 },      { Op07M0 },      { Op08E0 },      { Op09M0 },
-	{ Op0AM0 },      { Op0BE0 },      { Op0CM0 },      { Op0DM0 },      { Op0EM0 },
-	{ Op0FM0 },      { Op10E0 },      { Op11E0M0X0 },  { Op12E0M0 },    { Op13M0 },
-	{ Op14M0 },      { Op15E0M0 },    { Op16E0M0 },    { Op17M0 },      { Op18 },
-	{ Op19M0X0 },    { Op1AM0 },      { Op1B },        { Op1CM0 },      { Op1DM0X0 },
-	{ Op1EM0X0 },    { Op1FM0 },      { Op20E0 },      { Op21E0M0 },    { Op22E0 },
-	{ Op23M0 },      { Op24M0 },      { Op25M0 },      { Op26M0 },      { Op27M0 },
-	{ Op28E0 },      { Op29M0 },      { Op2AM0 },      { Op2BE0 },      { Op2CM0 },
-	{ Op2DM0 },      { Op2EM0 },      { Op2FM0 },      { Op30E0 },      { Op31E0M0X0 },
-	{ Op32E0M0 },    { Op33M0 },      { Op34E0M0 },    { Op35E0M0 },    { Op36E0M0 },
-	{ Op37M0 },      { Op38 },        { Op39M0X0 },    { Op3AM0 },      { Op3B },
-	{ Op3CM0X0 },    { Op3DM0X0 },    { Op3EM0X0 },    { Op3FM0 },      { Op40Slow },
-	{ Op41E0M0 },    { Op42 },        { Op43M0 },      { Op44X0 },      { Op45M0 },
-	{ Op46M0 },      { Op47M0 },      { Op48E0M0 },    { Op49M0 },      { Op4AM0 },
-	{ Op4BE0 },      { Op4C },        { Op4DM0 },      { Op4EM0 },      { Op4FM0 },
-	{ Op50E0 },      { Op51E0M0X0 },  { Op52E0M0 },    { Op53M0 },      { Op54X0 },
-	{ Op55E0M0 },    { Op56E0M0 },    { Op57M0 },      { Op58 },        { Op59M0X0 },
-	{ Op5AE0X0 },    { Op5B },        { Op5C },        { Op5DM0X0 },    { Op5EM0X0 },
-	{ Op5FM0 },      { Op60E0 },      { Op61E0M0 },    { Op62E0 },      { Op63M0 },
-	{ Op64M0 },      { Op65M0 },      { Op66M0 },      { Op67M0 },      { Op68E0M0 },
-	{ Op69M0 },      { Op6AM0 },      { Op6BE0 },      { Op6C },        { Op6DM0 },
-	{ Op6EM0 },      { Op6FM0 },      { Op70E0 },      { Op71E0M0X0 },  { Op72E0M0 },
-	{ Op73M0 },      { Op74E0M0 },    { Op75E0M0 },    { Op76E0M0 },    { Op77M0 },
-	{ Op78 },        { Op79M0X0 },    { Op7AE0X0 },    { Op7B },        { Op7C },
-	{ Op7DM0X0 },    { Op7EM0X0 },    { Op7FM0 },      { Op80E0 },      { Op81E0M0 },
-	{ Op82 },        { Op83M0 },      { Op84X0 },      { Op85M0 },      { Op86X0 },
-	{ Op87M0 },      { Op88X0 },      { Op89M0 },      { Op8AM0 },      { Op8BE0 },
-	{ Op8CX0 },      { Op8DM0 },      { Op8EX0 },      { Op8FM0 },      { Op90E0 },
-	{ Op91E0M0X0 },  { Op92E0M0 },    { Op93M0 },      { Op94E0X0 },    { Op95E0M0 },
-	{ Op96E0X0 },    { Op97M0 },      { Op98M0 },      { Op99M0X0 },    { Op9A },
-	{ Op9BX0 },      { Op9CM0 },      { Op9DM0X0 },    { Op9EM0X0 },    { Op9FM0 },
-	{ OpA0X0 },      { OpA1E0M0 },    { OpA2X0 },      { OpA3M0 },      { OpA4X0 },
-	{ OpA5M0 },      { OpA6X0 },      { OpA7M0 },      { OpA8X0 },      { OpA9M0 },
-	{ OpAAX0 },      { OpABE0 },      { OpACX0 },      { OpADM0 },      { OpAEX0 },
-	{ OpAFM0 },      { OpB0E0 },      { OpB1E0M0X0 },  { OpB2E0M0 },    { OpB3M0 },
-	{ OpB4E0X0 },    { OpB5E0M0 },    { OpB6E0X0 },    { OpB7M0 },      { OpB8 },
-	{ OpB9M0X0 },    { OpBAX0 },      { OpBBX0 },      { OpBCX0 },      { OpBDM0X0 },
-	{ OpBEX0 },      { OpBFM0 },      { OpC0X0 },      { OpC1E0M0 },    { OpC2 },
-	{ OpC3M0 },      { OpC4X0 },      { OpC5M0 },      { OpC6M0 },      { OpC7M0 },
-	{ OpC8X0 },      { OpC9M0 },      { OpCAX0 },      { OpCB },        { OpCCX0 },
-	{ OpCDM0 },      { OpCEM0 },      { OpCFM0 },      { OpD0E0 },      { OpD1E0M0X0 },
-	{ OpD2E0M0 },    { OpD3M0 },      { OpD4E0 },      { OpD5E0M0 },    { OpD6E0M0 },
-	{ OpD7M0 },      { OpD8 },        { OpD9M0X0 },    { OpDAE0X0 },    { OpDB },
-	{ OpDC },        { OpDDM0X0 },    { OpDEM0X0 },    { OpDFM0 },      { OpE0X0 },
-	{ OpE1E0M0 },    { OpE2 },        { OpE3M0 },      { OpE4X0 },      { OpE5M0 },
-	{ OpE6M0 },      { OpE7M0 },      { OpE8X0 },      { OpE9M0 },      { OpEA },
-	{ OpEB },        { OpECX0 },      { OpEDM0 },      { OpEEM0 },      { OpEFM0 },
-	{ OpF0E0 },      { OpF1E0M0X0 },  { OpF2E0M0 },    { OpF3M0 },      { OpF4E0 },
-	{ OpF5E0M0 },    { OpF6E0M0 },    { OpF7M0 },      { OpF8 },        { OpF9M0X0 },
-	{ OpFAE0X0 },    { OpFB },        { OpFCE0 },      { OpFDM0X0 },    { OpFEM0X0 },
-	{ OpFFM0 }
+	S9X_OPCODES_M0X0(S9X_OPCODE_ENTRY, M0X0)
 };
 
 struct SOpcodes S9xOpcodesM0X1[256] =
 {
-	{ Op00 },        { Op01E0M0 },    { Op02 },        { Op03M0 },      { Op04M0 },
-	{ Op05M0 },      { Op06M0 },      { Op07M0 },      { Op08E0 },      { Op09M0 },
-	{ Op0AM0 },      { Op0BE0 },      { Op0CM0 },      { Op0DM0 },      { Op0EM0 },
-	{ Op0FM0 },      { Op10E0 },      { Op11E0M0X1 },  { Op12E0M0 },    { Op13M0 },
-	{ Op14M0 },      { Op15E0M0 },    { Op16E0M0 },    { Op17M0 },      { Op18 },
-	{ Op19M0X1 },    { Op1AM0 },      { Op1B },        { Op1CM0 },      { Op1DM0X1 },
-	{ Op1EM0X1 },    { Op1FM0 },      { Op20E0 },      { Op21E0M0 },    { Op22E0 },
-	{ Op23M0 },      { Op24M0 },      { Op25M0 },      { Op26M0 },      { Op27M0 },
-	{ Op28E0 },      { Op29M0 },      { Op2AM0 },      { Op2BE0 },      { Op2CM0 },
-	{ Op2DM0 },      { Op2EM0 },      { Op2FM0 },      { Op30E0 },      { Op31E0M0X1 },
-	{ Op32E0M0 },    { Op33M0 },      { Op34E0M0 },    { Op35E0M0 },    { Op36E0M0 },
-	{ Op37M0 },      { Op38 },        { Op39M0X1 },    { Op3AM0 },      { Op3B },
-	{ Op3CM0X1 },    { Op3DM0X1 },    { Op3EM0X1 },    { Op3FM0 },      { Op40Slow },
-	{ Op41E0M0 },    { Op42 },        { Op43M0 },      { Op44X1 },      { Op45M0 },
-	{ Op46M0 },      { Op47M0 },      { Op48E0M0 },    { Op49M0 },      { Op4AM0 },
-	{ Op4BE0 },      { Op4C },        { Op4DM0 },      { Op4EM0 },      { Op4FM0 },
-	{ Op50E0 },      { Op51E0M0X1 },  { Op52E0M0 },    { Op53M0 },      { Op54X1 },
-	{ Op55E0M0 },    { Op56E0M0 },    { Op57M0 },      { Op58 },        { Op59M0X1 },
-	{ Op5AE0X1 },    { Op5B },        { Op5C },        { Op5DM0X1 },    { Op5EM0X1 },
-	{ Op5FM0 },      { Op60E0 },      { Op61E0M0 },    { Op62E0 },      { Op63M0 },
-	{ Op64M0 },      { Op65M0 },      { Op66M0 },      { Op67M0 },      { Op68E0M0 },
-	{ Op69M0 },      { Op6AM0 },      { Op6BE0 },      { Op6C },        { Op6DM0 },
-	{ Op6EM0 },      { Op6FM0 },      { Op70E0 },      { Op71E0M0X1 },  { Op72E0M0 },
-	{ Op73M0 },      { Op74E0M0 },    { Op75E0M0 },    { Op76E0M0 },    { Op77M0 },
-	{ Op78 },        { Op79M0X1 },    { Op7AE0X1 },    { Op7B },        { Op7C },
-	{ Op7DM0X1 },    { Op7EM0X1 },    { Op7FM0 },      { Op80E0 },      { Op81E0M0 },
-	{ Op82 },        { Op83M0 },      { Op84X1 },      { Op85M0 },      { Op86X1 },
-	{ Op87M0 },      { Op88X1 },      { Op89M0 },      { Op8AM0 },      { Op8BE0 },
-	{ Op8CX1 },      { Op8DM0 },      { Op8EX1 },      { Op8FM0 },      { Op90E0 },
-	{ Op91E0M0X1 },  { Op92E0M0 },    { Op93M0 },      { Op94E0X1 },    { Op95E0M0 },
-	{ Op96E0X1 },    { Op97M0 },      { Op98M0 },      { Op99M0X1 },    { Op9A },
-	{ Op9BX1 },      { Op9CM0 },      { Op9DM0X1 },    { Op9EM0X1 },    { Op9FM0 },
-	{ OpA0X1 },      { OpA1E0M0 },    { OpA2X1 },      { OpA3M0 },      { OpA4X1 },
-	{ OpA5M0 },      { OpA6X1 },      { OpA7M0 },      { OpA8X1 },      { OpA9M0 },
-	{ OpAAX1 },      { OpABE0 },      { OpACX1 },      { OpADM0 },      { OpAEX1 },
-	{ OpAFM0 },      { OpB0E0 },      { OpB1E0M0X1 },  { OpB2E0M0 },    { OpB3M0 },
-	{ OpB4E0X1 },    { OpB5E0M0 },    { OpB6E0X1 },    { OpB7M0 },      { OpB8 },
-	{ OpB9M0X1 },    { OpBAX1 },      { OpBBX1 },      { OpBCX1 },      { OpBDM0X1 },
-	{ OpBEX1 },      { OpBFM0 },      { OpC0X1 },      { OpC1E0M0 },    { OpC2 },
-	{ OpC3M0 },      { OpC4X1 },      { OpC5M0 },      { OpC6M0 },      { OpC7M0 },
-	{ OpC8X1 },      { OpC9M0 },      { OpCAX1 },      { OpCB },        { OpCCX1 },
-	{ OpCDM0 },      { OpCEM0 },      { OpCFM0 },      { OpD0E0 },      { OpD1E0M0X1 },
-	{ OpD2E0M0 },    { OpD3M0 },      { OpD4E0 },      { OpD5E0M0 },    { OpD6E0M0 },
-	{ OpD7M0 },      { OpD8 },        { OpD9M0X1 },    { OpDAE0X1 },    { OpDB },
-	{ OpDC },        { OpDDM0X1 },    { OpDEM0X1 },    { OpDFM0 },      { OpE0X1 },
-	{ OpE1E0M0 },    { OpE2 },        { OpE3M0 },      { OpE4X1 },      { OpE5M0 },
-	{ OpE6M0 },      { OpE7M0 },      { OpE8X1 },      { OpE9M0 },      { OpEA },
-	{ OpEB },        { OpECX1 },      { OpEDM0 },      { OpEEM0 },      { OpEFM0 },
-	{ OpF0E0 },      { OpF1E0M0X1 },  { OpF2E0M0 },    { OpF3M0 },      { OpF4E0 },
-	{ OpF5E0M0 },    { OpF6E0M0 },    { OpF7M0 },      { OpF8 },        { OpF9M0X1 },
-	{ OpFAE0X1 },    { OpFB },        { OpFCE0 },      { OpFDM0X1 },    { OpFEM0X1 },
-	{ OpFFM0 }
+	S9X_OPCODES_M0X1(S9X_OPCODE_ENTRY, M0X1)
 };
 
 struct SOpcodes S9xOpcodesSlow[256] =
 {
-	{ Op00 },        { Op01Slow },    { Op02 },        { Op03Slow },    { Op04Slow },
-	{ Op05Slow },    { Op06Slow },    { Op07Slow },    { Op08Slow },    { Op09Slow },
-	{ Op0ASlow },    { Op0BSlow },    { Op0CSlow },    { Op0DSlow },    { Op0ESlow },
-	{ Op0FSlow },    { Op10Slow },    { Op11Slow },    { Op12Slow },    { Op13Slow },
-	{ Op14Slow },    { Op15Slow },    { Op16Slow },    { Op17Slow },    { Op18 },
-	{ Op19Slow },    { Op1ASlow },    { Op1B },        { Op1CSlow },    { Op1DSlow },
-	{ Op1ESlow },    { Op1FSlow },    { Op20Slow },    { Op21Slow },    { Op22Slow },
-	{ Op23Slow },    { Op24Slow },    { Op25Slow },    { Op26Slow },    { Op27Slow },
-	{ Op28Slow },    { Op29Slow },    { Op2ASlow },    { Op2BSlow },    { Op2CSlow },
-	{ Op2DSlow },    { Op2ESlow },    { Op2FSlow },    { Op30Slow },    { Op31Slow },
-	{ Op32Slow },    { Op33Slow },    { Op34Slow },    { Op35Slow },    { Op36Slow },
-	{ Op37Slow },    { Op38 },        { Op39Slow },    { Op3ASlow },    { Op3B },
-	{ Op3CSlow },    { Op3DSlow },    { Op3ESlow },    { Op3FSlow },    { Op40Slow },
-	{ Op41Slow },    { Op42 },        { Op43Slow },    { Op44Slow },    { Op45Slow },
-	{ Op46Slow },    { Op47Slow },    { Op48Slow },    { Op49Slow },    { Op4ASlow },
-	{ Op4BSlow },    { Op4CSlow },    { Op4DSlow },    { Op4ESlow },    { Op4FSlow },
-	{ Op50Slow },    { Op51Slow },    { Op52Slow },    { Op53Slow },    { Op54Slow },
-	{ Op55Slow },    { Op56Slow },    { Op57Slow },    { Op58 },        { Op59Slow },
-	{ Op5ASlow },    { Op5B },        { Op5CSlow },    { Op5DSlow },    { Op5ESlow },
-	{ Op5FSlow },    { Op60Slow },    { Op61Slow },    { Op62Slow },    { Op63Slow },
-	{ Op64Slow },    { Op65Slow },    { Op66Slow },    { Op67Slow },    { Op68Slow },
-	{ Op69Slow },    { Op6ASlow },    { Op6BSlow },    { Op6CSlow },    { Op6DSlow },
-	{ Op6ESlow },    { Op6FSlow },    { Op70Slow },    { Op71Slow },    { Op72Slow },
-	{ Op73Slow },    { Op74Slow },    { Op75Slow },    { Op76Slow },    { Op77Slow },
-	{ Op78 },        { Op79Slow },    { Op7ASlow },    { Op7B },        { Op7CSlow },
-	{ Op7DSlow },    { Op7ESlow },    { Op7FSlow },    { Op80Slow },    { Op81Slow },
-	{ Op82Slow },    { Op83Slow },    { Op84Slow },    { Op85Slow },    { Op86Slow },
-	{ Op87Slow },    { Op88Slow },    { Op89Slow },    { Op8ASlow },    { Op8BSlow },
-	{ Op8CSlow },    { Op8DSlow },    { Op8ESlow },    { Op8FSlow },    { Op90Slow },
-	{ Op91Slow },    { Op92Slow },    { Op93Slow },    { Op94Slow },    { Op95Slow },
-	{ Op96Slow },    { Op97Slow },    { Op98Slow },    { Op99Slow },    { Op9A },
-	{ Op9BSlow },    { Op9CSlow },    { Op9DSlow },    { Op9ESlow },    { Op9FSlow },
-	{ OpA0Slow },    { OpA1Slow },    { OpA2Slow },    { OpA3Slow },    { OpA4Slow },
-	{ OpA5Slow },    { OpA6Slow },    { OpA7Slow },    { OpA8Slow },    { OpA9Slow },
-	{ OpAASlow },    { OpABSlow },    { OpACSlow },    { OpADSlow },    { OpAESlow },
-	{ OpAFSlow },    { OpB0Slow },    { OpB1Slow },    { OpB2Slow },    { OpB3Slow },
-	{ OpB4Slow },    { OpB5Slow },    { OpB6Slow },    { OpB7Slow },    { OpB8 },
-	{ OpB9Slow },    { OpBASlow },    { OpBBSlow },    { OpBCSlow },    { OpBDSlow },
-	{ OpBESlow },    { OpBFSlow },    { OpC0Slow },    { OpC1Slow },    { OpC2Slow },
-	{ OpC3Slow },    { OpC4Slow },    { OpC5Slow },    { OpC6Slow },    { OpC7Slow },
-	{ OpC8Slow },    { OpC9Slow },    { OpCASlow },    { OpCB },        { OpCCSlow },
-	{ OpCDSlow },    { OpCESlow },    { OpCFSlow },    { OpD0Slow },    { OpD1Slow },
-	{ OpD2Slow },    { OpD3Slow },    { OpD4Slow },    { OpD5Slow },    { OpD6Slow },
-	{ OpD7Slow },    { OpD8 },        { OpD9Slow },    { OpDASlow },    { OpDB },
-	{ OpDCSlow },    { OpDDSlow },    { OpDESlow },    { OpDFSlow },    { OpE0Slow },
-	{ OpE1Slow },    { OpE2Slow },    { OpE3Slow },    { OpE4Slow },    { OpE5Slow },
-	{ OpE6Slow },    { OpE7Slow },    { OpE8Slow },    { OpE9Slow },    { OpEA },
-	{ OpEB },        { OpECSlow },    { OpEDSlow },    { OpEESlow },    { OpEFSlow },
-	{ OpF0Slow },    { OpF1Slow },    { OpF2Slow },    { OpF3Slow },    { OpF4Slow },
-	{ OpF5Slow },    { OpF6Slow },    { OpF7Slow },    { OpF8 },        { OpF9Slow },
-	{ OpFASlow },    { OpFB },        { OpFCSlow },    { OpFDSlow },    { OpFESlow },
-	{ OpFFSlow }
+	S9X_OPCODES_SLOW(S9X_OPCODE_ENTRY, Slow)
+};
+
+#if defined(S9X_THREADED_DISPATCH) && !defined(SA1_OPCODES)
+
+#define S9X_OPCODE_LABEL(T, Handler)	&&T##_##Handler,
+#define S9X_OPCODE_LABEL_BODY(T, Handler)	T##_##Handler: Handler(); goto Done;
+
+enum
+{
+	TABLE_E1,
+	TABLE_M1X1,
+	TABLE_M1X0,
+	TABLE_M0X1,
+	TABLE_M0X0,
+	TABLE_SLOW
 };
+
+static inline int S9xOpcodeTableIndex (struct SOpcodes *Opcodes)
+{
+	if (Opcodes == S9xOpcodesSlow)
+		return (TABLE_SLOW);
+	if (Opcodes == S9xOpcodesE1)
+		return (TABLE_E1);
+	if (Opcodes == S9xOpcodesM1X1)
+		return (TABLE_M1X1);
+	if (Opcodes == S9xOpcodesM1X0)
+		return (TABLE_M1X0);
+	if (Opcodes == S9xOpcodesM0X1)
+		return (TABLE_M0X1);
+	return (TABLE_M0X0);
+}
+
+// opcodes after which the code rarely goes on with the next one
+static inline bool8 S9xOpcodeEndsBlock (uint8 Op)
+{
+	switch (Op)
+	{
+		case 0x00: case 0x02: case 0x20: case 0x22: case 0x40: case 0x4c: case 0x5c: case 0x60:
+		case 0x6b: case 0x6c: case 0x7c: case 0x80: case 0x82: case 0xcb: case 0xdb: case 0xdc:
+		case 0xfc:
+			return (TRUE);
+	}
+
+	return (FALSE);
+}
+
+static inline struct SBlock * S9xBlockAt (uint8 *Host)
+{
+	uintptr_t	h = (uintptr_t) Host;
+	return (&ICPU.Blocks[(h ^ (h >> 12)) & (S9X_BLOCK_CACHE_SIZE - 1)]);
+}
+
+// Decodes the run starting at the current PC in the current mode, up to the end of its memory
+// block, a jump or S9X_BLOCK_OPS opcodes. Opcodes that cross the block end are left out, they
+// take the slow path.
+static void S9xDecodeBlock (struct SBlock *Block, const void * const *Labels)
+{
+	uint16	pc = Registers.PCw;
+	int		n = 0;
+
+	Block->Start = CPU.PCBase + pc;
+	Block->Opcodes = ICPU.S9xOpcodes;
+	Block->Generation = ICPU.BlockGeneration;
+
+	while (n < S9X_BLOCK_OPS)
+	{
+		uint8	Op = CPU.PCBase[pc];
+
+		if ((pc & MEMMAP_MASK) + ICPU.S9xOpLengths[Op] >= MEMMAP_BLOCK_SIZE)
+			break;
+
+		Block->Ops[n].Host = CPU.PCBase + pc;
+		Block->Ops[n].Label = Labels[Op];
+		n++;
+
+		if (S9xOpcodeEndsBlock(Op))
+			break;
+
+		pc += ICPU.S9xOpLengths[Op];
+	}
+
+	Block->Ops[n].Host = NULL;
+}
+
+void S9xFlushBlockCache (void)
+{
+	if (++ICPU.BlockGeneration == 0)
+	{
+		memset(ICPU.Blocks, 0, S9X_BLOCK_CACHE_SIZE * sizeof(struct SBlock));
+		ICPU.BlockGeneration = 1;
+	}
+}
+
+// The loop of S9xMainLoop() with the handlers behind computed goto labels, one label table per
+// SOpcodes table, so the compiler can inline them instead of calling through a pointer. Does the
+// same per opcode checks in the same order; the interrupt lines can change in the middle of any
+// opcode (register writes, S9xCheckInterrupts()), so they can't wait for the next event.
+//
+// Code in ROM runs from the block cache, which already knows the opcode, its label and that it
+// doesn't cross into the next memory block; the PC and mode only have to match what was decoded.
+void S9xMainLoopThreaded (void)
+{
+	static const void * const	Labels[6][256] =
+	{
+		{ S9X_OPCODES_E1(S9X_OPCODE_LABEL, E1) },
+		{ S9X_OPCODES_M1X1(S9X_OPCODE_LABEL, M1X1) },
+		{ S9X_OPCODES_M1X0(S9X_OPCODE_LABEL, M1X0) },
+		{ S9X_OPCODES_M0X1(S9X_OPCODE_LABEL, M0X1) },
+		{ S9X_OPCODES_M0X0(S9X_OPCODE_LABEL, M0X0) },
+		{ S9X_OPCODES_SLOW(S9X_OPCODE_LABEL, Slow) }
+	};
+
+	const bool8			sa1 = Settings.SA1;
+	// the BS-X PSRAM can be mapped as ROM and RAM at the same time
+	const bool8			cache = !Settings.BS;
+	struct SOpcodes		*table = NULL;
+	const void * const	*labels = NULL;
+	struct SBlock		*block = NULL;
+	struct SBlockOp		*next = NULL;
+
+	for (;;)
+	{
+		if (CPU.NMILine || CPU.IRQTransition || CPU.IRQExternal || CPU.IRQExternalPending)
+			S9xDoInterruptLines();
+
+		if (CPU.Flags & SCAN_KEYS_FLAG)
+			return;
+
+		uint8			Op;
+		struct SOpcodes	*Opcodes;
+
+		if (CPU.PCBase)
+		{
+			uint8	*host = CPU.PCBase + Registers.PCw;
+
+			if (!next || next->Host != host || block->Opcodes != ICPU.S9xOpcodes || block->Generation != ICPU.BlockGeneration)
+			{
+				next = NULL;
+
+				if (cache && Memory.BlockIsROM[(ICPU.ShiftedPB + Registers.PCw) >> MEMMAP_SHIFT])
+				{
+					block = S9xBlockAt(host);
+					if (block->Start != host || block->Opcodes != ICPU.S9xOpcodes || block->Generation != ICPU.BlockGeneration)
+						S9xDecodeBlock(block, Labels[S9xOpcodeTableIndex(ICPU.S9xOpcodes)]);
+
+					if (block->Ops[0].Host)
+						next = block->Ops;
+				}
+			}
+
+			CPU.PrevCycles = CPU.Cycles;
+			CPU.Cycles += CPU.MemSpeed;
+
+			// all S9xCheckInterrupts() does without a timer
+			if (PPU.HTimerEnabled || PPU.VTimerEnabled)
+				S9xCheckInterrupts();
+			else
+				CPU.IRQLastState = FALSE;
+
+			if (next)
+			{
+				const void	*label = next->Label;
+
+				next++;
+				Registers.PCw++;
+				S9X_PROFILE_OPCODE();
+				goto *label;
+			}
+
+			Op = *host;
+			Opcodes = ICPU.S9xOpcodes;
+		}
+		else
+		{
+			Op = S9xGetByte(Registers.PBPC);
+			OpenBus = Op;
+			Opcodes = S9xOpcodesSlow;
+		}
+
+		if ((Registers.PCw & MEMMAP_MASK) + ICPU.S9xOpLengths[Op] >= MEMMAP_BLOCK_SIZE)
+		{
+			uint8	*oldPCBase = CPU.PCBase;
+
+			CPU.PCBase = S9xGetBasePointer(ICPU.ShiftedPB + ((uint16) (Registers.PCw + 4)));
+			if (oldPCBase != CPU.PCBase || (Registers.PCw & ~MEMMAP_MASK) == (0xffff & ~MEMMAP_MASK))
+				Opcodes = S9xOpcodesSlow;
+		}
+
+		Registers.PCw++;
+		S9X_PROFILE_OPCODE();
+
+		// the table only changes with the mode flags and on the slow path
+		if (Opcodes != table)
+		{
+			table = Opcodes;
+			labels = Labels[S9xOpcodeTableIndex(table)];
+		}
+
+		goto *labels[Op];
+
+		S9X_OPCODES_E1(S9X_OPCODE_LABEL_BODY, E1)
+		S9X_OPCODES_M1X1(S9X_OPCODE_LABEL_BODY, M1X1)
+		S9X_OPCODES_M1X0(S9X_OPCODE_LABEL_BODY, M1X0)
+		S9X_OPCODES_M0X1(S9X_OPCODE_LABEL_BODY, M0X1)
+		S9X_OPCODES_M0X0(S9X_OPCODE_LABEL_BODY, M0X0)
+		S9X_OPCODES_SLOW(S9X_OPCODE_LABEL_BODY, Slow)
+
+	Done:
+		if (sa1)
+			S9xSA1Step();
+	}
+}
+
+#endif
@@ -0,0 +1,254 @@
+/***********************************************************************************
+  Snes9x - Portable Super Nintendo Entertainment System (TM) emulator.
+
+  (c) Copyright 1996 - 2002  Gary Henderson (gary.henderson@ntlworld.com),
+                             Jerremy Koot (jkoot@snes9x.com)
+
+  (c) Copyright 2002 - 2004  Matthew Kendora
+
+  (c) Copyright 2002 - 2005  Peter Bortas (peter@bortas.org)
+
+  (c) Copyright 2004 - 2005  Joel Yliluoma (http://iki.fi/bisqwit/)
+
+  (c) Copyright 2001 - 2006  John Weidman (jweidman@slip.net)
+
+  (c) Copyright 2002 - 2006  funkyass (funkyass@spam.shaw.ca),
+                             Kris Bleakley (codeviolation@hotmail.com)
+
+  (c) Copyright 2002 - 2010  Brad Jorsch (anomie@users.sourceforge.net),
+                             Nach (n-a-c-h@users.sourceforge.net),
+
+  (c) Copyright 2002 - 2011  zones (kasumitokoduck@yahoo.com)
+
+  (c) Copyright 2006 - 2007  nitsuja
+
+  (c) Copyright 2009 - 2011  BearOso,
+                             OV2
+
+
+  BS-X C emulator code
+  (c) Copyright 2005 - 2006  Dreamer Nom,
+                             zones
+
+  C4 x86 assembler and some C emulation code
+  (c) Copyright 2000 - 2003  _Demo_ (_demo_@zsnes.com),
+                             Nach,
+                             zsKnight (zsknight@zsnes.com)
+
+  C4 C++ code
+  (c) Copyright 2003 - 2006  Brad Jorsch,
+                             Nach
+
+  DSP-1 emulator code
+  (c) Copyright 1998 - 2006  _Demo_,
+                             Andreas Naive (andreasnaive@gmail.com),
+                             Gary Henderson,
+                             Ivar (ivar@snes9x.com),
+                             John Weidman,
+                             Kris Bleakley,
+                             Matthew Kendora,
+                             Nach,
+                             neviksti (neviksti@hotmail.com)
+
+  DSP-2 emulator code
+  (c) Copyright 2003         John Weidman,
+                             Kris Bleakley,
+                             Lord Nightmare (lord_nightmare@users.sourceforge.net),
+                             Matthew Kendora,
+                             neviksti
+
+  DSP-3 emulator code
+  (c) Copyright 2003 - 2006  John Weidman,
+                             Kris Bleakley,
+                             Lancer,
+                             z80 gaiden
+
+  DSP-4 emulator code
+  (c) Copyright 2004 - 2006  Dreamer Nom,
+                             John Weidman,
+                             Kris Bleakley,
+                             Nach,
+                             z80 gaiden
+
+  OBC1 emulator code
+  (c) Copyright 2001 - 2004  zsKnight,
+                             pagefault (pagefault@zsnes.com),
+                             Kris Bleakley
+                             Ported from x86 assembler to C by sanmaiwashi
+
+  SPC7110 and RTC C++ emulator code used in 1.39-1.51
+  (c) Copyright 2002         Matthew Kendora with research by
+                             zsKnight,
+                             John Weidman,
+                             Dark Force
+
+  SPC7110 and RTC C++ emulator code used in 1.52+
+  (c) Copyright 2009         byuu,
+                             neviksti
+
+  S-DD1 C emulator code
+  (c) Copyright 2003         Brad Jorsch with research by
+                             Andreas Naive,
+                             John Weidman
+
+  S-RTC C emulator code
+  (c) Copyright 2001 - 2006  byuu,
+                             John Weidman
+
+  ST010 C++ emulator code
+  (c) Copyright 2003         Feather,
+                             John Weidman,
+                             Kris Bleakley,
+                             Matthew Kendora
+
+  Super FX x86 assembler emulator code
+  (c) Copyright 1998 - 2003  _Demo_,
+                             pagefault,
+                             zsKnight
+
+  Super FX C emulator code
+  (c) Copyright 1997 - 1999  Ivar,
+                             Gary Henderson,
+                             John Weidman
+
+  Sound emulator code used in 1.5-1.51
+  (c) Copyright 1998 - 2003  Brad Martin
+  (c) Copyright 1998 - 2006  Charles Bilyue'
+
+  Sound emulator code used in 1.52+
+  (c) Copyright 2004 - 2007  Shay Green (gblargg@gmail.com)
+
+  SH assembler code partly based on x86 assembler code
+  (c) Copyright 2002 - 2004  Marcus Comstedt (marcus@mc.pp.se)
+
+  2xSaI filter
+  (c) Copyright 1999 - 2001  Derek Liauw Kie Fa
+
+  HQ2x, HQ3x, HQ4x filters
+  (c) Copyright 2003         Maxim Stepin (maxim@hiend3d.com)
+
+  NTSC filter
+  (c) Copyright 2006 - 2007  Shay Green
+
+  GTK+ GUI code
+  (c) Copyright 2004 - 2011  BearOso
+
+  Win32 GUI code
+  (c) Copyright 2003 - 2006  blip,
+                             funkyass,
+                             Matthew Kendora,
+                             Nach,
+                             nitsuja
+  (c) Copyright 2009 - 2011  OV2
+
+  Mac OS GUI code
+  (c) Copyright 1998 - 2001  John Stiles
+  (c) Copyright 2001 - 2011  zones
+
+
+  Specific ports contains the works of other authors. See headers in
+  individual files.
+
+
+  Snes9x homepage: http://www.snes9x.com/
+
+  Permission to use, copy, modify and/or distribute Snes9x in both binary
+  and source form, for non-commercial purposes, is hereby granted without
+  fee, providing that this license information and copyright notice appear
+  with all copies and any derived work.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event shall the authors be held liable for any damages
+  arising from the use of this software or it's derivatives.
+
+  Snes9x is freeware for PERSONAL USE only. Commercial users should
+  seek permission of the copyright holders first. Commercial use includes,
+  but is not limited to, charging money for Snes9x or software derived from
+  Snes9x, including Snes9x or derivatives in commercial game bundles, and/or
+  using Snes9x as a promotion for your commercial product.
+
+  The copyright holders request that bug fixes and improvements to the code
+  should be forwarded to them so everyone can benefit from the modifications
+  in future versions.
+
+  Super NES and Super Nintendo Entertainment System are trademarks of
+  Nintendo Co., Limited and its subsidiary companies.
+ ***********************************************************************************/
+
+
+#ifndef _DIRTY_H_
+#define _DIRTY_H_
+
+// Page-granular dirty bitmaps, set on the write paths of the CPU, SA-1, PPU ports and SPC700.
+// Meant for consumers that only want to look at what changed since they last cleared a region,
+// like incremental snapshots or SRAM autosave. Resetting the console or loading a snapshot marks
+// everything dirty. Writes by the SuperFX to its RAM (Memory.SRAM) are not tracked. Define
+// S9X_NO_DIRTY_PAGES to compile the tracking out.
+
+enum
+{
+	S9X_DIRTY_WRAM,				// Memory.RAM
+	S9X_DIRTY_VRAM,				// Memory.VRAM
+	S9X_DIRTY_OAM,				// PPU.OAMData
+	S9X_DIRTY_CGRAM,			// PPU.CGDATA, two bytes per colour
+	S9X_DIRTY_SRAM,				// Memory.SRAM, also holding the SA-1 BW-RAM
+	S9X_DIRTY_SPCRAM,			// the 64 KB of APU RAM
+	S9X_DIRTY_REGION_COUNT
+};
+
+#define S9X_DIRTY_PAGE_SHIFT	8
+#define S9X_DIRTY_PAGE_SIZE		(1 << S9X_DIRTY_PAGE_SHIFT)
+#define S9X_DIRTY_MAX_PAGES		512
+#define S9X_DIRTY_WORDS			(S9X_DIRTY_MAX_PAGES / 64)
+
+struct SDirtyPages
+{
+	uint64	Bits[S9X_DIRTY_REGION_COUNT][S9X_DIRTY_WORDS];
+};
+
+extern S9X_TLS struct SDirtyPages	DirtyPages;
+
+// amount of pages in a region
+uint32 S9xGetDirtyPageCount (int);
+// copies the bitmap of a region (page n is bit n % 64 of word n / 64); returns the amount of dirty pages
+uint32 S9xGetDirtyPages (int, uint64 *);
+void S9xClearDirtyPages (int);
+void S9xMarkAllPagesDirty (void);
+
+#ifndef S9X_NO_DIRTY_PAGES
+
+static inline void S9xMarkDirty (int region, uint32 offset)
+{
+	uint32	page = offset >> S9X_DIRTY_PAGE_SHIFT;
+
+	DirtyPages.Bits[region][(page >> 6) & (S9X_DIRTY_WORDS - 1)] |= (uint64) 1 << (page & 63);
+}
+
+static inline void S9xMarkDirtyRange (int region, uint32 offset, uint32 length)
+{
+	for (uint32 page = offset >> S9X_DIRTY_PAGE_SHIFT; page <= (offset + length - 1) >> S9X_DIRTY_PAGE_SHIFT; page++)
+		DirtyPages.Bits[region][(page >> 6) & (S9X_DIRTY_WORDS - 1)] |= (uint64) 1 << (page & 63);
+}
+
+// for writes through the memory maps, which may point into WRAM or SRAM
+#define S9xMarkDirtyPointer(ptr) \
+{ \
+	if ((uint64) ((ptr) - Memory.RAM) < 0x20000) \
+		S9xMarkDirty(S9X_DIRTY_WRAM, (ptr) - Memory.RAM); \
+	else if ((uint64) ((ptr) - Memory.SRAM) < 0x20000) \
+		S9xMarkDirty(S9X_DIRTY_SRAM, (ptr) - Memory.SRAM); \
+}
+
+#define S9X_DIRTY(region, offset)	S9xMarkDirty(region, offset)
+#define S9X_DIRTY_RANGE(region, offset, length)	S9xMarkDirtyRange(region, offset, length)
+#define S9X_DIRTY_POINTER(ptr)		S9xMarkDirtyPointer(ptr)
+
+#else
+
+#define S9X_DIRTY(region, offset)	((void) 0)
+#define S9X_DIRTY_RANGE(region, offset, length)	((void) 0)
+#define S9X_DIRTY_POINTER(ptr)
+
+#endif
+
+#endif
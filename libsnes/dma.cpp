@@ -182,20 +182,30 @@
 #include "apu/apu.h"
 #include "sdd1emu.h"
 #include "spc7110emu.h"
+#include "fxemu.h"
+#include "profiler.h"
 #ifdef DEBUGGER
 #include "missing.h"
 #endif
 
 #define ADD_CYCLES(n)	{ CPU.PrevCycles = CPU.Cycles; CPU.Cycles += (n); S9xCheckInterrupts(); }
 
-extern uint8	*HDMAMemPointers[8];
+extern S9X_TLS uint8	*HDMAMemPointers[8];
 extern int		HDMA_ModeByteCounts[8];
-extern SPC7110	s7emu;
+extern S9X_TLS_CLASS SPC7110	s7emu;
 
-static uint8	sdd1_decode_buffer[0x10000];
+static S9X_TLS uint8	sdd1_decode_buffer[0x10000];
 
 static inline bool8 addCyclesInDMA (uint8);
 static inline bool8 HDMAReadLineCount (int);
+static inline bool8 isBulkDMA (SDMA *);
+static inline int32 getEventFreeBytesInDMA (void);
+static inline void addBulkCyclesInDMA (int32);
+static void bulkDMAToVRAM (uint8 *, uint16, int32, int32, int32);
+static void bulkDMAToWRAM (uint8 *, uint16, int32, int32);
+static uint8 * getHDMAProgramByte (uint32, struct SHDMAProgram *);
+static void decodeHDMAProgram (int);
+static void updateHDMAWatch (void);
 
 
 static inline bool8 addCyclesInDMA (uint8 dma_channel)
@@ -221,14 +231,134 @@ static inline bool8 addCyclesInDMA (uint8 dma_channel)
 	return (TRUE);
 }
 
+// Destinations the bulk path below can fill with whole runs of bytes: OAM, CGRAM and WRAM
+// through their data ports, and VRAM through $2118/$2119 with the linear address translation.
+static inline bool8 isBulkDMA (SDMA *d)
+{
+	switch (d->BAddress)
+	{
+		case 0x04: // OAMDATA
+		case 0x22: // CGDATA
+		case 0x80: // WMDATA
+			return (d->TransferMode == 0 || d->TransferMode == 2 || d->TransferMode == 6);
+
+		case 0x18: // VMDATAL
+			return ((d->TransferMode == 1 || d->TransferMode == 5) && !PPU.VMA.FullGraphicCount);
+	}
+
+	return (FALSE);
+}
+
+// Bytes that can be moved before addCyclesInDMA() has to do more than adding cycles,
+// i.e. before the next event, the end of the line or the H-IRQ position.
+static inline int32 getEventFreeBytesInDMA (void)
+{
+	if (PPU.VTimerEnabled || CPU.HDMARanInDMA)
+		return (0);
+
+	int32	end = CPU.NextEvent < Timings.H_Max ? CPU.NextEvent : Timings.H_Max;
+
+	if (PPU.HTimerEnabled && CPU.Cycles < PPU.HTimerPosition && PPU.HTimerPosition < end)
+		end = PPU.HTimerPosition;
+
+	if (CPU.Cycles >= end)
+		return (0);
+
+	return ((end - 1 - CPU.Cycles) / SLOW_ONE_CYCLE);
+}
+
+// the same as that many addCyclesInDMA() without an event or IRQ in between
+static inline void addBulkCyclesInDMA (int32 n)
+{
+	CPU.PrevCycles = CPU.Cycles + (n - 1) * SLOW_ONE_CYCLE;
+	CPU.Cycles += n * SLOW_ONE_CYCLE;
+	CPU.IRQLastState = FALSE;
+}
+
+// n bytes for alternating $2118/$2119 starting with $2119 if b is set, like REGISTER_2118_linear()
+// and REGISTER_2119_linear() incrementing after the high byte
+static void bulkDMAToVRAM (uint8 *base, uint16 p, int32 inc, int32 n, int32 b)
+{
+	if (inc == 1 && PPU.VMA.Increment == 1 && !b && !(n & 1))
+	{
+		uint32	address = (PPU.VMA.Address << 1) & 0xffff;
+		uint8	*src = base + p;
+
+		PPU.VMA.Address += n >> 1;
+
+		while (n)
+		{
+			int32	len = 0x10000 - address < (uint32) n ? 0x10000 - address : n;
+
+			memcpy(Memory.VRAM + address, src, len);
+			S9X_DIRTY_RANGE(S9X_DIRTY_VRAM, address, len);
+
+			for (uint32 a = address; a < address + len; a = (a | 15) + 1)
+				IPPU.VRAMGeneration[a >> 4] += ((a | 15) + 1 < address + len ? (a | 15) + 1 : address + len) - a;
+
+			src += len;
+			n -= len;
+			address = 0;
+		}
+
+		return;
+	}
+
+	for (; n; n--, p += inc)
+	{
+		uint32	address = ((PPU.VMA.Address << 1) + b) & 0xffff;
+
+		Memory.VRAM[address] = *(base + p);
+		S9X_DIRTY(S9X_DIRTY_VRAM, address);
+		IPPU.VRAMGeneration[address >> 4]++;
+
+		if (b)
+			PPU.VMA.Address += PPU.VMA.Increment;
+		b ^= 1;
+	}
+}
+
+static void bulkDMAToWRAM (uint8 *base, uint16 p, int32 inc, int32 n)
+{
+	if (inc != 1)
+	{
+		for (; n; n--, p += inc)
+			REGISTER_2180(*(base + p));
+
+		return;
+	}
+
+	while (n)
+	{
+		int32	len = 0x20000 - PPU.WRAM < (uint32) n ? 0x20000 - PPU.WRAM : n;
+
+		memcpy(Memory.RAM + PPU.WRAM, base + p, len);
+		S9X_DIRTY_RANGE(S9X_DIRTY_WRAM, PPU.WRAM, len);
+		if (PPU.WRAM < HDMAWatch.Low + HDMAWatch.Size && PPU.WRAM + len > HDMAWatch.Low)
+			S9xHDMAWatchWrite(PPU.WRAM, len);
+
+		PPU.WRAM = (PPU.WRAM + len) & 0x1ffff;
+		p += len;
+		n -= len;
+	}
+}
+
 bool8 S9xDoDMA (uint8 Channel)
 {
+	// the transfer may go to or come from what the SA-1 works on
+	S9xSA1Sync();
+
+	S9X_PROFILE(S9X_PROFILE_DMA);
+
 	CPU.InDMA = TRUE;
     CPU.InDMAorHDMA = TRUE;
 	CPU.CurrentDMAorHDMAChannel = Channel;
 
     SDMA	*d = &DMA[Channel];
 
+	// the transfer counts down the indirect address of HDMA
+	S9xDropHDMAProgram(Channel);
+
 	// Check invalid DMA first
 	if ((d->ABank == 0x7E || d->ABank == 0x7F) && d->BAddress == 0x80 && !d->ReverseTransfer)
 	{
@@ -725,6 +855,85 @@ bool8 S9xDoDMA (uint8 Channel)
 			#endif
 			}
 			else
+			if (isBulkDMA(d))
+			{
+				// DMA BULK PATH
+				// Whatever fits before the next event is written at once, then one byte goes the
+				// regular way to run the event, which may also have changed the destination.
+				while (count > 0)
+				{
+					int32	n = getEventFreeBytesInDMA();
+					if (n > count)
+						n = count;
+
+					if (d->BAddress == 0x18 && (!PPU.VMA.High || (!PPU.ForcedBlanking && CPU.V_Counter < PPU.ScreenHeight + FIRST_VISIBLE_LINE)))
+						n = 0;
+
+					if (n > 0)
+					{
+						switch (d->BAddress)
+						{
+							case 0x04: // OAMDATA
+								for (int32 i = 0; i < n; i++)
+									REGISTER_2104(*(base + (uint16) (p + i * inc)));
+								break;
+
+							case 0x22: // CGDATA
+								for (int32 i = 0; i < n; i++)
+									REGISTER_2122(*(base + (uint16) (p + i * inc)));
+								break;
+
+							case 0x80: // WMDATA
+								if (!CPU.InWRAMDMAorHDMA)
+									bulkDMAToWRAM(base, p, inc, n);
+								break;
+
+							case 0x18: // VMDATAL
+								bulkDMAToVRAM(base, p, inc, n, b);
+								b ^= n & 1;
+								break;
+						}
+
+						d->TransferBytes -= n;
+						d->AAddress += inc * n;
+						p += inc * n;
+						addBulkCyclesInDMA(n);
+
+						if ((count -= n) == 0)
+							break;
+					}
+
+					Work = *(base + p);
+
+					switch (d->BAddress)
+					{
+						case 0x04: // OAMDATA
+							REGISTER_2104(Work);
+							break;
+
+						case 0x22: // CGDATA
+							REGISTER_2122(Work);
+							break;
+
+						case 0x80: // WMDATA
+							if (!CPU.InWRAMDMAorHDMA)
+								REGISTER_2180(Work);
+							break;
+
+						case 0x18: // VMDATAL
+							if (b)
+								REGISTER_2119_linear(Work);
+							else
+								REGISTER_2118_linear(Work);
+							b ^= 1;
+							break;
+					}
+
+					UPDATE_COUNTERS;
+					count--;
+				}
+			}
+			else
 			{
 				// DMA FAST PATH
 				if (d->TransferMode == 0 || d->TransferMode == 2 || d->TransferMode == 6)
@@ -1363,6 +1572,224 @@ static inline bool8 HDMAReadLineCount (int d)
 	return (TRUE);
 }
 
+// host pointer of a byte read by an HDMA program, NULL unless it's in ROM or WRAM
+static uint8 * getHDMAProgramByte (uint32 address, struct SHDMAProgram *prog)
+{
+	int		block = (address & 0xffffff) >> MEMMAP_SHIFT;
+	uint8	*ptr = Memory.Map[block];
+
+	if (ptr < (uint8 *) CMemory::MAP_LAST)
+		return (NULL);
+
+	ptr += address & 0xffff;
+
+	if ((uint64) (ptr - Memory.RAM) < 0x20000)
+	{
+		uint32	offset = ptr - Memory.RAM;
+
+		if (!prog->WatchSize)
+		{
+			prog->WatchLow = offset;
+			prog->WatchSize = 1;
+		}
+		else
+		if (offset < prog->WatchLow)
+		{
+			prog->WatchSize += prog->WatchLow - offset;
+			prog->WatchLow = offset;
+		}
+		else
+		if (offset >= prog->WatchLow + prog->WatchSize)
+			prog->WatchSize = offset - prog->WatchLow + 1;
+
+		return (ptr);
+	}
+
+	return (Memory.BlockIsROM[block] ? ptr : NULL);
+}
+
+// Walks the table of a channel just started by S9xStartHDMA() the way S9xDoHDMA() will, line by
+// line until it ends or the program is full. Gives up on anything the program can't replay as is.
+static void decodeHDMAProgram (int d)
+{
+	static const uint8	offsets[8][4] =
+	{
+		{ 0, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 0, 0 }, { 0, 0, 1, 1 },
+		{ 0, 1, 2, 3 }, { 0, 1, 0, 1 }, { 0, 0, 0, 0 }, { 0, 0, 1, 1 }
+	};
+
+	struct SDMA			*p = &DMA[d];
+	struct SHDMAProgram	*prog = &HDMAPrograms[d];
+	int					count = HDMA_ModeByteCounts[p->TransferMode];
+
+	prog->Valid = FALSE;
+	prog->WatchSize = 0;
+
+	if (prog->Dropped)
+	{
+		prog->Dropped = FALSE;
+		return;
+	}
+
+	// the mappers switch ROM banks in the middle of a frame, BS-X switches ROM to writable
+	if (Settings.SA1 || Settings.SDD1 || Settings.SPC7110 || Settings.BS)
+		return;
+
+#ifdef DEBUGGER
+	if (Settings.TraceHDMA)
+		return;
+#endif
+
+	// WMDATA and WMADD depend on where the bytes come from
+	if (p->ReverseTransfer || p->BAddress + 3 > 0xff || (p->BAddress + 3 >= 0x80 && p->BAddress <= 0x83))
+		return;
+
+	if (p->BAddress == 0x04 && SNESGameFixes.Uniracers)
+		return;
+
+	for (int i = 0; i < 4; i++)
+		prog->Registers[i] = p->BAddress + offsets[p->TransferMode][i];
+
+	uint32	bank = p->ABank << 16;
+	uint32	source = p->HDMAIndirectAddressing ? p->IndirectBank << 16 : bank;
+	uint16	address = p->Address;
+	uint16	indirect = p->IndirectAddress;
+	uint8	lineCount = p->LineCount;
+	uint8	repeat = p->Repeat;
+	uint8	doTransfer = p->DoTransfer;
+	uint8	*ptr;
+	int32	s;
+
+	for (s = 0; s < S9X_HDMA_MAX_STEPS; s++)
+	{
+		struct SHDMAStep	*step = &prog->Step[s];
+
+		step->Transfer = doTransfer;
+		step->Reload = 0;
+
+		if (doTransfer)
+		{
+			uint16	a = p->HDMAIndirectAddressing ? indirect : address;
+
+			for (int i = 0; i < count; i++)
+			{
+				if (!(ptr = getHDMAProgramByte(source + (uint16) (a + i), prog)))
+					return;
+
+				step->Values[i] = *ptr;
+			}
+
+			if (p->HDMAIndirectAddressing)
+				indirect += count;
+			else
+				address += count;
+		}
+
+		doTransfer = !repeat;
+
+		if (!--lineCount)
+		{
+			if (!(ptr = getHDMAProgramByte(bank + address, prog)))
+				return;
+
+			uint8	line = *ptr;
+
+			// the end of the table depends on the other channels, S9xDoHDMA() reads it itself
+			if (!line)
+			{
+				step->Reload = 2;
+				step->Repeat = repeat;
+				step->DoTransfer = doTransfer;
+				step->LineCount = lineCount;
+				step->Address = address;
+				step->IndirectAddress = indirect;
+				s++;
+				break;
+			}
+
+			if (line == 0x80)
+			{
+				repeat = TRUE;
+				lineCount = 128;
+			}
+			else
+			{
+				repeat = !(line & 0x80);
+				lineCount = line & 0x7f;
+			}
+
+			address++;
+			doTransfer = TRUE;
+			step->Reload = 1;
+
+			if (p->HDMAIndirectAddressing)
+			{
+				uint8	*high;
+
+				// S9xGetWord() without wrapping
+				if (!(ptr = getHDMAProgramByte(bank + address, prog)) || !(high = getHDMAProgramByte((bank + address + 1) & 0xffffff, prog)))
+					return;
+
+				indirect = *ptr | (*high << 8);
+				address += 2;
+			}
+		}
+
+		step->Repeat = repeat;
+		step->DoTransfer = doTransfer;
+		step->LineCount = lineCount;
+		step->Address = address;
+		step->IndirectAddress = indirect;
+	}
+
+	prog->Steps = s;
+	prog->Next = 0;
+	prog->Valid = TRUE;
+}
+
+static void updateHDMAWatch (void)
+{
+	uint32	low = 0, high = 0;
+
+	for (int d = 0; d < 8; d++)
+	{
+		struct SHDMAProgram	*prog = &HDMAPrograms[d];
+
+		if (!prog->Valid || !prog->WatchSize)
+			continue;
+
+		if (high == 0 || prog->WatchLow < low)
+			low = prog->WatchLow;
+		if (prog->WatchLow + prog->WatchSize > high)
+			high = prog->WatchLow + prog->WatchSize;
+	}
+
+	HDMAWatch.Low = low;
+	HDMAWatch.Size = high - low;
+}
+
+void S9xInvalidateHDMAPrograms (void)
+{
+	for (int d = 0; d < 8; d++)
+		HDMAPrograms[d].Valid = FALSE;
+
+	HDMAWatch.Low = HDMAWatch.Size = 0;
+}
+
+// length bytes of WRAM at offset were written, somewhere inside the watched range
+void S9xHDMAWatchWrite (uint32 offset, uint32 length)
+{
+	for (int d = 0; d < 8; d++)
+	{
+		struct SHDMAProgram	*prog = &HDMAPrograms[d];
+
+		if (prog->Valid && offset < prog->WatchLow + prog->WatchSize && offset + length > prog->WatchLow)
+			S9xDropHDMAProgram(d);
+	}
+
+	updateHDMAWatch();
+}
+
 void S9xStartHDMA (void)
 {
 	PPU.HDMA = Memory.FillRAM[0x420c];
@@ -1395,12 +1822,20 @@ void S9xStartHDMA (void)
 			{
 				PPU.HDMA &= ~(1 << i);
 				PPU.HDMAEnded |= (1 << i);
+				HDMAPrograms[i].Valid = FALSE;
 			}
+			else
+				decodeHDMAProgram(i);
 		}
 		else
+		{
 			DMA[i].DoTransfer = FALSE;
+			HDMAPrograms[i].Valid = FALSE;
+		}
 	}
 
+	updateHDMAWatch();
+
 	CPU.InHDMA = FALSE;
 	CPU.InDMAorHDMA = CPU.InDMA;
 	CPU.HDMARanInDMA = CPU.InDMA ? PPU.HDMA : 0;
@@ -1409,6 +1844,8 @@ void S9xStartHDMA (void)
 
 uint8 S9xDoHDMA (uint8 byte)
 {
+	S9X_PROFILE(S9X_PROFILE_HDMA);
+
 	struct SDMA	*p = &DMA[0];
 
 	uint32	ShiftedIBank;
@@ -1433,6 +1870,51 @@ uint8 S9xDoHDMA (uint8 byte)
 			CPU.InWRAMDMAorHDMA = FALSE;
 			CPU.CurrentDMAorHDMAChannel = d;
 
+			struct SHDMAProgram	*prog = &HDMAPrograms[d];
+
+			if (prog->Valid && prog->Next < prog->Steps)
+			{
+				// HDMA PROGRAM
+				struct SHDMAStep	*step = &prog->Step[prog->Next++];
+
+				if (step->Transfer)
+				{
+					for (int i = 0; i < HDMA_ModeByteCounts[p->TransferMode]; i++)
+					{
+						S9xSetPPU(step->Values[i], 0x2100 + prog->Registers[i]);
+						ADD_CYCLES(SLOW_ONE_CYCLE);
+					}
+				}
+
+				p->Address = step->Address;
+				p->IndirectAddress = step->IndirectAddress;
+				p->Repeat = step->Repeat;
+				p->DoTransfer = step->DoTransfer;
+				p->LineCount = step->LineCount;
+				HDMAMemPointers[d] = NULL;
+
+				if (step->Reload == 2)
+				{
+					if (!HDMAReadLineCount(d))
+					{
+						byte &= ~mask;
+						PPU.HDMAEnded |= mask;
+						p->DoTransfer = FALSE;
+					}
+				}
+				else
+				if (step->Reload)
+				{
+					ADD_CYCLES(SLOW_ONE_CYCLE);
+					if (p->HDMAIndirectAddressing)
+						ADD_CYCLES(SLOW_ONE_CYCLE << 1);
+				}
+				else
+					ADD_CYCLES(SLOW_ONE_CYCLE);
+
+				continue;
+			}
+
 			if (p->HDMAIndirectAddressing)
 			{
 				ShiftedIBank = (p->IndirectBank << 16);
@@ -1444,6 +1926,15 @@ uint8 S9xDoHDMA (uint8 byte)
 				IAddr = p->Address;
 			}
 
+			// the pointer is kept across scanlines, the Super FX thread or the SA-1 may own what it leads to by now
+			uint8	*block = Memory.Map[((ShiftedIBank + IAddr) & 0xffffff) >> MEMMAP_SHIFT];
+
+			if (block == (uint8 *) CMemory::MAP_SUPERFX_RAM)
+				S9xSuperFXSync();
+			else
+			if (block == (uint8 *) CMemory::MAP_SA1_IRAM || block == (uint8 *) CMemory::MAP_SA1_BWRAM || block == (uint8 *) CMemory::MAP_BWRAM)
+				S9xSA1Sync();
+
 			if (!HDMAMemPointers[d])
 				HDMAMemPointers[d] = S9xGetMemPointer(ShiftedIBank + IAddr);
 
@@ -1794,4 +2285,6 @@ void S9xResetDMA (void)
 		DMA[d].DoTransfer = FALSE;
 		DMA[d].UnusedBit43x0 = 1;
 	}
+
+	S9xInvalidateHDMAPrograms();
 }
@@ -202,11 +202,67 @@ struct SDMA
 #define TransferBytes	DMACount_Or_HDMAIndirectAddress
 #define IndirectAddress	DMACount_Or_HDMAIndirectAddress
 
-extern struct SDMA	DMA[8];
+extern S9X_TLS struct SDMA	DMA[8];
+
+// HDMA tables in ROM or WRAM are decoded by S9xStartHDMA() into the line by line work of their
+// channel for the whole frame, S9xDoHDMA() then only writes the bytes and takes over the channel
+// state. A program is dropped when its channel registers or the WRAM it was read from are written.
+#define S9X_HDMA_MAX_STEPS	256
+
+struct SHDMAStep
+{
+	uint8	Values[4];		// written this line, if the channel transfers
+	uint8	Transfer;
+	uint8	Reload;			// the next table entry is read at the end of the line, 2 if it ends the table
+	uint8	Repeat;			// channel state after the line
+	uint8	DoTransfer;
+	uint8	LineCount;
+	uint16	Address;
+	uint16	IndirectAddress;
+};
+
+struct SHDMAProgram
+{
+	bool8	Valid;
+	bool8	Dropped;		// invalidated while in use, so it isn't decoded for the next frame
+	uint8	Registers[4];	// $21xx written by each byte of a line
+	uint32	WatchLow;		// WRAM it was read from
+	uint32	WatchSize;
+	int32	Next;
+	int32	Steps;
+	struct SHDMAStep	Step[S9X_HDMA_MAX_STEPS];
+};
+
+// WRAM range covering the ranges of all programs
+struct SHDMAWatch
+{
+	uint32	Low;
+	uint32	Size;
+};
+
+extern S9X_TLS struct SHDMAProgram	HDMAPrograms[8];
+extern S9X_TLS struct SHDMAWatch	HDMAWatch;
+
+// for writes that may go to WRAM
+#define S9X_HDMA_WATCH(ptr) \
+{ \
+	if ((uint64) ((ptr) - Memory.RAM - HDMAWatch.Low) < HDMAWatch.Size) \
+		S9xHDMAWatchWrite((ptr) - Memory.RAM, 1); \
+}
 
 bool8 S9xDoDMA (uint8);
 void S9xStartHDMA (void);
 uint8 S9xDoHDMA (uint8);
 void S9xResetDMA (void);
+void S9xInvalidateHDMAPrograms (void);
+void S9xHDMAWatchWrite (uint32, uint32);
+
+static inline void S9xDropHDMAProgram (int d)
+{
+	if (HDMAPrograms[d].Valid && HDMAPrograms[d].Next < HDMAPrograms[d].Steps)
+		HDMAPrograms[d].Dropped = TRUE;
+
+	HDMAPrograms[d].Valid = FALSE;
+}
 
 #endif
@@ -178,6 +178,7 @@
 
 #include "snes9x.h"
 #include "blit.h"
+#include "../profiler.h"
 
 #define ALL_COLOR_MASK	(FIRST_COLOR_MASK | SECOND_COLOR_MASK | THIRD_COLOR_MASK)
 
@@ -257,6 +258,8 @@ void S9xBlitNTSCFilterSet (const snes_ntsc_setup_t *setup)
 
 void S9xBlitPixSimple1x1 (uint8 *srcPtr, int srcRowBytes, uint8 *dstPtr, int dstRowBytes, int width, int height)
 {
+	S9X_PROFILE(S9X_PROFILE_FILTER);
+
 	width <<= 1;
 
 	for (; height; height--)
@@ -269,6 +272,8 @@ void S9xBlitPixSimple1x1 (uint8 *srcPtr, int srcRowBytes, uint8 *dstPtr, int dst
 
 void S9xBlitPixSimple1x2 (uint8 *srcPtr, int srcRowBytes, uint8 *dstPtr, int dstRowBytes, int width, int height)
 {
+	S9X_PROFILE(S9X_PROFILE_FILTER);
+
 	width <<= 1;
 
 	for (; height; height--)
@@ -283,6 +288,8 @@ void S9xBlitPixSimple1x2 (uint8 *srcPtr, int srcRowBytes, uint8 *dstPtr, int dst
 
 void S9xBlitPixSimple2x1 (uint8 *srcPtr, int srcRowBytes, uint8 *dstPtr, int dstRowBytes, int width, int height)
 {
+	S9X_PROFILE(S9X_PROFILE_FILTER);
+
 	for (; height; height--)
 	{
 		uint16	*dP = (uint16 *) dstPtr, *bP = (uint16 *) srcPtr;
@@ -303,6 +310,8 @@ void S9xBlitPixSimple2x1 (uint8 *srcPtr, int srcRowBytes, uint8 *dstPtr, int dst
 
 void S9xBlitPixSimple2x2 (uint8 *srcPtr, int srcRowBytes, uint8 *dstPtr, int dstRowBytes, int width, int height)
 {
+	S9X_PROFILE(S9X_PROFILE_FILTER);
+
 	uint8	*dstPtr2 = dstPtr + dstRowBytes, *deltaPtr = XDelta;
 	dstRowBytes <<= 1;
 
@@ -352,6 +361,8 @@ void S9xBlitPixSimple2x2 (uint8 *srcPtr, int srcRowBytes, uint8 *dstPtr, int dst
 
 void S9xBlitPixBlend1x1 (uint8 *srcPtr, int srcRowBytes, uint8 *dstPtr, int dstRowBytes, int width, int height)
 {
+	S9X_PROFILE(S9X_PROFILE_FILTER);
+
 	for (; height; height--)
 	{
 		uint16	*dP = (uint16 *) dstPtr, *bP = (uint16 *) srcPtr;
@@ -377,6 +388,8 @@ void S9xBlitPixBlend1x1 (uint8 *srcPtr, int srcRowBytes, uint8 *dstPtr, int dstR
 
 void S9xBlitPixBlend2x1 (uint8 *srcPtr, int srcRowBytes, uint8 *dstPtr, int dstRowBytes, int width, int height)
 {
+	S9X_PROFILE(S9X_PROFILE_FILTER);
+
 	for (; height; height--)
 	{
 		uint16	*dP = (uint16 *) dstPtr, *bP = (uint16 *) srcPtr;
@@ -404,6 +417,8 @@ void S9xBlitPixBlend2x1 (uint8 *srcPtr, int srcRowBytes, uint8 *dstPtr, int dstR
 
 void S9xBlitPixTV1x2 (uint8 *srcPtr, int srcRowBytes, uint8 *dstPtr, int dstRowBytes, int width, int height)
 {
+	S9X_PROFILE(S9X_PROFILE_FILTER);
+
 	uint8	*dstPtr2 = dstPtr + dstRowBytes;
 	dstRowBytes <<= 1;
 
@@ -428,6 +443,8 @@ void S9xBlitPixTV1x2 (uint8 *srcPtr, int srcRowBytes, uint8 *dstPtr, int dstRowB
 
 void S9xBlitPixTV2x2 (uint8 *srcPtr, int srcRowBytes, uint8 *dstPtr, int dstRowBytes, int width, int height)
 {
+	S9X_PROFILE(S9X_PROFILE_FILTER);
+
 	uint8	*dstPtr2 = dstPtr + dstRowBytes, *deltaPtr = XDelta;
 	dstRowBytes <<= 1;
 
@@ -539,6 +556,8 @@ void S9xBlitPixTV2x2 (uint8 *srcPtr, int srcRowBytes, uint8 *dstPtr, int dstRowB
 
 void S9xBlitPixMixedTV1x2 (uint8 *srcPtr, int srcRowBytes, uint8 *dstPtr, int dstRowBytes, int width, int height)
 {
+	S9X_PROFILE(S9X_PROFILE_FILTER);
+
 	uint8	*dstPtr2 = dstPtr + dstRowBytes, *srcPtr2 = srcPtr + srcRowBytes;
 	dstRowBytes <<= 1;
 
@@ -580,6 +599,8 @@ void S9xBlitPixMixedTV1x2 (uint8 *srcPtr, int srcRowBytes, uint8 *dstPtr, int ds
 
 void S9xBlitPixSmooth2x2 (uint8 *srcPtr, int srcRowBytes, uint8 *dstPtr, int dstRowBytes, int width, int height)
 {
+	S9X_PROFILE(S9X_PROFILE_FILTER);
+
 	uint8	*dstPtr2 = dstPtr + dstRowBytes, *deltaPtr = XDelta;
 	uint32	lastLinePix[SNES_WIDTH << 1];
 	uint8	lastLineChg[SNES_WIDTH >> 1];
@@ -669,45 +690,63 @@ void S9xBlitPixSmooth2x2 (uint8 *srcPtr, int srcRowBytes, uint8 *dstPtr, int dst
 
 void S9xBlitPixSuper2xSaI16 (uint8 *srcPtr, int srcRowBytes, uint8 *dstPtr, int dstRowBytes, int width, int height)
 {
+	S9X_PROFILE(S9X_PROFILE_FILTER);
+
 	Super2xSaI(srcPtr, srcRowBytes, dstPtr, dstRowBytes, width, height);
 }
 
 void S9xBlitPix2xSaI16 (uint8 *srcPtr, int srcRowBytes, uint8 *dstPtr, int dstRowBytes, int width, int height)
 {
+	S9X_PROFILE(S9X_PROFILE_FILTER);
+
 	_2xSaI(srcPtr, srcRowBytes, dstPtr, dstRowBytes, width, height);
 }
 
 void S9xBlitPixSuperEagle16 (uint8 *srcPtr, int srcRowBytes, uint8 *dstPtr, int dstRowBytes, int width, int height)
 {
+	S9X_PROFILE(S9X_PROFILE_FILTER);
+
 	SuperEagle(srcPtr, srcRowBytes, dstPtr, dstRowBytes, width, height);
 }
 
 void S9xBlitPixEPX16 (uint8 *srcPtr, int srcRowBytes, uint8 *dstPtr, int dstRowBytes, int width, int height)
 {
+	S9X_PROFILE(S9X_PROFILE_FILTER);
+
 	EPX_16(srcPtr, srcRowBytes, dstPtr, dstRowBytes, width, height);
 }
 
 void S9xBlitPixHQ2x16 (uint8 *srcPtr, int srcRowBytes, uint8 *dstPtr, int dstRowBytes, int width, int height)
 {
+	S9X_PROFILE(S9X_PROFILE_FILTER);
+
 	HQ2X_16(srcPtr, srcRowBytes, dstPtr, dstRowBytes, width, height);
 }
 
 void S9xBlitPixHQ3x16 (uint8 *srcPtr, int srcRowBytes, uint8 *dstPtr, int dstRowBytes, int width, int height)
 {
+	S9X_PROFILE(S9X_PROFILE_FILTER);
+
 	HQ3X_16(srcPtr, srcRowBytes, dstPtr, dstRowBytes, width, height);
 }
 
 void S9xBlitPixHQ4x16 (uint8 *srcPtr, int srcRowBytes, uint8 *dstPtr, int dstRowBytes, int width, int height)
 {
+	S9X_PROFILE(S9X_PROFILE_FILTER);
+
 	HQ4X_16(srcPtr, srcRowBytes, dstPtr, dstRowBytes, width, height);
 }
 
 void S9xBlitPixNTSC16 (uint8 *srcPtr, int srcRowBytes, uint8 *dstPtr, int dstRowBytes, int width, int height)
 {
+	S9X_PROFILE(S9X_PROFILE_FILTER);
+
 	snes_ntsc_blit(ntsc, (SNES_NTSC_IN_T const *) srcPtr, srcRowBytes >> 1, 0, width, height, dstPtr, dstRowBytes);
 }
 
 void S9xBlitPixHiResNTSC16 (uint8 *srcPtr, int srcRowBytes, uint8 *dstPtr, int dstRowBytes, int width, int height)
 {
+	S9X_PROFILE(S9X_PROFILE_FILTER);
+
 	snes_ntsc_blit_hires(ntsc, (SNES_NTSC_IN_T const *) srcPtr, srcRowBytes >> 1, 0, width, height, dstPtr, dstRowBytes);
 }
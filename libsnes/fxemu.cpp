@@ -180,6 +180,16 @@
 #include "memmap.h"
 #include "fxinst.h"
 #include "fxemu.h"
+#include "profiler.h"
+
+#ifdef S9X_SUPERFX_THREAD
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#endif
 
 static void FxReset (struct FxInfo_s *);
 static void fx_readRegisterSpace (void);
@@ -190,6 +200,10 @@ static bool8 fx_checkStartAddress (void);
 static uint32 FxEmulate (uint32);
 static void FxCacheWriteAccess (uint16);
 static void FxFlushCache (void);
+static void fx_raiseIRQ (void);
+#ifdef S9X_SUPERFX_THREAD
+static bool8 fx_startChunk (uint32);
+#endif
 
 
 void S9xInitSuperFX (void)
@@ -199,6 +213,8 @@ void S9xInitSuperFX (void)
 
 void S9xResetSuperFX (void)
 {
+	S9xSuperFXSync();
+
 	// FIXME: Snes9x can't execute CPU and SuperFX at a time. Don't ask me what is 0.417 :P
 	SuperFX.speedPerLine = (uint32) (0.417 * 10.5e6 * ((1.0 / (float) Memory.ROMFramesPerSecond) / ((float) (Timings.V_Max))));
 	SuperFX.oneLineDone = FALSE;
@@ -209,6 +225,8 @@ void S9xResetSuperFX (void)
 
 void S9xSetSuperFX (uint8 byte, uint16 address)
 {
+	S9xSuperFXSync();
+
 	switch (address)
 	{
 		case 0x3030:
@@ -300,6 +318,8 @@ uint8 S9xGetSuperFX (uint16 address)
 {
 	uint8	byte;
 
+	S9xSuperFXSync();
+
 	byte = Memory.FillRAM[address];
 
 	if (address == 0x3031)
@@ -313,16 +333,343 @@ uint8 S9xGetSuperFX (uint16 address)
 
 void S9xSuperFXExec (void)
 {
+	S9xSuperFXSync();
+
 	if ((Memory.FillRAM[0x3000 + GSU_SFR] & FLG_G) && (Memory.FillRAM[0x3000 + GSU_SCMR] & 0x18) == 0x18)
 	{
-		FxEmulate((Memory.FillRAM[0x3000 + GSU_CLSR] & 1) ? SuperFX.speedPerLine * 2 : SuperFX.speedPerLine);
+		uint32	nInstructions = (Memory.FillRAM[0x3000 + GSU_CLSR] & 1) ? SuperFX.speedPerLine * 2 : SuperFX.speedPerLine;
+
+	#ifdef S9X_SUPERFX_THREAD
+		if (fx_startChunk(nInstructions))
+			return;
+	#endif
+
+		S9X_PROFILE(S9X_PROFILE_SUPERFX);
+
+		FxEmulate(nInstructions);
+		fx_raiseIRQ();
+	}
+}
+
+static void fx_raiseIRQ (void)
+{
+	uint16 GSUStatus = Memory.FillRAM[0x3000 + GSU_SFR] | (Memory.FillRAM[0x3000 + GSU_SFR + 1] << 8);
+	if ((GSUStatus & (FLG_G | FLG_IRQ)) == FLG_IRQ)
+		CPU.IRQExternal = TRUE;
+}
+
+#ifdef S9X_SUPERFX_THREAD
+
+// an idle thread spins that often before it sleeps, while the GSU runs chunks come every scanline
+#define FX_THREAD_SPINS	10000
+
+enum
+{
+	FX_CHUNK_NONE,
+	FX_CHUNK_QUEUED,
+	FX_CHUNK_DONE
+};
+
+struct SSuperFXThread
+{
+	std::thread				thread;
+	std::mutex				mutex;
+	std::condition_variable	wakeup;
+	std::atomic<int>		chunk;
+	std::atomic<bool>		quit;
+	bool					sleeping;
+	int						mode;
+	uint32					instructions;
+	struct FxRegs_s			gsu;			// handed over in both directions
+	uint8					*ram;
+	uint32					ramSize;
+	// blocks of the CPU memory map that lead into GSU RAM, with their own pointers
+	int						blocks;
+	uint32					block[MEMMAP_NUM_BLOCKS];
+	uint8					*map[MEMMAP_NUM_BLOCKS];
+	uint8					*writeMap[MEMMAP_NUM_BLOCKS];
+	// S9X_SUPERFX_THREAD_VERIFY only
+	struct FxRegs_s			start;
+	struct FxRegs_s			compare;
+	uint8					startRegisters[0x300];
+	uint8					resultRegisters[0x300];
+	uint8					*startRam;
+	uint8					*resultRam;
+	uint64					lines;
+	uint64					mismatches;
+};
+
+static S9X_TLS struct SSuperFXThread	*fxThread = NULL;
+
+// GSU points into itself, a copy has to point into its own registers
+static void fx_copyRegs (struct FxRegs_s *dst, const struct FxRegs_s *src)
+{
+	memcpy(dst, src, sizeof(struct FxRegs_s));
+	dst->pvSreg = dst->avReg + (src->pvSreg - src->avReg);
+	dst->pvDreg = dst->avReg + (src->pvDreg - src->avReg);
+}
+
+static bool8 fx_mapsToRam (struct SSuperFXThread *t, uint8 *base, uint32 block)
+{
+	uint8	*p = base + ((block << MEMMAP_SHIFT) & 0xffff);
+
+	return (base >= (uint8 *) CMemory::MAP_LAST && p >= t->ram && p < t->ram + t->ramSize);
+}
+
+static void fx_threadProc (struct SSuperFXThread *t)
+{
+	for (;;)
+	{
+		for (int i = 0; i < FX_THREAD_SPINS && !t->quit && t->chunk.load(std::memory_order_acquire) != FX_CHUNK_QUEUED; i++)
+			std::this_thread::yield();
+
+		if (t->chunk.load(std::memory_order_acquire) != FX_CHUNK_QUEUED)
+		{
+			std::unique_lock<std::mutex>	lock(t->mutex);
+			t->sleeping = true;
+			t->wakeup.wait(lock, [t] { return (t->quit || t->chunk.load() == FX_CHUNK_QUEUED); });
+			t->sleeping = false;
+		}
+
+		if (t->quit)
+			break;
+
+		fx_copyRegs(&GSU, &t->gsu);
+		FxEmulate(t->instructions);
+		fx_copyRegs(&t->gsu, &GSU);
+
+		t->chunk.store(FX_CHUNK_DONE, std::memory_order_release);
+	}
+}
+
+// hands the chunk to the thread, unless the CPU would need it before getting anything else done
+static bool8 fx_startChunk (uint32 nInstructions)
+{
+	struct SSuperFXThread	*t = fxThread;
+
+	// a (H)DMA keeps its pointers across scanlines
+	if (!t || CPU.InDMAorHDMA)
+		return (FALSE);
+
+	// an IRQ from the chunk would be taken or end WAI at the next instruction
+	if (!CPU.IRQExternal && (!CheckFlag(IRQ) || CPU.WaitingForInterrupt || CPU.IRQTransition))
+		return (FALSE);
+
+	// the CPU fetches its code straight from GSU RAM
+	if (CPU.PCBase && CPU.PCBase + Registers.PCw >= t->ram && CPU.PCBase + Registers.PCw < t->ram + t->ramSize)
+		return (FALSE);
+
+	t->instructions = nInstructions;
+	fx_copyRegs(&t->gsu, &GSU);
+
+	if (t->mode == S9X_SUPERFX_THREAD_VERIFY)
+	{
+		fx_copyRegs(&t->start, &GSU);
+		memcpy(t->startRegisters, SuperFX.pvRegisters, 0x300);
+		memcpy(t->startRam, t->ram, t->ramSize);
+	}
+
+	for (int i = 0; i < t->blocks; i++)
+		Memory.Map[t->block[i]] = Memory.WriteMap[t->block[i]] = (uint8 *) CMemory::MAP_SUPERFX_RAM;
+
+	SuperFX.inFlight = TRUE;
+	SuperFX.irqBoundaries = 0;
+	CPU.IRQExternalPending = !CPU.IRQExternal;
+	t->lines++;
+
+	std::lock_guard<std::mutex>	lock(t->mutex);
+	t->chunk.store(FX_CHUNK_QUEUED, std::memory_order_release);
+	if (t->sleeping)
+		t->wakeup.notify_one();
+
+	return (TRUE);
+}
+
+// runs the chunk again in place from where it started, and compares with what the thread made of it
+static void fx_verifyChunk (struct SSuperFXThread *t)
+{
+	memcpy(t->resultRegisters, SuperFX.pvRegisters, 0x300);
+	memcpy(t->resultRam, t->ram, t->ramSize);
+	memcpy(SuperFX.pvRegisters, t->startRegisters, 0x300);
+	memcpy(t->ram, t->startRam, t->ramSize);
+	fx_copyRegs(&GSU, &t->start);
+
+	FxEmulate(t->instructions);
+
+	fx_copyRegs(&t->compare, &t->gsu);
+	bool8	same = GSU.pvSreg - GSU.avReg == t->compare.pvSreg - t->compare.avReg &&
+				   GSU.pvDreg - GSU.avReg == t->compare.pvDreg - t->compare.avReg;
+	t->compare.pvSreg = GSU.pvSreg;
+	t->compare.pvDreg = GSU.pvDreg;
+
+	if (!same || memcmp(&t->compare, &GSU, sizeof(struct FxRegs_s)) ||
+		memcmp(t->resultRegisters, SuperFX.pvRegisters, 0x300) || memcmp(t->resultRam, t->ram, t->ramSize))
+		t->mismatches++;
+}
+
+bool8 S9xSuperFXThreadInit (int mode)
+{
+	S9xSuperFXThreadDeinit();
+
+	if (mode == S9X_SUPERFX_THREAD_OFF || !Settings.SuperFX)
+		return (TRUE);
+
+	struct SSuperFXThread	*t = new SSuperFXThread;
+
+	t->chunk = FX_CHUNK_NONE;
+	t->quit = false;
+	t->sleeping = false;
+	t->mode = mode;
+	t->ram = SuperFX.pvRam;
+	t->ramSize = SuperFX.nRamBanks << 16;
+	t->blocks = 0;
+	t->startRam = t->resultRam = NULL;
+	t->lines = t->mismatches = 0;
+
+	for (uint32 c = 0; c < MEMMAP_NUM_BLOCKS; c++)
+	{
+		if (fx_mapsToRam(t, Memory.Map[c], c) || fx_mapsToRam(t, Memory.WriteMap[c], c))
+		{
+			t->block[t->blocks] = c;
+			t->map[t->blocks] = Memory.Map[c];
+			t->writeMap[t->blocks] = Memory.WriteMap[c];
+			t->blocks++;
+		}
+	}
+
+	if (mode == S9X_SUPERFX_THREAD_VERIFY)
+	{
+		t->startRam = new uint8[t->ramSize];
+		t->resultRam = new uint8[t->ramSize];
+	}
+
+	t->thread = std::thread(fx_threadProc, t);
+	fxThread = t;
+
+	return (TRUE);
+}
+
+void S9xSuperFXThreadDeinit (void)
+{
+	struct SSuperFXThread	*t = fxThread;
+
+	if (!t)
+		return;
 
-		uint16 GSUStatus = Memory.FillRAM[0x3000 + GSU_SFR] | (Memory.FillRAM[0x3000 + GSU_SFR + 1] << 8);
-		if ((GSUStatus & (FLG_G | FLG_IRQ)) == FLG_IRQ)
-			CPU.IRQExternal = TRUE;
+	S9xSuperFXSync();
+
+	{
+		std::lock_guard<std::mutex>	lock(t->mutex);
+		t->quit = true;
 	}
+
+	t->wakeup.notify_one();
+	t->thread.join();
+
+	delete[] t->startRam;
+	delete[] t->resultRam;
+	delete t;
+	fxThread = NULL;
 }
 
+void S9xSuperFXSync (void)
+{
+	struct SSuperFXThread	*t = fxThread;
+
+	if (!SuperFX.inFlight)
+		return;
+
+	{
+		S9X_PROFILE(S9X_PROFILE_SUPERFX);
+
+		while (t->chunk.load(std::memory_order_acquire) != FX_CHUNK_DONE)
+			std::this_thread::yield();
+	}
+
+	t->chunk.store(FX_CHUNK_NONE, std::memory_order_relaxed);
+
+	for (int i = 0; i < t->blocks; i++)
+	{
+		Memory.Map[t->block[i]] = t->map[i];
+		Memory.WriteMap[t->block[i]] = t->writeMap[i];
+	}
+
+	SuperFX.inFlight = FALSE;
+	fx_copyRegs(&GSU, &t->gsu);
+
+	if (t->mode == S9X_SUPERFX_THREAD_VERIFY)
+		fx_verifyChunk(t);
+
+	bool8	pending = CPU.IRQExternalPending;
+
+	CPU.IRQExternalPending = FALSE;
+	fx_raiseIRQ();
+
+	if (pending && CPU.IRQExternal)
+	{
+		// the boundaries passed meanwhile would have counted IRQPending down, see S9xDoInterruptLines()
+		int32	left = SuperFX.irqBoundaries;
+
+		if (left > CPU.IRQPending)
+		{
+			left -= CPU.IRQPending + 1;
+			CPU.IRQPending = Timings.IRQPendCount - left % (Timings.IRQPendCount + 1);
+		}
+		else
+			CPU.IRQPending -= left;
+	}
+}
+
+void S9xSuperFXCheckIRQ (void)
+{
+	// as long as the IRQ couldn't be taken, it could only have counted IRQPending down
+	if (!CheckFlag(IRQ) || CPU.WaitingForInterrupt || CPU.IRQTransition)
+		S9xSuperFXSync();
+	else
+		SuperFX.irqBoundaries++;
+}
+
+uint64 S9xSuperFXThreadLines (void)
+{
+	return (fxThread ? fxThread->lines : 0);
+}
+
+uint64 S9xSuperFXThreadMismatches (void)
+{
+	return (fxThread ? fxThread->mismatches : 0);
+}
+
+#else
+
+bool8 S9xSuperFXThreadInit (int mode)
+{
+	return (mode == S9X_SUPERFX_THREAD_OFF);
+}
+
+void S9xSuperFXThreadDeinit (void)
+{
+}
+
+void S9xSuperFXSync (void)
+{
+}
+
+void S9xSuperFXCheckIRQ (void)
+{
+}
+
+uint64 S9xSuperFXThreadLines (void)
+{
+	return (0);
+}
+
+uint64 S9xSuperFXThreadMismatches (void)
+{
+	return (0);
+}
+
+#endif
+
 static void FxReset (struct FxInfo_s *psFxInfo)
 {
 	// Clear all internal variables
@@ -447,11 +794,6 @@ static void fx_readRegisterSpace (void)
 	GSU.pfPlot = fx_PlotTable[GSU.vMode];
 	GSU.pfRpix = fx_PlotTable[GSU.vMode + 5];
 
-	fx_OpcodeTable[0x04c] = GSU.pfPlot;
-	fx_OpcodeTable[0x14c] = GSU.pfRpix;
-	fx_OpcodeTable[0x24c] = GSU.pfPlot;
-	fx_OpcodeTable[0x34c] = GSU.pfRpix;
-
 	fx_computeScreenPointers();
 
 	//fx_backupCache();
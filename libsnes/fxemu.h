@@ -193,9 +193,11 @@ struct FxInfo_s
 	uint8	*pvRom;			// Pointer to Cart-ROM
 	uint32	speedPerLine;
 	bool8	oneLineDone;
+	bool8	inFlight;		// a chunk is running on the Super FX thread
+	uint32	irqBoundaries;	// instruction boundaries passed since, while its IRQ was still unknown
 };
 
-extern struct FxInfo_s	SuperFX;
+extern S9X_TLS struct FxInfo_s	SuperFX;
 
 void S9xInitSuperFX (void);
 void S9xResetSuperFX (void);
@@ -206,4 +208,35 @@ void fx_flushCache (void);
 void fx_computeScreenPointers (void);
 uint32 fx_run (uint32);
 
+// Super FX thread. S9xSuperFXExec() can hand its chunk of GSU instructions to a thread of the
+// console instead of running it in place; the CPU goes on until it needs something the chunk owns.
+// S9xSuperFXSync() then waits for the chunk and takes over its results. That happens on accesses to
+// the GSU registers, on CPU, DMA and HDMA accesses to GSU RAM (its blocks are mapped to
+// MAP_SUPERFX_RAM while a chunk runs), at the first instruction boundary where an IRQ raised by the
+// chunk would be seen, before the next chunk, and around frame ends, snapshots and resets. Chunks
+// that would be needed right away run in place. Nothing else can see the chunk run, so it ends up
+// exactly as if it had run in place. S9X_SUPERFX_THREAD_VERIFY replays every chunk in place from
+// where it started and counts the ones that came out different.
+//
+// Without threads (emscripten, S9X_SINGLE_INSTANCE) every chunk runs in place.
+
+#if !defined(__EMSCRIPTEN__) && !defined(S9X_SINGLE_INSTANCE)
+#define S9X_SUPERFX_THREAD
+#endif
+
+#define S9X_SUPERFX_THREAD_OFF		0
+#define S9X_SUPERFX_THREAD_ON		1
+#define S9X_SUPERFX_THREAD_VERIFY	2
+
+// starts the thread in the given mode for the console of the calling thread, if it runs a Super FX game
+bool8 S9xSuperFXThreadInit (int);
+void S9xSuperFXThreadDeinit (void);
+// waits for the chunk on the thread, if there is one
+void S9xSuperFXSync (void);
+// instruction boundary while CPU.IRQExternalPending is set
+void S9xSuperFXCheckIRQ (void);
+// chunks run by the thread since it was started, and the ones S9X_SUPERFX_THREAD_VERIFY found different
+uint64 S9xSuperFXThreadLines (void);
+uint64 S9xSuperFXThreadMismatches (void);
+
 #endif
@@ -698,12 +698,84 @@ static void fx_stb_r11 (void)
 	FX_STB(11);
 }
 
+// Plot n pixels of the current color from R1, R2 onwards, a whole tile row of bitplanes at a time
+static void fx_plot_run (uint32 n)
+{
+	static const uint32	avPlanes[4] = { 2, 4, 4, 8 };
+	uint32	y = USEX8(R2);
+	uint8	c[2], m[2];
+
+#ifdef CHECK_LIMITS
+	if (y >= GSU.vScreenHeight)
+	{
+		R1 += n;
+		return;
+	}
+#endif
+
+	// Pixels with (x ^ y) even use c[0], odd ones c[1] (they only differ when dithering)
+	c[0] = c[1] = (uint8) GSU.vColorReg;
+	if (GSU.vMode != 3 && (GSU.vPlotOptionReg & 0x02))
+		c[1] = (uint8) (GSU.vColorReg >> 4);
+
+	for (int i = 0; i < 2; i++)
+	{
+		if (GSU.vMode == 3 && (GSU.vPlotOptionReg & 0x10))
+			m[i] = (GSU.vPlotOptionReg & 0x01) || c[i] ? 0xff : 0;
+		else
+			m[i] = (GSU.vPlotOptionReg & 0x01) || (c[i] & 0xf) ? 0xff : 0;
+	}
+
+	m[0] &= (y & 1) ? 0x55 : 0xaa;
+	m[1] &= (y & 1) ? 0xaa : 0x55;
+
+	while (n)
+	{
+		uint32	x = USEX8(R1);
+		uint32	k = 8 - (x & 7);
+		if (k > n)
+			k = n;
+
+		uint8	v = (uint8) ((0xff >> (x & 7)) & (0xff << (8 - (x & 7) - k)));
+		uint8	v0 = v & m[0], v1 = v & m[1];
+		uint8	*a = GSU.apvScreen[y >> 3] + GSU.x[x >> 3] + ((y & 7) << 1);
+
+		for (uint32 p = 0; p < avPlanes[GSU.vMode]; p++)
+		{
+			uint8	*b = &a[((p >> 1) << 4) + (p & 1)];
+			*b = (*b & ~(v0 | v1)) | ((c[0] >> p) & 1 ? v0 : 0) | ((c[1] >> p) & 1 ? v1 : 0);
+		}
+
+		R1 += k;
+		n -= k;
+	}
+}
+
 // 3c - loop - decrement loop counter, and branch on not zero
 static void fx_loop (void)
 {
 	GSU.vSign = GSU.vZero = --R12;
 	if ((uint16) R12 != 0)
+	{
 		R15 = R13;
+
+		// A loop onto itself with a plot in the delay slot fills a span. Do all but the last
+		// plot/loop pairs the instruction budget allows at once; the state is the same as stepping
+		if (PIPE == 0x4c && GSU.vPrgBankReg < 0x60 && PRGBANK(R13) == 0x3c && PRGBANK(R13 + 1) == 0x4c)
+		{
+			uint32	n = USEX16(R12) - 1;
+			if (n > GSU.vCounter / 2)
+				n = GSU.vCounter / 2;
+
+			if (n)
+			{
+				GSU.vCounter -= n * 2;
+				R12 -= n;
+				GSU.vSign = GSU.vZero = R12;
+				fx_plot_run(n);
+			}
+		}
+	}
 	else
 		R15++;
 	CLRFLAGS;
@@ -1134,6 +1206,18 @@ static void fx_rpix_obj (void)
 #endif
 }
 
+// 4c - plot - through the routine fx_readRegisterSpace picked for this console's screen mode
+static void fx_plot (void)
+{
+	(*GSU.pfPlot)();
+}
+
+// 4c (ALT1) - rpix
+static void fx_rpix (void)
+{
+	(*GSU.pfRpix)();
+}
+
 // 4d - swap - swap upper and lower byte of a register
 static void fx_swap (void)
 {
@@ -4217,7 +4301,7 @@ void (*fx_PlotTable[]) (void) =
 
 // Opcode table
 
-void (*fx_OpcodeTable[]) (void) =
+void (* const fx_OpcodeTable[]) (void) =
 {
 	// ALT0 Table
 
@@ -4235,7 +4319,7 @@ void (*fx_OpcodeTable[]) (void) =
 	&fx_stw_r8,    &fx_stw_r9,    &fx_stw_r10,   &fx_stw_r11,   &fx_loop,      &fx_alt1,      &fx_alt2,      &fx_alt3,
 	// 40 - 4f
 	&fx_ldw_r0,    &fx_ldw_r1,    &fx_ldw_r2,    &fx_ldw_r3,    &fx_ldw_r4,    &fx_ldw_r5,    &fx_ldw_r6,    &fx_ldw_r7,
-	&fx_ldw_r8,    &fx_ldw_r9,    &fx_ldw_r10,   &fx_ldw_r11,   &fx_plot_2bit, &fx_swap,      &fx_color,     &fx_not,
+	&fx_ldw_r8,    &fx_ldw_r9,    &fx_ldw_r10,   &fx_ldw_r11,   &fx_plot,      &fx_swap,      &fx_color,     &fx_not,
 	// 50 - 5f
 	&fx_add_r0,    &fx_add_r1,    &fx_add_r2,    &fx_add_r3,    &fx_add_r4,    &fx_add_r5,    &fx_add_r6,    &fx_add_r7,
 	&fx_add_r8,    &fx_add_r9,    &fx_add_r10,   &fx_add_r11,   &fx_add_r12,   &fx_add_r13,   &fx_add_r14,   &fx_add_r15,
@@ -4286,7 +4370,7 @@ void (*fx_OpcodeTable[]) (void) =
 	&fx_stb_r8,    &fx_stb_r9,    &fx_stb_r10,   &fx_stb_r11,   &fx_loop,      &fx_alt1,      &fx_alt2,      &fx_alt3,
 	// 40 - 4f
 	&fx_ldb_r0,    &fx_ldb_r1,    &fx_ldb_r2,    &fx_ldb_r3,    &fx_ldb_r4,    &fx_ldb_r5,    &fx_ldb_r6,    &fx_ldb_r7,
-	&fx_ldb_r8,    &fx_ldb_r9,    &fx_ldb_r10,   &fx_ldb_r11,   &fx_rpix_2bit, &fx_swap,      &fx_cmode,     &fx_not,
+	&fx_ldb_r8,    &fx_ldb_r9,    &fx_ldb_r10,   &fx_ldb_r11,   &fx_rpix,      &fx_swap,      &fx_cmode,     &fx_not,
 	// 50 - 5f
 	&fx_adc_r0,    &fx_adc_r1,    &fx_adc_r2,    &fx_adc_r3,    &fx_adc_r4,    &fx_adc_r5,    &fx_adc_r6,    &fx_adc_r7,
 	&fx_adc_r8,    &fx_adc_r9,    &fx_adc_r10,   &fx_adc_r11,   &fx_adc_r12,   &fx_adc_r13,   &fx_adc_r14,   &fx_adc_r15,
@@ -4337,7 +4421,7 @@ void (*fx_OpcodeTable[]) (void) =
 	&fx_stw_r8,    &fx_stw_r9,    &fx_stw_r10,   &fx_stw_r11,   &fx_loop,      &fx_alt1,      &fx_alt2,      &fx_alt3,
 	// 40 - 4f
 	&fx_ldw_r0,    &fx_ldw_r1,    &fx_ldw_r2,    &fx_ldw_r3,    &fx_ldw_r4,    &fx_ldw_r5,    &fx_ldw_r6,    &fx_ldw_r7,
-	&fx_ldw_r8,    &fx_ldw_r9,    &fx_ldw_r10,   &fx_ldw_r11,   &fx_plot_2bit, &fx_swap,      &fx_color,     &fx_not,
+	&fx_ldw_r8,    &fx_ldw_r9,    &fx_ldw_r10,   &fx_ldw_r11,   &fx_plot,      &fx_swap,      &fx_color,     &fx_not,
 	// 50 - 5f
 	&fx_add_i0,    &fx_add_i1,    &fx_add_i2,    &fx_add_i3,    &fx_add_i4,    &fx_add_i5,    &fx_add_i6,    &fx_add_i7,
 	&fx_add_i8,    &fx_add_i9,    &fx_add_i10,   &fx_add_i11,   &fx_add_i12,   &fx_add_i13,   &fx_add_i14,   &fx_add_i15,
@@ -4388,7 +4472,7 @@ void (*fx_OpcodeTable[]) (void) =
 	&fx_stb_r8,    &fx_stb_r9,    &fx_stb_r10,   &fx_stb_r11,   &fx_loop,      &fx_alt1,      &fx_alt2,      &fx_alt3,
 	// 40 - 4f
 	&fx_ldb_r0,    &fx_ldb_r1,    &fx_ldb_r2,    &fx_ldb_r3,    &fx_ldb_r4,    &fx_ldb_r5,    &fx_ldb_r6,    &fx_ldb_r7,
-	&fx_ldb_r8,    &fx_ldb_r9,    &fx_ldb_r10,   &fx_ldb_r11,   &fx_rpix_2bit, &fx_swap,      &fx_cmode,     &fx_not,
+	&fx_ldb_r8,    &fx_ldb_r9,    &fx_ldb_r10,   &fx_ldb_r11,   &fx_rpix,      &fx_swap,      &fx_cmode,     &fx_not,
 	// 50 - 5f
 	&fx_adc_i0,    &fx_adc_i1,    &fx_adc_i2,    &fx_adc_i3,    &fx_adc_i4,    &fx_adc_i5,    &fx_adc_i6,    &fx_adc_i7,
 	&fx_adc_i8,    &fx_adc_i9,    &fx_adc_i10,   &fx_adc_i11,   &fx_adc_i12,   &fx_adc_i13,   &fx_adc_i14,   &fx_adc_i15,
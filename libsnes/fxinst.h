@@ -374,7 +374,7 @@ struct FxRegs_s
 	uint8	*avRegAddr;					// To reference avReg in snapshot.cpp
 };
 
-extern struct FxRegs_s	GSU;
+extern S9X_TLS struct FxRegs_s	GSU;
 
 // GSU registers
 #define GSU_R0			0x000
@@ -535,7 +535,7 @@ extern struct FxRegs_s	GSU;
 }
 
 extern void (*fx_PlotTable[]) (void);
-extern void (*fx_OpcodeTable[]) (void);
+extern void (* const fx_OpcodeTable[]) (void);
 
 // Set this define if branches are relative to the instruction in the delay slot (I think they are)
 #define BRANCH_DELAY_RELATIVE
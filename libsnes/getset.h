@@ -187,6 +187,9 @@
 #include "obc1.h"
 #include "seta.h"
 #include "bsx.h"
+#include "dirty.h"
+#include "dma.h"
+#include "fxemu.h"
 
 #define addCyclesInMemoryAccess \
 	if (!CPU.InDMAorHDMA) \
@@ -208,7 +211,7 @@
 			S9xDoHEventProcessing(); \
 	}
 
-extern uint8	OpenBus;
+extern S9X_TLS uint8	OpenBus;
 
 static inline int32 memory_speed (uint32 address)
 {
@@ -280,6 +283,7 @@ inline uint8 S9xGetByte (uint32 Address)
 			return (byte);
 
 		case CMemory::MAP_BWRAM:
+			S9xSA1Sync();
 			byte = *(Memory.BWRAM + ((Address & 0x7fff) - 0x6000));
 			addCyclesInMemoryAccess;
 			return (byte);
@@ -324,6 +328,22 @@ inline uint8 S9xGetByte (uint32 Address)
 			addCyclesInMemoryAccess;
 			return (byte);
 
+		case CMemory::MAP_SUPERFX_RAM:
+			S9xSuperFXSync();
+			return (S9xGetByte(Address));
+
+		case CMemory::MAP_SA1_IRAM:
+			S9xSA1Sync();
+			byte = *(Memory.FillRAM + (Address & 0xffff));
+			addCyclesInMemoryAccess;
+			return (byte);
+
+		case CMemory::MAP_SA1_BWRAM:
+			S9xSA1Sync();
+			byte = *(Memory.SRAM + (Address & 0x1ffff));
+			addCyclesInMemoryAccess;
+			return (byte);
+
 		case CMemory::MAP_NONE:
 		default:
 			byte = OpenBus;
@@ -423,6 +443,7 @@ inline uint16 S9xGetWord (uint32 Address, enum s9xwrap_t w = WRAP_NONE)
 			return (word);
 
 		case CMemory::MAP_BWRAM:
+			S9xSA1Sync();
 			word = READ_WORD(Memory.BWRAM + ((Address & 0x7fff) - 0x6000));
 			addCyclesInMemoryAccess_x2;
 			return (word);
@@ -483,6 +504,22 @@ inline uint16 S9xGetWord (uint32 Address, enum s9xwrap_t w = WRAP_NONE)
 			addCyclesInMemoryAccess;
 			return (word);
 
+		case CMemory::MAP_SUPERFX_RAM:
+			S9xSuperFXSync();
+			return (S9xGetWord(Address, w));
+
+		case CMemory::MAP_SA1_IRAM:
+			S9xSA1Sync();
+			word = READ_WORD(Memory.FillRAM + (Address & 0xffff));
+			addCyclesInMemoryAccess_x2;
+			return (word);
+
+		case CMemory::MAP_SA1_BWRAM:
+			S9xSA1Sync();
+			word = READ_WORD(Memory.SRAM + (Address & 0x1ffff));
+			addCyclesInMemoryAccess_x2;
+			return (word);
+
 		case CMemory::MAP_NONE:
 		default:
 			word = OpenBus | (OpenBus << 8);
@@ -500,6 +537,8 @@ inline void S9xSetByte (uint8 Byte, uint32 Address)
 	if (SetAddress >= (uint8 *) CMemory::MAP_LAST)
 	{
 		*(SetAddress + (Address & 0xffff)) = Byte;
+		S9X_DIRTY_POINTER(SetAddress + (Address & 0xffff));
+		S9X_HDMA_WATCH(SetAddress + (Address & 0xffff));
 		addCyclesInMemoryAccess;
 		return;
 	}
@@ -523,6 +562,7 @@ inline void S9xSetByte (uint8 Byte, uint32 Address)
 			if (Memory.SRAMMask)
 			{
 				*(Memory.SRAM + ((((Address & 0xff0000) >> 1) | (Address & 0x7fff)) & Memory.SRAMMask)) = Byte;
+				S9X_DIRTY(S9X_DIRTY_SRAM, (((Address & 0xff0000) >> 1) | (Address & 0x7fff)) & Memory.SRAMMask);
 				CPU.SRAMModified = TRUE;
 			}
 
@@ -543,6 +583,7 @@ inline void S9xSetByte (uint8 Byte, uint32 Address)
 			if (Memory.SRAMMask)
 			{
 				*(Memory.SRAM + (((Address & 0x7fff) - 0x6000 + ((Address & 0xf0000) >> 3)) & Memory.SRAMMask)) = Byte;
+				S9X_DIRTY(S9X_DIRTY_SRAM, ((Address & 0x7fff) - 0x6000 + ((Address & 0xf0000) >> 3)) & Memory.SRAMMask);
 				CPU.SRAMModified = TRUE;
 			}
 
@@ -550,13 +591,16 @@ inline void S9xSetByte (uint8 Byte, uint32 Address)
 			return;
 
 		case CMemory::MAP_BWRAM:
+			S9xSA1Sync();
 			*(Memory.BWRAM + ((Address & 0x7fff) - 0x6000)) = Byte;
+			S9X_DIRTY_POINTER(Memory.BWRAM + ((Address & 0x7fff) - 0x6000));
 			CPU.SRAMModified = TRUE;
 			addCyclesInMemoryAccess;
 			return;
 
 		case CMemory::MAP_SA1RAM:
 			*(Memory.SRAM + (Address & 0xffff)) = Byte;
+			S9X_DIRTY(S9X_DIRTY_SRAM, Address & 0xffff);
 			addCyclesInMemoryAccess;
 			return;
 
@@ -590,6 +634,25 @@ inline void S9xSetByte (uint8 Byte, uint32 Address)
 			addCyclesInMemoryAccess;
 			return;
 
+		case CMemory::MAP_SUPERFX_RAM:
+			S9xSuperFXSync();
+			S9xSetByte(Byte, Address);
+			return;
+
+		case CMemory::MAP_SA1_IRAM:
+			S9xSA1Sync();
+			*(Memory.FillRAM + (Address & 0xffff)) = Byte;
+			S9X_DIRTY_POINTER(Memory.FillRAM + (Address & 0xffff));
+			addCyclesInMemoryAccess;
+			return;
+
+		case CMemory::MAP_SA1_BWRAM:
+			S9xSA1Sync();
+			*(Memory.SRAM + (Address & 0x1ffff)) = Byte;
+			S9X_DIRTY_POINTER(Memory.SRAM + (Address & 0x1ffff));
+			addCyclesInMemoryAccess;
+			return;
+
 		case CMemory::MAP_NONE:
 		default:
 			addCyclesInMemoryAccess;
@@ -640,6 +703,10 @@ inline void S9xSetWord (uint16 Word, uint32 Address, enum s9xwrap_t w = WRAP_NON
 	if (SetAddress >= (uint8 *) CMemory::MAP_LAST)
 	{
 		WRITE_WORD(SetAddress + (Address & 0xffff), Word);
+		S9X_DIRTY_POINTER(SetAddress + (Address & 0xffff));
+		S9X_DIRTY_POINTER(SetAddress + (Address & 0xffff) + 1);
+		S9X_HDMA_WATCH(SetAddress + (Address & 0xffff));
+		S9X_HDMA_WATCH(SetAddress + (Address & 0xffff) + 1);
 		addCyclesInMemoryAccess_x2;
 		return;
 	}
@@ -695,13 +762,19 @@ inline void S9xSetWord (uint16 Word, uint32 Address, enum s9xwrap_t w = WRAP_NON
 			if (Memory.SRAMMask)
 			{
 				if (Memory.SRAMMask >= MEMMAP_MASK)
+				{
 					WRITE_WORD(Memory.SRAM + ((((Address & 0xff0000) >> 1) | (Address & 0x7fff)) & Memory.SRAMMask), Word);
+					S9X_DIRTY(S9X_DIRTY_SRAM, ((((Address & 0xff0000) >> 1) | (Address & 0x7fff)) & Memory.SRAMMask) + 1);
+				}
 				else
 				{
 					*(Memory.SRAM + ((((Address & 0xff0000) >> 1) | (Address & 0x7fff)) & Memory.SRAMMask)) = (uint8) Word;
 					*(Memory.SRAM + (((((Address + 1) & 0xff0000) >> 1) | ((Address + 1) & 0x7fff)) & Memory.SRAMMask)) = Word >> 8;
+					S9X_DIRTY(S9X_DIRTY_SRAM, ((((Address + 1) & 0xff0000) >> 1) | ((Address + 1) & 0x7fff)) & Memory.SRAMMask);
 				}
 
+				S9X_DIRTY(S9X_DIRTY_SRAM, (((Address & 0xff0000) >> 1) | (Address & 0x7fff)) & Memory.SRAMMask);
+
 				CPU.SRAMModified = TRUE;
 			}
 
@@ -729,13 +802,19 @@ inline void S9xSetWord (uint16 Word, uint32 Address, enum s9xwrap_t w = WRAP_NON
 			if (Memory.SRAMMask)
 			{
 				if (Memory.SRAMMask >= MEMMAP_MASK)
+				{
 					WRITE_WORD(Memory.SRAM + (((Address & 0x7fff) - 0x6000 + ((Address & 0xf0000) >> 3)) & Memory.SRAMMask), Word);
+					S9X_DIRTY(S9X_DIRTY_SRAM, (((Address & 0x7fff) - 0x6000 + ((Address & 0xf0000) >> 3)) & Memory.SRAMMask) + 1);
+				}
 				else
 				{
 					*(Memory.SRAM + (((Address & 0x7fff) - 0x6000 + ((Address & 0xf0000) >> 3)) & Memory.SRAMMask)) = (uint8) Word;
 					*(Memory.SRAM + ((((Address + 1) & 0x7fff) - 0x6000 + (((Address + 1) & 0xf0000) >> 3)) & Memory.SRAMMask)) = Word >> 8;
+					S9X_DIRTY(S9X_DIRTY_SRAM, (((Address + 1) & 0x7fff) - 0x6000 + (((Address + 1) & 0xf0000) >> 3)) & Memory.SRAMMask);
 				}
 
+				S9X_DIRTY(S9X_DIRTY_SRAM, ((Address & 0x7fff) - 0x6000 + ((Address & 0xf0000) >> 3)) & Memory.SRAMMask);
+
 				CPU.SRAMModified = TRUE;
 			}
 
@@ -743,13 +822,18 @@ inline void S9xSetWord (uint16 Word, uint32 Address, enum s9xwrap_t w = WRAP_NON
 			return;
 
 		case CMemory::MAP_BWRAM:
+			S9xSA1Sync();
 			WRITE_WORD(Memory.BWRAM + ((Address & 0x7fff) - 0x6000), Word);
+			S9X_DIRTY_POINTER(Memory.BWRAM + ((Address & 0x7fff) - 0x6000));
+			S9X_DIRTY_POINTER(Memory.BWRAM + ((Address & 0x7fff) - 0x6000) + 1);
 			CPU.SRAMModified = TRUE;
 			addCyclesInMemoryAccess_x2;
 			return;
 
 		case CMemory::MAP_SA1RAM:
 			WRITE_WORD(Memory.SRAM + (Address & 0xffff), Word);
+			S9X_DIRTY(S9X_DIRTY_SRAM, Address & 0xffff);
+			S9X_DIRTY(S9X_DIRTY_SRAM, (Address & 0xffff) + 1);
 			addCyclesInMemoryAccess_x2;
 			return;
 
@@ -861,6 +945,27 @@ inline void S9xSetWord (uint16 Word, uint32 Address, enum s9xwrap_t w = WRAP_NON
 				return;
 			}
 
+		case CMemory::MAP_SUPERFX_RAM:
+			S9xSuperFXSync();
+			S9xSetWord(Word, Address, w, o);
+			return;
+
+		case CMemory::MAP_SA1_IRAM:
+			S9xSA1Sync();
+			WRITE_WORD(Memory.FillRAM + (Address & 0xffff), Word);
+			S9X_DIRTY_POINTER(Memory.FillRAM + (Address & 0xffff));
+			S9X_DIRTY_POINTER(Memory.FillRAM + (Address & 0xffff) + 1);
+			addCyclesInMemoryAccess_x2;
+			return;
+
+		case CMemory::MAP_SA1_BWRAM:
+			S9xSA1Sync();
+			WRITE_WORD(Memory.SRAM + (Address & 0x1ffff), Word);
+			S9X_DIRTY_POINTER(Memory.SRAM + (Address & 0x1ffff));
+			S9X_DIRTY_POINTER(Memory.SRAM + (Address & 0x1ffff) + 1);
+			addCyclesInMemoryAccess_x2;
+			return;
+
 		case CMemory::MAP_NONE:
 		default:
 			addCyclesInMemoryAccess_x2;
@@ -868,6 +973,69 @@ inline void S9xSetWord (uint16 Word, uint32 Address, enum s9xwrap_t w = WRAP_NON
 	}
 }
 
+// Direct page and stack accesses stay in bank 0, where $0000-$1fff is WRAM on almost every cart.
+// Those go straight to Memory.RAM, everything else (and the word accesses that would be split)
+// takes the general path.
+inline uint8 S9xGetByteBank0 (uint32 Address)
+{
+	if (Address < 0x2000 && Memory.LowRAMMapped)
+	{
+		int32	speed = SLOW_ONE_CYCLE;
+		uint8	byte = Memory.RAM[Address];
+		addCyclesInMemoryAccess;
+		return (byte);
+	}
+
+	return (S9xGetByte(Address));
+}
+
+inline uint16 S9xGetWordBank0 (uint32 Address, enum s9xwrap_t w = WRAP_NONE)
+{
+	uint32	mask = MEMMAP_MASK & (w == WRAP_PAGE ? 0xff : (w == WRAP_BANK ? 0xffff : 0xffffff));
+	if (Address < 0x2000 && (Address & mask) != mask && Memory.LowRAMMapped)
+	{
+		int32	speed = SLOW_ONE_CYCLE;
+		uint16	word = READ_WORD(Memory.RAM + Address);
+		addCyclesInMemoryAccess_x2;
+		return (word);
+	}
+
+	return (S9xGetWord(Address, w));
+}
+
+inline void S9xSetByteBank0 (uint8 Byte, uint32 Address)
+{
+	if (Address < 0x2000 && Memory.LowRAMMapped)
+	{
+		int32	speed = SLOW_ONE_CYCLE;
+		Memory.RAM[Address] = Byte;
+		S9X_DIRTY_POINTER(Memory.RAM + Address);
+		S9X_HDMA_WATCH(Memory.RAM + Address);
+		addCyclesInMemoryAccess;
+		return;
+	}
+
+	S9xSetByte(Byte, Address);
+}
+
+inline void S9xSetWordBank0 (uint16 Word, uint32 Address, enum s9xwrap_t w = WRAP_NONE, enum s9xwriteorder_t o = WRITE_01)
+{
+	uint32	mask = MEMMAP_MASK & (w == WRAP_PAGE ? 0xff : (w == WRAP_BANK ? 0xffff : 0xffffff));
+	if (Address < 0x2000 && (Address & mask) != mask && Memory.LowRAMMapped)
+	{
+		int32	speed = SLOW_ONE_CYCLE;
+		WRITE_WORD(Memory.RAM + Address, Word);
+		S9X_DIRTY_POINTER(Memory.RAM + Address);
+		S9X_DIRTY_POINTER(Memory.RAM + Address + 1);
+		S9X_HDMA_WATCH(Memory.RAM + Address);
+		S9X_HDMA_WATCH(Memory.RAM + Address + 1);
+		addCyclesInMemoryAccess_x2;
+		return;
+	}
+
+	S9xSetWord(Word, Address, w, o);
+}
+
 inline void S9xSetPCBase (uint32 Address)
 {
 	Registers.PBPC = Address & 0xffffff;
@@ -909,6 +1077,7 @@ inline void S9xSetPCBase (uint32 Address)
 			return;
 
 		case CMemory::MAP_BWRAM:
+			S9xSA1Sync();
 			CPU.PCBase = Memory.BWRAM - 0x6000 - (Address & 0x8000);
 			return;
 
@@ -932,6 +1101,21 @@ inline void S9xSetPCBase (uint32 Address)
 			CPU.PCBase = S9xGetBasePointerBSX(Address);
 			return;
 
+		case CMemory::MAP_SUPERFX_RAM:
+			S9xSuperFXSync();
+			S9xSetPCBase(Address);
+			return;
+
+		case CMemory::MAP_SA1_IRAM:
+			S9xSA1Sync();
+			CPU.PCBase = Memory.FillRAM;
+			return;
+
+		case CMemory::MAP_SA1_BWRAM:
+			S9xSA1Sync();
+			CPU.PCBase = Memory.SRAM + (Address & 0x10000);
+			return;
+
 		case CMemory::MAP_NONE:
 		default:
 			CPU.PCBase = NULL;
@@ -964,6 +1148,7 @@ inline uint8 * S9xGetBasePointer (uint32 Address)
 			return (Memory.SRAM + (((Address & 0x7fff) - 0x6000 + ((Address & 0xf0000) >> 3)) & Memory.SRAMMask) - (Address & 0xffff));
 
 		case CMemory::MAP_BWRAM:
+			S9xSA1Sync();
 			return (Memory.BWRAM - 0x6000 - (Address & 0x8000));
 
 		case CMemory::MAP_SA1RAM:
@@ -978,6 +1163,18 @@ inline uint8 * S9xGetBasePointer (uint32 Address)
 		case CMemory::MAP_OBC_RAM:
 			return (S9xGetBasePointerOBC1(Address & 0xffff));
 
+		case CMemory::MAP_SUPERFX_RAM:
+			S9xSuperFXSync();
+			return (S9xGetBasePointer(Address));
+
+		case CMemory::MAP_SA1_IRAM:
+			S9xSA1Sync();
+			return (Memory.FillRAM);
+
+		case CMemory::MAP_SA1_BWRAM:
+			S9xSA1Sync();
+			return (Memory.SRAM + (Address & 0x10000));
+
 		case CMemory::MAP_NONE:
 		default:
 			return (NULL);
@@ -1009,6 +1206,7 @@ inline uint8 * S9xGetMemPointer (uint32 Address)
 			return (Memory.SRAM + (((Address & 0x7fff) - 0x6000 + ((Address & 0xf0000) >> 3)) & Memory.SRAMMask));
 
 		case CMemory::MAP_BWRAM:
+			S9xSA1Sync();
 			return (Memory.BWRAM - 0x6000 + (Address & 0x7fff));
 
 		case CMemory::MAP_SA1RAM:
@@ -1023,6 +1221,18 @@ inline uint8 * S9xGetMemPointer (uint32 Address)
 		case CMemory::MAP_OBC_RAM:
 			return (S9xGetMemPointerOBC1(Address & 0xffff));
 
+		case CMemory::MAP_SUPERFX_RAM:
+			S9xSuperFXSync();
+			return (S9xGetMemPointer(Address));
+
+		case CMemory::MAP_SA1_IRAM:
+			S9xSA1Sync();
+			return (Memory.FillRAM + (Address & 0xffff));
+
+		case CMemory::MAP_SA1_BWRAM:
+			S9xSA1Sync();
+			return (Memory.SRAM + (Address & 0x1ffff));
+
 		case CMemory::MAP_NONE:
 		default:
 			return (NULL);
@@ -186,10 +186,12 @@
 #include "screenshot.h"
 #include "font.h"
 #include "display.h"
+#include "profiler.h"
+#include "renderpool.h"
 
-extern struct SCheatData		Cheat;
-extern struct SLineData			LineData[240];
-extern struct SLineMatrixData	LineMatrixData[240];
+extern S9X_TLS struct SCheatData		Cheat;
+extern S9X_TLS struct SLineData			LineData[240];
+extern S9X_TLS struct SLineMatrixData	LineMatrixData[240];
 
 void S9xComputeClipWindows (void);
 
@@ -409,6 +411,7 @@ void S9xEndScreenRefresh (void)
 	if (IPPU.RenderThisFrame)
 	{
 		FLUSH_REDRAW();
+		S9xRenderPoolWait();
 
 		if (GFX.DoInterlace && GFX.InterlaceFrame == 0)
 		{
@@ -478,6 +481,8 @@ void S9xEndScreenRefresh (void)
 
 void RenderLine (uint8 C)
 {
+	S9X_PROFILE(S9X_PROFILE_RENDER_LINE);
+
 	if (IPPU.RenderThisFrame)
 	{
 		LineData[C].BG[0].VOffset = PPU.BG[0].VOffset + 1;
@@ -645,8 +650,21 @@ static inline void RenderScreen (bool8 sub)
 	DrawBackdrop();
 }
 
+void S9xRenderScreenLines (void)
+{
+	if (PPU.BGMode == 5 || PPU.BGMode == 6 || IPPU.PseudoHires ||
+		((Memory.FillRAM[0x2130] & 0x30) != 0x30 && (Memory.FillRAM[0x2130] & 2) && (Memory.FillRAM[0x2131] & 0x3f) && (Memory.FillRAM[0x212d] & 0x1f)))
+		// If hires (Mode 5/6 or pseudo-hires) or math is to be done
+		// involving the subscreen, then we need to render the subscreen...
+		RenderScreen(TRUE);
+
+	RenderScreen(FALSE);
+}
+
 void S9xUpdateScreen (void)
 {
+	S9X_PROFILE(S9X_PROFILE_UPDATE_SCREEN);
+
 	if (IPPU.OBJChanged || IPPU.InterlaceOBJ)
 		SetupOBJ();
 
@@ -672,6 +690,9 @@ void S9xUpdateScreen (void)
 		{
 			if (!IPPU.DoubleWidthPixels && (PPU.BGMode == 5 || PPU.BGMode == 6 || IPPU.PseudoHires))
 			{
+				// earlier lines are about to be rewritten, they have to be there first
+				S9xRenderPoolWait();
+
 			#ifdef USE_OPENGL
 				if (Settings.OpenGLEnable && GFX.RealPPL == 256)
 				{
@@ -711,6 +732,8 @@ void S9xUpdateScreen (void)
 
 			if (!IPPU.DoubleHeightPixels && IPPU.Interlace)
 			{
+				S9xRenderPoolWait();
+
 				IPPU.DoubleHeightPixels = TRUE;
 				IPPU.RenderedScreenHeight = PPU.ScreenHeight << 1;
 				GFX.PPL = GFX.RealPPL << 1;
@@ -721,6 +744,8 @@ void S9xUpdateScreen (void)
 			}
 			else if (IPPU.DoubleHeightPixels && !IPPU.Interlace)
 			{
+				S9xRenderPoolWait();
+
 				for (register int32 y = 0; y < (int32) GFX.StartY; y++)
 					memmove(GFX.Screen + y * GFX.RealPPL, GFX.Screen + y * GFX.PPL, IPPU.RenderedScreenWidth * sizeof(uint16));
 
@@ -734,13 +759,7 @@ void S9xUpdateScreen (void)
 		if ((Memory.FillRAM[0x2130] & 0x30) != 0x30 && (Memory.FillRAM[0x2131] & 0x3f))
 			GFX.FixedColour = BUILD_PIXEL(IPPU.XB[PPU.FixedColourRed], IPPU.XB[PPU.FixedColourGreen], IPPU.XB[PPU.FixedColourBlue]);
 
-		if (PPU.BGMode == 5 || PPU.BGMode == 6 || IPPU.PseudoHires ||
-			((Memory.FillRAM[0x2130] & 0x30) != 0x30 && (Memory.FillRAM[0x2130] & 2) && (Memory.FillRAM[0x2131] & 0x3f) && (Memory.FillRAM[0x212d] & 0x1f)))
-			// If hires (Mode 5/6 or pseudo-hires) or math is to be done
-			// involving the subscreen, then we need to render the subscreen...
-			RenderScreen(TRUE);
-
-		RenderScreen(FALSE);
+		S9xRenderPoolDispatch();
 	}
 	else
 	{
@@ -2022,8 +2041,8 @@ static void DisplayStringFromBottom (const char *string, int linesFromBottom, in
 static void DisplayFrameRate (void)
 {
 	char	string[10];
-	static uint32 lastFrameCount = 0, calcFps = 0;
-	static time_t lastTime = time(NULL);
+	static S9X_TLS uint32 lastFrameCount = 0, calcFps = 0;
+	static S9X_TLS_CLASS time_t lastTime = time(NULL);
 
 	time_t currTime = time(NULL);
 	if (lastTime != currTime) {
@@ -270,6 +270,9 @@ struct SBG
 	uint8	*BufferFlip;
 	uint8	*Buffered;
 	uint8	*BufferedFlip;
+	uint32	*Stamp;
+	uint32	*StampFlip;
+	bool8	TilePairs;		// hires tiles are converted together with the next one
 	bool8	DirectColourMode;
 };
 
@@ -294,11 +297,11 @@ struct SLineMatrixData
 	short	M7VOFS;
 };
 
-extern uint16		BlackColourMap[256];
-extern uint16		DirectColourMaps[8][256];
+extern S9X_TLS uint16		BlackColourMap[256];
+extern S9X_TLS uint16		DirectColourMaps[8][256];
 extern uint8		mul_brightness[16][32];
-extern struct SBG	BG;
-extern struct SGFX	GFX;
+extern S9X_TLS struct SBG	BG;
+extern S9X_TLS struct SGFX	GFX;
 
 #define H_FLIP		0x4000
 #define V_FLIP		0x8000
@@ -341,6 +344,8 @@ inline uint16 COLOR_SUB (uint16 C1, uint16 C2)
 void S9xStartScreenRefresh (void);
 void S9xEndScreenRefresh (void);
 void S9xUpdateScreen (void);
+// rasterizes lines GFX.StartY to GFX.EndY from the PPU state of the calling thread
+void S9xRenderScreenLines (void);
 void S9xBuildDirectColourMaps (void);
 void RenderLine (uint8);
 void S9xComputeClipWindows (void);
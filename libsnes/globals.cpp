@@ -192,80 +192,82 @@
 #include "missing.h"
 #endif
 
-struct SCPUState		CPU;
-struct SICPU			ICPU;
-struct SRegisters		Registers;
-struct SPPU				PPU;
-struct InternalPPU		IPPU;
-struct SDMA				DMA[8];
-struct STimings			Timings;
-struct SGFX				GFX;
-struct SBG				BG;
-struct SLineData		LineData[240];
-struct SLineMatrixData	LineMatrixData[240];
-struct SDSP0			DSP0;
-struct SDSP1			DSP1;
-struct SDSP2			DSP2;
-struct SDSP3			DSP3;
-struct SDSP4			DSP4;
-struct SSA1				SA1;
-struct SSA1Registers	SA1Registers;
-struct FxRegs_s			GSU;
-struct FxInfo_s			SuperFX;
-struct SST010			ST010;
-struct SST011			ST011;
-struct SST018			ST018;
-struct SOBC1			OBC1;
-struct SSPC7110Snapshot	s7snap;
-struct SSRTCSnapshot	srtcsnap;
-struct SRTCData			RTCData;
-struct SBSX				BSX;
-struct SMulti			Multi;
-struct SSettings		Settings;
-struct SSNESGameFixes	SNESGameFixes;
+S9X_TLS struct SCPUState		CPU;
+S9X_TLS struct SICPU			ICPU;
+S9X_TLS struct SRegisters		Registers;
+S9X_TLS struct SPPU				PPU;
+S9X_TLS struct InternalPPU		IPPU;
+S9X_TLS struct SDMA				DMA[8];
+S9X_TLS struct SHDMAProgram		HDMAPrograms[8];
+S9X_TLS struct SHDMAWatch		HDMAWatch;
+S9X_TLS struct STimings			Timings;
+S9X_TLS struct SGFX				GFX;
+S9X_TLS struct SBG				BG;
+S9X_TLS struct SLineData		LineData[240];
+S9X_TLS struct SLineMatrixData	LineMatrixData[240];
+S9X_TLS struct SDSP0			DSP0;
+S9X_TLS struct SDSP1			DSP1;
+S9X_TLS struct SDSP2			DSP2;
+S9X_TLS struct SDSP3			DSP3;
+S9X_TLS struct SDSP4			DSP4;
+S9X_TLS struct SSA1				SA1;
+S9X_TLS struct SSA1Registers	SA1Registers;
+S9X_TLS struct FxRegs_s			GSU;
+S9X_TLS struct FxInfo_s			SuperFX;
+S9X_TLS struct SST010			ST010;
+S9X_TLS struct SST011			ST011;
+S9X_TLS struct SST018			ST018;
+S9X_TLS struct SOBC1			OBC1;
+S9X_TLS struct SSPC7110Snapshot	s7snap;
+S9X_TLS struct SSRTCSnapshot	srtcsnap;
+S9X_TLS struct SRTCData			RTCData;
+S9X_TLS struct SBSX				BSX;
+S9X_TLS struct SMulti			Multi;
+S9X_TLS struct SSettings		Settings;
+S9X_TLS struct SSNESGameFixes	SNESGameFixes;
 #ifdef NETPLAY_SUPPORT
-struct SNetPlay			NetPlay;
+S9X_TLS struct SNetPlay			NetPlay;
 #endif
 #ifdef DEBUGGER
-struct Missing			missing;
+S9X_TLS struct Missing			missing;
 #endif
-struct SCheatData		Cheat;
-struct Watch			watches[16];
-CMemory					Memory;
+S9X_TLS struct SCheatData		Cheat;
+S9X_TLS struct Watch			watches[16];
+S9X_TLS CMemory					Memory;
 
-char	String[513];
-uint8	OpenBus = 0;
-uint8	*HDMAMemPointers[8];
-uint16	BlackColourMap[256];
-uint16	DirectColourMaps[8][256];
+S9X_TLS char	String[513];
+S9X_TLS uint8	OpenBus = 0;
+S9X_TLS uint8	*HDMAMemPointers[8];
+S9X_TLS uint16	BlackColourMap[256];
+S9X_TLS uint16	DirectColourMaps[8][256];
 
 SnesModel	M1SNES = { 1, 3, 2 };
 SnesModel	M2SNES = { 2, 4, 3 };
-SnesModel	*Model = &M1SNES;
+S9X_TLS SnesModel	*Model = &M1SNES;
 
 #ifdef GFX_MULTI_FORMAT
-uint32	RED_LOW_BIT_MASK           = RED_LOW_BIT_MASK_RGB565;
-uint32	GREEN_LOW_BIT_MASK         = GREEN_LOW_BIT_MASK_RGB565;
-uint32	BLUE_LOW_BIT_MASK          = BLUE_LOW_BIT_MASK_RGB565;
-uint32	RED_HI_BIT_MASK            = RED_HI_BIT_MASK_RGB565;
-uint32	GREEN_HI_BIT_MASK          = GREEN_HI_BIT_MASK_RGB565;
-uint32	BLUE_HI_BIT_MASK           = BLUE_HI_BIT_MASK_RGB565;
-uint32	MAX_RED                    = MAX_RED_RGB565;
-uint32	MAX_GREEN                  = MAX_GREEN_RGB565;
-uint32	MAX_BLUE                   = MAX_BLUE_RGB565;
-uint32	SPARE_RGB_BIT_MASK         = SPARE_RGB_BIT_MASK_RGB565;
-uint32	GREEN_HI_BIT               = (MAX_GREEN_RGB565 + 1) >> 1;
-uint32	RGB_LOW_BITS_MASK          = (RED_LOW_BIT_MASK_RGB565 | GREEN_LOW_BIT_MASK_RGB565 | BLUE_LOW_BIT_MASK_RGB565);
-uint32	RGB_HI_BITS_MASK           = (RED_HI_BIT_MASK_RGB565  | GREEN_HI_BIT_MASK_RGB565  | BLUE_HI_BIT_MASK_RGB565);
-uint32	RGB_HI_BITS_MASKx2         = (RED_HI_BIT_MASK_RGB565  | GREEN_HI_BIT_MASK_RGB565  | BLUE_HI_BIT_MASK_RGB565) << 1;
-uint32	RGB_REMOVE_LOW_BITS_MASK   = ~RGB_LOW_BITS_MASK;
-uint32	FIRST_COLOR_MASK           = FIRST_COLOR_MASK_RGB565;
-uint32	SECOND_COLOR_MASK          = SECOND_COLOR_MASK_RGB565;
-uint32	THIRD_COLOR_MASK           = THIRD_COLOR_MASK_RGB565;
-uint32	ALPHA_BITS_MASK            = ALPHA_BITS_MASK_RGB565;
-uint32	FIRST_THIRD_COLOR_MASK     = 0;
-uint32	TWO_LOW_BITS_MASK          = 0;
-uint32	HIGH_BITS_SHIFTED_TWO_MASK = 0;
+S9X_TLS uint32	RED_LOW_BIT_MASK           = RED_LOW_BIT_MASK_RGB565;
+S9X_TLS uint32	GREEN_LOW_BIT_MASK         = GREEN_LOW_BIT_MASK_RGB565;
+S9X_TLS uint32	BLUE_LOW_BIT_MASK          = BLUE_LOW_BIT_MASK_RGB565;
+S9X_TLS uint32	RED_HI_BIT_MASK            = RED_HI_BIT_MASK_RGB565;
+S9X_TLS uint32	GREEN_HI_BIT_MASK          = GREEN_HI_BIT_MASK_RGB565;
+S9X_TLS uint32	BLUE_HI_BIT_MASK           = BLUE_HI_BIT_MASK_RGB565;
+S9X_TLS uint32	MAX_RED                    = MAX_RED_RGB565;
+S9X_TLS uint32	MAX_GREEN                  = MAX_GREEN_RGB565;
+S9X_TLS uint32	MAX_BLUE                   = MAX_BLUE_RGB565;
+S9X_TLS uint32	SPARE_RGB_BIT_MASK         = SPARE_RGB_BIT_MASK_RGB565;
+S9X_TLS uint32	GREEN_HI_BIT               = (MAX_GREEN_RGB565 + 1) >> 1;
+S9X_TLS uint32	RGB_LOW_BITS_MASK          = (RED_LOW_BIT_MASK_RGB565 | GREEN_LOW_BIT_MASK_RGB565 | BLUE_LOW_BIT_MASK_RGB565);
+S9X_TLS uint32	RGB_HI_BITS_MASK           = (RED_HI_BIT_MASK_RGB565  | GREEN_HI_BIT_MASK_RGB565  | BLUE_HI_BIT_MASK_RGB565);
+S9X_TLS uint32	RGB_HI_BITS_MASKx2         = (RED_HI_BIT_MASK_RGB565  | GREEN_HI_BIT_MASK_RGB565  | BLUE_HI_BIT_MASK_RGB565) << 1;
+S9X_TLS uint32	RGB_REMOVE_LOW_BITS_MASK   = ~(RED_LOW_BIT_MASK_RGB565 | GREEN_LOW_BIT_MASK_RGB565 | BLUE_LOW_BIT_MASK_RGB565);
+S9X_TLS uint32	FIRST_COLOR_MASK           = FIRST_COLOR_MASK_RGB565;
+S9X_TLS uint32	SECOND_COLOR_MASK          = SECOND_COLOR_MASK_RGB565;
+S9X_TLS uint32	THIRD_COLOR_MASK           = THIRD_COLOR_MASK_RGB565;
+S9X_TLS uint32	ALPHA_BITS_MASK            = ALPHA_BITS_MASK_RGB565;
+S9X_TLS uint32	FIRST_THIRD_COLOR_MASK     = 0;
+S9X_TLS uint32	TWO_LOW_BITS_MASK          = 0;
+S9X_TLS uint32	HIGH_BITS_SHIFTED_TWO_MASK = 0;
 #endif
 
 uint16 SignExtend[2] =
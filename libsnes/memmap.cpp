@@ -212,8 +212,8 @@
 #define min(a, b) (((a) < (b)) ? (a) : (b))
 #endif
 
-static bool8	stopMovie = TRUE;
-static char		LastRomFilename[PATH_MAX + 1] = "";
+static S9X_TLS bool8	stopMovie = TRUE;
+static S9X_TLS char		LastRomFilename[PATH_MAX + 1] = "";
 
 // from NSRT
 static const char	*nintendo_licensees[] =
@@ -1079,6 +1079,20 @@ bool8 CMemory::Init (void)
 	IPPU.TileCached[TILE_4BIT_EVEN] = (uint8 *) malloc(MAX_4BIT_TILES);
 	IPPU.TileCached[TILE_4BIT_ODD]  = (uint8 *) malloc(MAX_4BIT_TILES);
 
+	IPPU.TileStamp[TILE_2BIT]       = (uint32 *) malloc(MAX_2BIT_TILES * 4);
+	IPPU.TileStamp[TILE_4BIT]       = (uint32 *) malloc(MAX_4BIT_TILES * 4);
+	IPPU.TileStamp[TILE_8BIT]       = (uint32 *) malloc(MAX_8BIT_TILES * 4);
+	IPPU.TileStamp[TILE_2BIT_EVEN]  = (uint32 *) malloc(MAX_2BIT_TILES * 4);
+	IPPU.TileStamp[TILE_2BIT_ODD]   = (uint32 *) malloc(MAX_2BIT_TILES * 4);
+	IPPU.TileStamp[TILE_4BIT_EVEN]  = (uint32 *) malloc(MAX_4BIT_TILES * 4);
+	IPPU.TileStamp[TILE_4BIT_ODD]   = (uint32 *) malloc(MAX_4BIT_TILES * 4);
+
+	IPPU.VRAMGeneration             = (uint32 *) malloc(MAX_VRAM_BLOCKS * 4);
+
+#ifdef S9X_THREADED_DISPATCH
+	ICPU.Blocks = (struct SBlock *) malloc(S9X_BLOCK_CACHE_SIZE * sizeof(struct SBlock));
+#endif
+
 	if (!RAM || !SRAM || !VRAM || !ROM ||
 		!IPPU.TileCache[TILE_2BIT]       ||
 		!IPPU.TileCache[TILE_4BIT]       ||
@@ -1093,7 +1107,19 @@ bool8 CMemory::Init (void)
 		!IPPU.TileCached[TILE_2BIT_EVEN] ||
 		!IPPU.TileCached[TILE_2BIT_ODD]  ||
 		!IPPU.TileCached[TILE_4BIT_EVEN] ||
-		!IPPU.TileCached[TILE_4BIT_ODD])
+		!IPPU.TileCached[TILE_4BIT_ODD]  ||
+		!IPPU.TileStamp[TILE_2BIT]       ||
+		!IPPU.TileStamp[TILE_4BIT]       ||
+		!IPPU.TileStamp[TILE_8BIT]       ||
+		!IPPU.TileStamp[TILE_2BIT_EVEN]  ||
+		!IPPU.TileStamp[TILE_2BIT_ODD]   ||
+		!IPPU.TileStamp[TILE_4BIT_EVEN]  ||
+		!IPPU.TileStamp[TILE_4BIT_ODD]   ||
+		!IPPU.VRAMGeneration
+#ifdef S9X_THREADED_DISPATCH
+		|| !ICPU.Blocks
+#endif
+		)
     {
 		Deinit();
 		return (FALSE);
@@ -1120,6 +1146,21 @@ bool8 CMemory::Init (void)
 	ZeroMemory(IPPU.TileCached[TILE_4BIT_EVEN], MAX_4BIT_TILES);
 	ZeroMemory(IPPU.TileCached[TILE_4BIT_ODD],  MAX_4BIT_TILES);
 
+	ZeroMemory(IPPU.TileStamp[TILE_2BIT],       MAX_2BIT_TILES * 4);
+	ZeroMemory(IPPU.TileStamp[TILE_4BIT],       MAX_4BIT_TILES * 4);
+	ZeroMemory(IPPU.TileStamp[TILE_8BIT],       MAX_8BIT_TILES * 4);
+	ZeroMemory(IPPU.TileStamp[TILE_2BIT_EVEN],  MAX_2BIT_TILES * 4);
+	ZeroMemory(IPPU.TileStamp[TILE_2BIT_ODD],   MAX_2BIT_TILES * 4);
+	ZeroMemory(IPPU.TileStamp[TILE_4BIT_EVEN],  MAX_4BIT_TILES * 4);
+	ZeroMemory(IPPU.TileStamp[TILE_4BIT_ODD],   MAX_4BIT_TILES * 4);
+
+	ZeroMemory(IPPU.VRAMGeneration,             MAX_VRAM_BLOCKS * 4);
+
+#ifdef S9X_THREADED_DISPATCH
+	ZeroMemory(ICPU.Blocks, S9X_BLOCK_CACHE_SIZE * sizeof(struct SBlock));
+	ICPU.BlockGeneration = 1;
+#endif
+
 	// FillRAM uses first 32K of ROM image area, otherwise space just
 	// wasted. Might be read by the SuperFX code.
 
@@ -1186,8 +1227,28 @@ void CMemory::Deinit (void)
 			free(IPPU.TileCached[t]);
 			IPPU.TileCached[t] = NULL;
 		}
+
+		if (IPPU.TileStamp[t])
+		{
+			free(IPPU.TileStamp[t]);
+			IPPU.TileStamp[t] = NULL;
+		}
 	}
 
+	if (IPPU.VRAMGeneration)
+	{
+		free(IPPU.VRAMGeneration);
+		IPPU.VRAMGeneration = NULL;
+	}
+
+#ifdef S9X_THREADED_DISPATCH
+	if (ICPU.Blocks)
+	{
+		free(ICPU.Blocks);
+		ICPU.Blocks = NULL;
+	}
+#endif
+
 	Safe(NULL);
 	SafeANK(NULL);
 }
@@ -2109,8 +2170,8 @@ static uint32 caCRC32 (uint8 *array, uint32 size, uint32 crc32)
 
 char * CMemory::Safe (const char *s)
 {
-	static char	*safe = NULL;
-	static int	safe_len = 0;
+	static S9X_TLS char	*safe = NULL;
+	static S9X_TLS int	safe_len = 0;
 
 	if (s == NULL)
 	{
@@ -2148,8 +2209,8 @@ char * CMemory::Safe (const char *s)
 
 char * CMemory::SafeANK (const char *s)
 {
-	static char	*safe = NULL;
-	static int	safe_len = 0;
+	static S9X_TLS char	*safe = NULL;
+	static S9X_TLS int	safe_len = 0;
 
 	if (s == NULL)
 	{
@@ -2864,6 +2925,13 @@ void CMemory::map_WriteProtectROM (void)
 		if (BlockIsROM[c])
 			WriteMap[c] = (uint8 *) MAP_NONE;
 	}
+
+	// SA-1 and SuperFX carts share the bus with a second CPU, they keep the general accessors
+	LowRAMMapped = Map[0] == RAM && Map[1] == RAM && WriteMap[0] == RAM && WriteMap[1] == RAM &&
+		!Settings.SA1 && !Settings.SuperFX;
+
+	// what's ROM may have been writable until now
+	S9xFlushBlockCache();
 }
 
 void CMemory::Map_Initialize (void)
@@ -3135,6 +3203,17 @@ void CMemory::Map_SA1LoROMMap (void)
 		SA1.Map[c] = SA1.WriteMap[c] = (uint8 *) MAP_BWRAM_BITMAP;
 
 	BWRAM = SRAM;
+
+	// the S-CPU lets the SA-1 catch up before it touches I-RAM or BW-RAM, see S9xSA1Sync()
+	if (Settings.SA1CatchUp)
+	{
+		for (int c = 0x000; c < 0x400; c += 0x10)
+			Map[c + 3] = Map[c + 0x803] = WriteMap[c + 3] = WriteMap[c + 0x803] = (uint8 *) MAP_SA1_IRAM;
+
+		// banks $7e and $7f stay WRAM
+		for (int c = 0x400; c < 0x7e0; c++)
+			Map[c] = WriteMap[c] = (uint8 *) MAP_SA1_BWRAM;
+	}
 }
 
 void CMemory::Map_HiROMMap (void)
@@ -3285,7 +3364,7 @@ const char * CMemory::MapType (void)
 
 const char * CMemory::StaticRAMSize (void)
 {
-	static char	str[20];
+	static S9X_TLS char	str[20];
 
 	if (SRAMSize > 16)
 		strcpy(str, "Corrupt");
@@ -3297,7 +3376,7 @@ const char * CMemory::StaticRAMSize (void)
 
 const char * CMemory::Size (void)
 {
-	static char	str[20];
+	static S9X_TLS char	str[20];
 
 	if (Multi.cartType == 4)
 		strcpy(str, "N/A");
@@ -3312,7 +3391,7 @@ const char * CMemory::Size (void)
 
 const char * CMemory::Revision (void)
 {
-	static char	str[20];
+	static S9X_TLS char	str[20];
 
 	sprintf(str, "1.%d", HiROM ? ((ExtendedFormat != NOPE) ? ROM[0x40ffdb] : ROM[0xffdb]) : ROM[0x7fdb]);
 
@@ -3321,7 +3400,7 @@ const char * CMemory::Revision (void)
 
 const char * CMemory::KartContents (void)
 {
-	static char			str[64];
+	static S9X_TLS char			str[64];
 	static const char	*contents[3] = { "ROM", "ROM+RAM", "ROM+RAM+BAT" };
 
 	char	chip[16];
@@ -218,6 +218,9 @@ struct CMemory
 		MAP_SETA_DSP,
 		MAP_SETA_RISC,
 		MAP_BSX,
+		MAP_SUPERFX_RAM,
+		MAP_SA1_IRAM,
+		MAP_SA1_BWRAM,
 		MAP_NONE,
 		MAP_LAST
 	};
@@ -240,6 +243,7 @@ struct CMemory
 	uint8	*WriteMap[MEMMAP_NUM_BLOCKS];
 	uint8	BlockIsRAM[MEMMAP_NUM_BLOCKS];
 	uint8	BlockIsROM[MEMMAP_NUM_BLOCKS];
+	bool8	LowRAMMapped;	// $00:0000-1fff is plain WRAM for the S-CPU, see S9xGetByteBank0()
 	uint8	ExtendedFormat;
 
 	char	ROMFilename[PATH_MAX + 1];
@@ -355,8 +359,8 @@ struct SMulti
 	char	fileNameA[PATH_MAX + 1], fileNameB[PATH_MAX + 1];
 };
 
-extern CMemory	Memory;
-extern SMulti	Multi;
+extern S9X_TLS CMemory	Memory;
+extern S9X_TLS SMulti	Multi;
 
 void S9xAutoSaveSRAM (void);
 bool8 LoadZip(const char *, int32 *, int32 *, uint8 *);
@@ -244,11 +244,11 @@ struct SMovie
 	uint32	InputBufferSize;
 };
 
-static struct SMovie	Movie;
+static S9X_TLS struct SMovie	Movie;
 
-static uint8	prevPortType[2];
-static int8		prevPortIDs[2][4];
-static bool8	prevMouseMaster, prevSuperScopeMaster, prevJustifierMaster, prevMultiPlayer5Master;
+static S9X_TLS uint8	prevPortType[2];
+static S9X_TLS int8		prevPortIDs[2][4];
+static S9X_TLS bool8	prevMouseMaster, prevSuperScopeMaster, prevJustifierMaster, prevMultiPlayer5Master;
 
 static uint8	Read8 (uint8 *&);
 static uint16	Read16 (uint8 *&);
@@ -1179,7 +1179,7 @@ void S9xMovieToggleFrameDisplay (void)
 
 void S9xUpdateFrameCounter (int offset)
 {
-	extern bool8	pad_read;
+	extern S9X_TLS bool8	pad_read;
 
 	offset++;
 
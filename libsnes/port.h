@@ -280,6 +280,21 @@ typedef unsigned long long	uint64;
 #define START_EXTERN_C	extern "C" {
 #define END_EXTERN_C	}
 
+// State of the emulated console is thread-local, so every thread can host its own console
+// (see S9xContext in libgameconsole). S9X_TLS is for plain data and costs no more than a global
+// on access, S9X_TLS_CLASS for objects with constructors. Define S9X_SINGLE_INSTANCE to get
+// ordinary globals back; without threads (emscripten) that is the default.
+#if defined(S9X_SINGLE_INSTANCE) || defined(__EMSCRIPTEN__)
+#define S9X_TLS
+#define S9X_TLS_CLASS
+#elif defined(_MSC_VER)
+#define S9X_TLS			__declspec(thread)
+#define S9X_TLS_CLASS	thread_local
+#else
+#define S9X_TLS			__thread
+#define S9X_TLS_CLASS	thread_local
+#endif
+
 #ifndef __WIN32__
 #ifndef PATH_MAX
 #define PATH_MAX	1024
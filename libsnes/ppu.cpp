@@ -194,7 +194,7 @@
 #include "missing.h"
 #endif
 
-extern uint8	*HDMAMemPointers[8];
+extern S9X_TLS uint8	*HDMAMemPointers[8];
 
 
 static inline void S9xLatchCounters (bool force)
@@ -1052,6 +1052,8 @@ void S9xSetPPU (uint8 Byte, uint16 Address)
 		else
 		if (Settings.SA1     && Address >= 0x2200)
 		{
+			S9xSA1Sync();
+
 			if (Address <= 0x23ff)
 				S9xSetSA1(Byte, Address);
 			else
@@ -1317,7 +1319,10 @@ uint8 S9xGetPPU (uint16 Address)
 			return (S9xGetSuperFX(Address));
 		else
 		if (Settings.SA1     && Address >= 0x2200)
+		{
+			S9xSA1Sync();
 			return (S9xGetSA1(Address));
+		}
 		else
 		if (Settings.BS      && Address >= 0x2188 && Address <= 0x219f)
 			return (S9xGetBSXPPU(Address));
@@ -1368,6 +1373,8 @@ void S9xSetCPU (uint8 Byte, uint16 Address)
 
 		int	d = (Address >> 4) & 0x7;
 
+		S9xDropHDMAProgram(d);
+
 		switch (Address & 0xf)
 		{
 			case 0x0: // 0x43x0: DMAPx
@@ -1669,7 +1676,7 @@ uint8 S9xGetCPU (uint16 Address)
 	if (Address < 0x4200)
 	{
 	#ifdef SNES_JOY_READ_CALLBACKS
-		extern bool8 pad_read;
+		extern S9X_TLS bool8 pad_read;
 		if (Address == 0x4016 || Address == 0x4017)
 		{
 			S9xOnSNESPadRead();
@@ -1781,7 +1788,7 @@ uint8 S9xGetCPU (uint16 Address)
 			case 0x421e: // JOY4L
 			case 0x421f: // JOY4H
 			#ifdef SNES_JOY_READ_CALLBACKS
-				extern bool8 pad_read;
+				extern S9X_TLS bool8 pad_read;
 				if (Memory.FillRAM[0x4200] & 1)
 				{
 					S9xOnSNESPadRead();
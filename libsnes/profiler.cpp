@@ -0,0 +1,308 @@
+/***********************************************************************************
+  Snes9x - Portable Super Nintendo Entertainment System (TM) emulator.
+
+  (c) Copyright 1996 - 2002  Gary Henderson (gary.henderson@ntlworld.com),
+                             Jerremy Koot (jkoot@snes9x.com)
+
+  (c) Copyright 2002 - 2004  Matthew Kendora
+
+  (c) Copyright 2002 - 2005  Peter Bortas (peter@bortas.org)
+
+  (c) Copyright 2004 - 2005  Joel Yliluoma (http://iki.fi/bisqwit/)
+
+  (c) Copyright 2001 - 2006  John Weidman (jweidman@slip.net)
+
+  (c) Copyright 2002 - 2006  funkyass (funkyass@spam.shaw.ca),
+                             Kris Bleakley (codeviolation@hotmail.com)
+
+  (c) Copyright 2002 - 2010  Brad Jorsch (anomie@users.sourceforge.net),
+                             Nach (n-a-c-h@users.sourceforge.net),
+
+  (c) Copyright 2002 - 2011  zones (kasumitokoduck@yahoo.com)
+
+  (c) Copyright 2006 - 2007  nitsuja
+
+  (c) Copyright 2009 - 2011  BearOso,
+                             OV2
+
+
+  BS-X C emulator code
+  (c) Copyright 2005 - 2006  Dreamer Nom,
+                             zones
+
+  C4 x86 assembler and some C emulation code
+  (c) Copyright 2000 - 2003  _Demo_ (_demo_@zsnes.com),
+                             Nach,
+                             zsKnight (zsknight@zsnes.com)
+
+  C4 C++ code
+  (c) Copyright 2003 - 2006  Brad Jorsch,
+                             Nach
+
+  DSP-1 emulator code
+  (c) Copyright 1998 - 2006  _Demo_,
+                             Andreas Naive (andreasnaive@gmail.com),
+                             Gary Henderson,
+                             Ivar (ivar@snes9x.com),
+                             John Weidman,
+                             Kris Bleakley,
+                             Matthew Kendora,
+                             Nach,
+                             neviksti (neviksti@hotmail.com)
+
+  DSP-2 emulator code
+  (c) Copyright 2003         John Weidman,
+                             Kris Bleakley,
+                             Lord Nightmare (lord_nightmare@users.sourceforge.net),
+                             Matthew Kendora,
+                             neviksti
+
+  DSP-3 emulator code
+  (c) Copyright 2003 - 2006  John Weidman,
+                             Kris Bleakley,
+                             Lancer,
+                             z80 gaiden
+
+  DSP-4 emulator code
+  (c) Copyright 2004 - 2006  Dreamer Nom,
+                             John Weidman,
+                             Kris Bleakley,
+                             Nach,
+                             z80 gaiden
+
+  OBC1 emulator code
+  (c) Copyright 2001 - 2004  zsKnight,
+                             pagefault (pagefault@zsnes.com),
+                             Kris Bleakley
+                             Ported from x86 assembler to C by sanmaiwashi
+
+  SPC7110 and RTC C++ emulator code used in 1.39-1.51
+  (c) Copyright 2002         Matthew Kendora with research by
+                             zsKnight,
+                             John Weidman,
+                             Dark Force
+
+  SPC7110 and RTC C++ emulator code used in 1.52+
+  (c) Copyright 2009         byuu,
+                             neviksti
+
+  S-DD1 C emulator code
+  (c) Copyright 2003         Brad Jorsch with research by
+                             Andreas Naive,
+                             John Weidman
+
+  S-RTC C emulator code
+  (c) Copyright 2001 - 2006  byuu,
+                             John Weidman
+
+  ST010 C++ emulator code
+  (c) Copyright 2003         Feather,
+                             John Weidman,
+                             Kris Bleakley,
+                             Matthew Kendora
+
+  Super FX x86 assembler emulator code
+  (c) Copyright 1998 - 2003  _Demo_,
+                             pagefault,
+                             zsKnight
+
+  Super FX C emulator code
+  (c) Copyright 1997 - 1999  Ivar,
+                             Gary Henderson,
+                             John Weidman
+
+  Sound emulator code used in 1.5-1.51
+  (c) Copyright 1998 - 2003  Brad Martin
+  (c) Copyright 1998 - 2006  Charles Bilyue'
+
+  Sound emulator code used in 1.52+
+  (c) Copyright 2004 - 2007  Shay Green (gblargg@gmail.com)
+
+  SH assembler code partly based on x86 assembler code
+  (c) Copyright 2002 - 2004  Marcus Comstedt (marcus@mc.pp.se)
+
+  2xSaI filter
+  (c) Copyright 1999 - 2001  Derek Liauw Kie Fa
+
+  HQ2x, HQ3x, HQ4x filters
+  (c) Copyright 2003         Maxim Stepin (maxim@hiend3d.com)
+
+  NTSC filter
+  (c) Copyright 2006 - 2007  Shay Green
+
+  GTK+ GUI code
+  (c) Copyright 2004 - 2011  BearOso
+
+  Win32 GUI code
+  (c) Copyright 2003 - 2006  blip,
+                             funkyass,
+                             Matthew Kendora,
+                             Nach,
+                             nitsuja
+  (c) Copyright 2009 - 2011  OV2
+
+  Mac OS GUI code
+  (c) Copyright 1998 - 2001  John Stiles
+  (c) Copyright 2001 - 2011  zones
+
+
+  Specific ports contains the works of other authors. See headers in
+  individual files.
+
+
+  Snes9x homepage: http://www.snes9x.com/
+
+  Permission to use, copy, modify and/or distribute Snes9x in both binary
+  and source form, for non-commercial purposes, is hereby granted without
+  fee, providing that this license information and copyright notice appear
+  with all copies and any derived work.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event shall the authors be held liable for any damages
+  arising from the use of this software or it's derivatives.
+
+  Snes9x is freeware for PERSONAL USE only. Commercial users should
+  seek permission of the copyright holders first. Commercial use includes,
+  but is not limited to, charging money for Snes9x or software derived from
+  Snes9x, including Snes9x or derivatives in commercial game bundles, and/or
+  using Snes9x as a promotion for your commercial product.
+
+  The copyright holders request that bug fixes and improvements to the code
+  should be forwarded to them so everyone can benefit from the modifications
+  in future versions.
+
+  Super NES and Super Nintendo Entertainment System are trademarks of
+  Nintendo Co., Limited and its subsidiary companies.
+ ***********************************************************************************/
+
+
+#include <chrono>
+#include "snes9x.h"
+#include "profiler.h"
+
+static const char	*section_names[S9X_PROFILE_SECTION_COUNT] =
+{
+	"none",
+	"cpu",
+	"render-line",
+	"update-screen",
+	"hdma",
+	"dma",
+	"apu",
+	"dsp",
+	"superfx",
+	"sa1",
+	"filter",
+	"rewind",
+	"render-wait"
+};
+
+const char * S9xGetProfileSectionName (int section)
+{
+	if (section < 0 || section >= S9X_PROFILE_SECTION_COUNT)
+		return ("unknown");
+
+	return (section_names[section]);
+}
+
+#ifndef S9X_NO_PROFILER
+
+S9X_TLS struct SProfiler	Profiler;
+
+static uint64 S9xProfileNanoseconds (void)
+{
+	return (std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void S9xProfileBeginFrame (void)
+{
+	uint64	now = S9xProfileTicks();
+
+	// anything timed between frames (e.g. filters) stays in its section and counts to this frame
+	Profiler.Ticks[Profiler.Current] += now - Profiler.Last;
+	Profiler.Ticks[S9X_PROFILE_NONE] = 0;
+	Profiler.Last = now;
+	Profiler.Current = S9X_PROFILE_CPU;
+	Profiler.Calls[S9X_PROFILE_CPU]++;
+
+	Profiler.FrameStartTicks = now;
+	Profiler.FrameStartNanoseconds = S9xProfileNanoseconds();
+}
+
+void S9xProfileEndFrame (void)
+{
+	uint64	now = S9xProfileTicks();
+	uint64	nanoseconds = S9xProfileNanoseconds() - Profiler.FrameStartNanoseconds;
+	uint64	ticks = now - Profiler.FrameStartTicks;
+
+	Profiler.Ticks[Profiler.Current] += now - Profiler.Last;
+	Profiler.Last = now;
+	Profiler.Current = S9X_PROFILE_NONE;
+
+	// untimed calls of sampled sections ran as part of the CPU
+	for (int i = 0; i < S9X_PROFILE_SECTION_COUNT; i++)
+	{
+		if (!Profiler.UntimedUnits[i] || !Profiler.TimedUnits[i])
+			continue;
+
+		uint64	moved = (uint64) ((double) Profiler.TimedTicks[i] / Profiler.TimedUnits[i] * Profiler.UntimedUnits[i]);
+		if (moved > Profiler.Ticks[S9X_PROFILE_CPU])
+			moved = Profiler.Ticks[S9X_PROFILE_CPU];
+
+		Profiler.Ticks[S9X_PROFILE_CPU] -= moved;
+		Profiler.Ticks[i] += moved;
+	}
+
+	// ticks are not calibrated, the wall clock time of the frame gives their length
+	double			scale = ticks ? (double) nanoseconds / ticks : 0.0;
+	SProfileFrame	&frame = Profiler.History[Profiler.FrameCount % S9X_PROFILE_HISTORY];
+
+	frame.Nanoseconds = 0;
+
+	for (int i = 0; i < S9X_PROFILE_SECTION_COUNT; i++)
+	{
+		frame.SectionNanoseconds[i] = (i == S9X_PROFILE_NONE) ? 0 : (uint64) (Profiler.Ticks[i] * scale);
+		frame.SectionCalls[i] = Profiler.Calls[i];
+		frame.Nanoseconds += frame.SectionNanoseconds[i];
+	}
+
+	frame.Opcodes = Profiler.Opcodes;
+	Profiler.FrameCount++;
+
+	memset(Profiler.Ticks, 0, sizeof(Profiler.Ticks));
+	memset(Profiler.Calls, 0, sizeof(Profiler.Calls));
+	memset(Profiler.UntimedUnits, 0, sizeof(Profiler.UntimedUnits));
+	Profiler.Opcodes = 0;
+}
+
+int S9xGetProfileHistory (struct SProfileFrame *frames, int max)
+{
+	int	count = Profiler.FrameCount < S9X_PROFILE_HISTORY ? Profiler.FrameCount : S9X_PROFILE_HISTORY;
+	if (count > max)
+		count = max;
+
+	for (int i = 0; i < count; i++)
+		frames[i] = Profiler.History[(Profiler.FrameCount - count + i) % S9X_PROFILE_HISTORY];
+
+	return (count);
+}
+
+void S9xResetProfile (void)
+{
+	Profiler.FrameCount = 0;
+	memset(Profiler.TimedUnits, 0, sizeof(Profiler.TimedUnits));
+	memset(Profiler.TimedTicks, 0, sizeof(Profiler.TimedTicks));
+}
+
+#else
+
+int S9xGetProfileHistory (struct SProfileFrame *, int)
+{
+	return (0);
+}
+
+void S9xResetProfile (void)
+{
+}
+
+#endif
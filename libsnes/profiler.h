@@ -0,0 +1,352 @@
+/***********************************************************************************
+  Snes9x - Portable Super Nintendo Entertainment System (TM) emulator.
+
+  (c) Copyright 1996 - 2002  Gary Henderson (gary.henderson@ntlworld.com),
+                             Jerremy Koot (jkoot@snes9x.com)
+
+  (c) Copyright 2002 - 2004  Matthew Kendora
+
+  (c) Copyright 2002 - 2005  Peter Bortas (peter@bortas.org)
+
+  (c) Copyright 2004 - 2005  Joel Yliluoma (http://iki.fi/bisqwit/)
+
+  (c) Copyright 2001 - 2006  John Weidman (jweidman@slip.net)
+
+  (c) Copyright 2002 - 2006  funkyass (funkyass@spam.shaw.ca),
+                             Kris Bleakley (codeviolation@hotmail.com)
+
+  (c) Copyright 2002 - 2010  Brad Jorsch (anomie@users.sourceforge.net),
+                             Nach (n-a-c-h@users.sourceforge.net),
+
+  (c) Copyright 2002 - 2011  zones (kasumitokoduck@yahoo.com)
+
+  (c) Copyright 2006 - 2007  nitsuja
+
+  (c) Copyright 2009 - 2011  BearOso,
+                             OV2
+
+
+  BS-X C emulator code
+  (c) Copyright 2005 - 2006  Dreamer Nom,
+                             zones
+
+  C4 x86 assembler and some C emulation code
+  (c) Copyright 2000 - 2003  _Demo_ (_demo_@zsnes.com),
+                             Nach,
+                             zsKnight (zsknight@zsnes.com)
+
+  C4 C++ code
+  (c) Copyright 2003 - 2006  Brad Jorsch,
+                             Nach
+
+  DSP-1 emulator code
+  (c) Copyright 1998 - 2006  _Demo_,
+                             Andreas Naive (andreasnaive@gmail.com),
+                             Gary Henderson,
+                             Ivar (ivar@snes9x.com),
+                             John Weidman,
+                             Kris Bleakley,
+                             Matthew Kendora,
+                             Nach,
+                             neviksti (neviksti@hotmail.com)
+
+  DSP-2 emulator code
+  (c) Copyright 2003         John Weidman,
+                             Kris Bleakley,
+                             Lord Nightmare (lord_nightmare@users.sourceforge.net),
+                             Matthew Kendora,
+                             neviksti
+
+  DSP-3 emulator code
+  (c) Copyright 2003 - 2006  John Weidman,
+                             Kris Bleakley,
+                             Lancer,
+                             z80 gaiden
+
+  DSP-4 emulator code
+  (c) Copyright 2004 - 2006  Dreamer Nom,
+                             John Weidman,
+                             Kris Bleakley,
+                             Nach,
+                             z80 gaiden
+
+  OBC1 emulator code
+  (c) Copyright 2001 - 2004  zsKnight,
+                             pagefault (pagefault@zsnes.com),
+                             Kris Bleakley
+                             Ported from x86 assembler to C by sanmaiwashi
+
+  SPC7110 and RTC C++ emulator code used in 1.39-1.51
+  (c) Copyright 2002         Matthew Kendora with research by
+                             zsKnight,
+                             John Weidman,
+                             Dark Force
+
+  SPC7110 and RTC C++ emulator code used in 1.52+
+  (c) Copyright 2009         byuu,
+                             neviksti
+
+  S-DD1 C emulator code
+  (c) Copyright 2003         Brad Jorsch with research by
+                             Andreas Naive,
+                             John Weidman
+
+  S-RTC C emulator code
+  (c) Copyright 2001 - 2006  byuu,
+                             John Weidman
+
+  ST010 C++ emulator code
+  (c) Copyright 2003         Feather,
+                             John Weidman,
+                             Kris Bleakley,
+                             Matthew Kendora
+
+  Super FX x86 assembler emulator code
+  (c) Copyright 1998 - 2003  _Demo_,
+                             pagefault,
+                             zsKnight
+
+  Super FX C emulator code
+  (c) Copyright 1997 - 1999  Ivar,
+                             Gary Henderson,
+                             John Weidman
+
+  Sound emulator code used in 1.5-1.51
+  (c) Copyright 1998 - 2003  Brad Martin
+  (c) Copyright 1998 - 2006  Charles Bilyue'
+
+  Sound emulator code used in 1.52+
+  (c) Copyright 2004 - 2007  Shay Green (gblargg@gmail.com)
+
+  SH assembler code partly based on x86 assembler code
+  (c) Copyright 2002 - 2004  Marcus Comstedt (marcus@mc.pp.se)
+
+  2xSaI filter
+  (c) Copyright 1999 - 2001  Derek Liauw Kie Fa
+
+  HQ2x, HQ3x, HQ4x filters
+  (c) Copyright 2003         Maxim Stepin (maxim@hiend3d.com)
+
+  NTSC filter
+  (c) Copyright 2006 - 2007  Shay Green
+
+  GTK+ GUI code
+  (c) Copyright 2004 - 2011  BearOso
+
+  Win32 GUI code
+  (c) Copyright 2003 - 2006  blip,
+                             funkyass,
+                             Matthew Kendora,
+                             Nach,
+                             nitsuja
+  (c) Copyright 2009 - 2011  OV2
+
+  Mac OS GUI code
+  (c) Copyright 1998 - 2001  John Stiles
+  (c) Copyright 2001 - 2011  zones
+
+
+  Specific ports contains the works of other authors. See headers in
+  individual files.
+
+
+  Snes9x homepage: http://www.snes9x.com/
+
+  Permission to use, copy, modify and/or distribute Snes9x in both binary
+  and source form, for non-commercial purposes, is hereby granted without
+  fee, providing that this license information and copyright notice appear
+  with all copies and any derived work.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event shall the authors be held liable for any damages
+  arising from the use of this software or it's derivatives.
+
+  Snes9x is freeware for PERSONAL USE only. Commercial users should
+  seek permission of the copyright holders first. Commercial use includes,
+  but is not limited to, charging money for Snes9x or software derived from
+  Snes9x, including Snes9x or derivatives in commercial game bundles, and/or
+  using Snes9x as a promotion for your commercial product.
+
+  The copyright holders request that bug fixes and improvements to the code
+  should be forwarded to them so everyone can benefit from the modifications
+  in future versions.
+
+  Super NES and Super Nintendo Entertainment System are trademarks of
+  Nintendo Co., Limited and its subsidiary companies.
+ ***********************************************************************************/
+
+
+#ifndef _PROFILER_H_
+#define _PROFILER_H_
+
+// Per-console frame profiler. Sections are timed exclusively: entering a nested section pauses
+// the enclosing one, so the sections of a frame add up to the whole frame. Whatever runs inside
+// S9xMainLoop outside of any other section is charged to the CPU. Recent frames are kept in a
+// ring and can be read with S9xGetProfileHistory(). Work entered too often to time every call
+// (SA-1 slices) is counted on every call but only timed on one call in S9X_PROFILE_SAMPLE_EVERY;
+// S9xProfileEndFrame() moves the cost of the untimed ones from the CPU to its section at the
+// average so far. Define S9X_NO_PROFILER to compile all instrumentation out.
+
+enum
+{
+	S9X_PROFILE_NONE,			// outside of any frame, never reported
+	S9X_PROFILE_CPU,			// S9xMainLoop opcode dispatch and event handling
+	S9X_PROFILE_RENDER_LINE,
+	S9X_PROFILE_UPDATE_SCREEN,
+	S9X_PROFILE_HDMA,
+	S9X_PROFILE_DMA,
+	S9X_PROFILE_APU,			// SPC700 catching up at the end of each scanline
+	S9X_PROFILE_DSP,
+	S9X_PROFILE_SUPERFX,
+	S9X_PROFILE_SA1,
+	S9X_PROFILE_FILTER,
+	S9X_PROFILE_REWIND,
+	S9X_PROFILE_RENDER_WAIT,	// waiting for lines handed to the render threads
+	S9X_PROFILE_SECTION_COUNT
+};
+
+#define S9X_PROFILE_HISTORY	256
+#define S9X_PROFILE_SAMPLE_EVERY	64	// power of two
+
+struct SProfileFrame
+{
+	uint64	Nanoseconds;
+	uint64	SectionNanoseconds[S9X_PROFILE_SECTION_COUNT];
+	uint32	SectionCalls[S9X_PROFILE_SECTION_COUNT];
+	uint32	Opcodes;
+};
+
+const char * S9xGetProfileSectionName (int);
+// copies up to the given amount of the most recent frames, oldest first; returns the amount copied
+int S9xGetProfileHistory (struct SProfileFrame *, int);
+void S9xResetProfile (void);
+
+#ifndef S9X_NO_PROFILER
+
+#if defined(__i386__) || defined(__x86_64__)
+#include <x86intrin.h>
+#elif defined(_M_IX86) || defined(_M_X64)
+#include <intrin.h>
+#else
+#include <chrono>
+#endif
+
+struct SProfiler
+{
+	uint64	Last;						// tick of the last section switch
+	int		Current;
+	uint64	Ticks[S9X_PROFILE_SECTION_COUNT];
+	uint32	Calls[S9X_PROFILE_SECTION_COUNT];
+	uint32	Opcodes;
+	uint64	UntimedUnits[S9X_PROFILE_SECTION_COUNT];	// units of sampled sections run untimed this frame
+	uint64	TimedUnits[S9X_PROFILE_SECTION_COUNT];		// and timed since the profile was reset
+	uint64	TimedTicks[S9X_PROFILE_SECTION_COUNT];
+	uint32	Samples;					// LCG state picking the timed calls
+	uint64	FrameStartTicks;
+	uint64	FrameStartNanoseconds;
+	uint32	FrameCount;
+	struct SProfileFrame	History[S9X_PROFILE_HISTORY];
+};
+
+extern S9X_TLS struct SProfiler	Profiler;
+
+// not calibrated, S9xProfileEndFrame() converts them with the wall clock time of the frame
+static inline uint64 S9xProfileTicks (void)
+{
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+	return (__rdtsc());
+#else
+	return (std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+class S9xProfileScope
+{
+	int	previous;
+
+public:
+	S9xProfileScope (int section)
+	{
+		uint64	now = S9xProfileTicks();
+		Profiler.Ticks[Profiler.Current] += now - Profiler.Last;
+		Profiler.Last = now;
+		previous = Profiler.Current;
+		Profiler.Current = section;
+		Profiler.Calls[section]++;
+	}
+
+	~S9xProfileScope (void)
+	{
+		uint64	now = S9xProfileTicks();
+		Profiler.Ticks[Profiler.Current] += now - Profiler.Last;
+		Profiler.Last = now;
+		Profiler.Current = previous;
+	}
+};
+
+// times one call in S9X_PROFILE_SAMPLE_EVERY, the others only count their units of work
+class S9xProfileSample
+{
+	int		section;
+	int		previous;
+	uint32	units;
+	bool	timed;
+	uint64	start;
+
+public:
+	S9xProfileSample (int section, uint32 units) : section(section), units(units)
+	{
+		Profiler.Calls[section]++;
+
+		// an LCG rather than a plain count, so the calls timed don't fall into step with a loop of the game
+		Profiler.Samples = Profiler.Samples * 1103515245 + 12345;
+		timed = !((Profiler.Samples >> 16) & (S9X_PROFILE_SAMPLE_EVERY - 1));
+		if (!timed)
+		{
+			Profiler.UntimedUnits[section] += units;
+			return;
+		}
+
+		start = S9xProfileTicks();
+		Profiler.Ticks[Profiler.Current] += start - Profiler.Last;
+		Profiler.Last = start;
+		previous = Profiler.Current;
+		Profiler.Current = section;
+	}
+
+	~S9xProfileSample (void)
+	{
+		if (!timed)
+			return;
+
+		uint64	now = S9xProfileTicks();
+		Profiler.Ticks[Profiler.Current] += now - Profiler.Last;
+		Profiler.Last = now;
+		Profiler.Current = previous;
+		Profiler.TimedUnits[section] += units;
+		Profiler.TimedTicks[section] += now - start;
+	}
+};
+
+void S9xProfileBeginFrame (void);
+void S9xProfileEndFrame (void);
+
+#define S9X_PROFILE_SCOPE_NAME2(line)	s9xProfileScope##line
+#define S9X_PROFILE_SCOPE_NAME(line)	S9X_PROFILE_SCOPE_NAME2(line)
+#define S9X_PROFILE(section)			S9xProfileScope S9X_PROFILE_SCOPE_NAME(__LINE__) (section)
+#define S9X_PROFILE_SAMPLE(section, units)	S9xProfileSample S9X_PROFILE_SCOPE_NAME(__LINE__) (section, units)
+#define S9X_PROFILE_OPCODE()			(Profiler.Opcodes++)
+#define S9X_PROFILE_BEGIN_FRAME()		S9xProfileBeginFrame()
+#define S9X_PROFILE_END_FRAME()			S9xProfileEndFrame()
+
+#else
+
+#define S9X_PROFILE(section)
+#define S9X_PROFILE_SAMPLE(section, units)
+#define S9X_PROFILE_OPCODE()
+#define S9X_PROFILE_BEGIN_FRAME()
+#define S9X_PROFILE_END_FRAME()
+
+#endif
+
+#endif
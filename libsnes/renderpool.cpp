@@ -0,0 +1,580 @@
+/***********************************************************************************
+  Snes9x - Portable Super Nintendo Entertainment System (TM) emulator.
+
+  (c) Copyright 1996 - 2002  Gary Henderson (gary.henderson@ntlworld.com),
+                             Jerremy Koot (jkoot@snes9x.com)
+
+  (c) Copyright 2002 - 2004  Matthew Kendora
+
+  (c) Copyright 2002 - 2005  Peter Bortas (peter@bortas.org)
+
+  (c) Copyright 2004 - 2005  Joel Yliluoma (http://iki.fi/bisqwit/)
+
+  (c) Copyright 2001 - 2006  John Weidman (jweidman@slip.net)
+
+  (c) Copyright 2002 - 2006  funkyass (funkyass@spam.shaw.ca),
+                             Kris Bleakley (codeviolation@hotmail.com)
+
+  (c) Copyright 2002 - 2010  Brad Jorsch (anomie@users.sourceforge.net),
+                             Nach (n-a-c-h@users.sourceforge.net),
+
+  (c) Copyright 2002 - 2011  zones (kasumitokoduck@yahoo.com)
+
+  (c) Copyright 2006 - 2007  nitsuja
+
+  (c) Copyright 2009 - 2011  BearOso,
+                             OV2
+
+
+  BS-X C emulator code
+  (c) Copyright 2005 - 2006  Dreamer Nom,
+                             zones
+
+  C4 x86 assembler and some C emulation code
+  (c) Copyright 2000 - 2003  _Demo_ (_demo_@zsnes.com),
+                             Nach,
+                             zsKnight (zsknight@zsnes.com)
+
+  C4 C++ code
+  (c) Copyright 2003 - 2006  Brad Jorsch,
+                             Nach
+
+  DSP-1 emulator code
+  (c) Copyright 1998 - 2006  _Demo_,
+                             Andreas Naive (andreasnaive@gmail.com),
+                             Gary Henderson,
+                             Ivar (ivar@snes9x.com),
+                             John Weidman,
+                             Kris Bleakley,
+                             Matthew Kendora,
+                             Nach,
+                             neviksti (neviksti@hotmail.com)
+
+  DSP-2 emulator code
+  (c) Copyright 2003         John Weidman,
+                             Kris Bleakley,
+                             Lord Nightmare (lord_nightmare@users.sourceforge.net),
+                             Matthew Kendora,
+                             neviksti
+
+  DSP-3 emulator code
+  (c) Copyright 2003 - 2006  John Weidman,
+                             Kris Bleakley,
+                             Lancer,
+                             z80 gaiden
+
+  DSP-4 emulator code
+  (c) Copyright 2004 - 2006  Dreamer Nom,
+                             John Weidman,
+                             Kris Bleakley,
+                             Nach,
+                             z80 gaiden
+
+  OBC1 emulator code
+  (c) Copyright 2001 - 2004  zsKnight,
+                             pagefault (pagefault@zsnes.com),
+                             Kris Bleakley
+                             Ported from x86 assembler to C by sanmaiwashi
+
+  SPC7110 and RTC C++ emulator code used in 1.39-1.51
+  (c) Copyright 2002         Matthew Kendora with research by
+                             zsKnight,
+                             John Weidman,
+                             Dark Force
+
+  SPC7110 and RTC C++ emulator code used in 1.52+
+  (c) Copyright 2009         byuu,
+                             neviksti
+
+  S-DD1 C emulator code
+  (c) Copyright 2003         Brad Jorsch with research by
+                             Andreas Naive,
+                             John Weidman
+
+  S-RTC C emulator code
+  (c) Copyright 2001 - 2006  byuu,
+                             John Weidman
+
+  ST010 C++ emulator code
+  (c) Copyright 2003         Feather,
+                             John Weidman,
+                             Kris Bleakley,
+                             Matthew Kendora
+
+  Super FX x86 assembler emulator code
+  (c) Copyright 1998 - 2003  _Demo_,
+                             pagefault,
+                             zsKnight
+
+  Super FX C emulator code
+  (c) Copyright 1997 - 1999  Ivar,
+                             Gary Henderson,
+                             John Weidman
+
+  Sound emulator code used in 1.5-1.51
+  (c) Copyright 1998 - 2003  Brad Martin
+  (c) Copyright 1998 - 2006  Charles Bilyue'
+
+  Sound emulator code used in 1.52+
+  (c) Copyright 2004 - 2007  Shay Green (gblargg@gmail.com)
+
+  SH assembler code partly based on x86 assembler code
+  (c) Copyright 2002 - 2004  Marcus Comstedt (marcus@mc.pp.se)
+
+  2xSaI filter
+  (c) Copyright 1999 - 2001  Derek Liauw Kie Fa
+
+  HQ2x, HQ3x, HQ4x filters
+  (c) Copyright 2003         Maxim Stepin (maxim@hiend3d.com)
+
+  NTSC filter
+  (c) Copyright 2006 - 2007  Shay Green
+
+  GTK+ GUI code
+  (c) Copyright 2004 - 2011  BearOso
+
+  Win32 GUI code
+  (c) Copyright 2003 - 2006  blip,
+                             funkyass,
+                             Matthew Kendora,
+                             Nach,
+                             nitsuja
+  (c) Copyright 2009 - 2011  OV2
+
+  Mac OS GUI code
+  (c) Copyright 1998 - 2001  John Stiles
+  (c) Copyright 2001 - 2011  zones
+
+
+  Specific ports contains the works of other authors. See headers in
+  individual files.
+
+
+  Snes9x homepage: http://www.snes9x.com/
+
+  Permission to use, copy, modify and/or distribute Snes9x in both binary
+  and source form, for non-commercial purposes, is hereby granted without
+  fee, providing that this license information and copyright notice appear
+  with all copies and any derived work.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event shall the authors be held liable for any damages
+  arising from the use of this software or it's derivatives.
+
+  Snes9x is freeware for PERSONAL USE only. Commercial users should
+  seek permission of the copyright holders first. Commercial use includes,
+  but is not limited to, charging money for Snes9x or software derived from
+  Snes9x, including Snes9x or derivatives in commercial game bundles, and/or
+  using Snes9x as a promotion for your commercial product.
+
+  The copyright holders request that bug fixes and improvements to the code
+  should be forwarded to them so everyone can benefit from the modifications
+  in future versions.
+
+  Super NES and Super Nintendo Entertainment System are trademarks of
+  Nintendo Co., Limited and its subsidiary companies.
+ ***********************************************************************************/
+
+
+#include "snes9x.h"
+#include "memmap.h"
+#include "ppu.h"
+#include "renderpool.h"
+#include "profiler.h"
+
+#ifdef S9X_RENDER_THREADS
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+extern S9X_TLS struct SLineData			LineData[240];
+extern S9X_TLS struct SLineMatrixData	LineMatrixData[240];
+
+// everything the rasterizer reads, as it was when the batch was handed out
+struct SRenderJob
+{
+	struct SPPU				ppu;
+	struct InternalPPU		ippu;
+	struct SGFX				gfx;
+	struct SSettings		settings;
+	struct SLineData		line_data[240];
+	struct SLineMatrixData	line_matrix_data[240];
+	uint16					colour_maps[8][256];
+	uint8					registers[0x100];	// Memory.FillRAM[0x2100 - 0x21ff]
+	uint8					vram[0x10000];
+};
+
+struct SRenderPool
+{
+	std::vector<std::thread>	threads;
+	std::vector<SRenderJob *>	jobs;
+	std::vector<SRenderJob *>	idle;			// free to be filled
+	std::deque<SRenderJob *>	queue;
+	std::mutex					mutex;
+	std::condition_variable		wakeup;			// workers wait for the queue
+	std::condition_variable		finished;		// the console waits for pending to drop to 0
+	int							pending;		// jobs queued or being rendered
+	bool						quit;
+	uint64						lines;
+};
+
+static S9X_TLS struct SRenderPool	*pool = NULL;
+
+// renderer state of a worker thread
+static S9X_TLS struct SRenderWorker
+{
+	bool8	Ready;
+	uint32	Pitch;
+	uint32	PixelFormat;
+	bool8	SupportHiRes;
+}	Worker;
+
+static const uint32	tile_counts[7] =
+{
+	MAX_2BIT_TILES, MAX_4BIT_TILES, MAX_8BIT_TILES,
+	MAX_2BIT_TILES, MAX_2BIT_TILES, MAX_4BIT_TILES, MAX_4BIT_TILES
+};
+
+static void FreeWorker (void)
+{
+	S9xGraphicsDeinit();
+
+	for (int i = 0; i < 7; i++)
+	{
+		free(IPPU.TileCache[i]);
+		free(IPPU.TileCached[i]);
+		free(IPPU.TileStamp[i]);
+		IPPU.TileCache[i] = IPPU.TileCached[i] = NULL;
+		IPPU.TileStamp[i] = NULL;
+	}
+
+	free(IPPU.VRAMGeneration);
+	IPPU.VRAMGeneration = NULL;
+
+	free(Memory.VRAM);
+	free(Memory.FillRAM);
+	Memory.VRAM = Memory.FillRAM = NULL;
+
+	Worker.Ready = FALSE;
+}
+
+static bool8 InitWorker (const struct SRenderJob *job)
+{
+	FreeWorker();
+
+	Memory.VRAM    = (uint8 *) calloc(0x10000, 1);
+	Memory.FillRAM = (uint8 *) calloc(0x8000, 1);
+	if (!Memory.VRAM || !Memory.FillRAM)
+		return (FALSE);
+
+	for (int i = 0; i < 7; i++)
+	{
+		IPPU.TileCache[i]  = (uint8 *) malloc(tile_counts[i] * 64);
+		IPPU.TileCached[i] = (uint8 *) calloc(tile_counts[i], 1);
+		IPPU.TileStamp[i]  = (uint32 *) calloc(tile_counts[i], 4);
+		if (!IPPU.TileCache[i] || !IPPU.TileCached[i] || !IPPU.TileStamp[i])
+			return (FALSE);
+	}
+
+	IPPU.VRAMGeneration = (uint32 *) calloc(MAX_VRAM_BLOCKS, 4);
+	if (!IPPU.VRAMGeneration)
+		return (FALSE);
+
+	GFX.Pitch = job->gfx.Pitch;
+#ifdef GFX_MULTI_FORMAT
+	S9xSetRenderPixelFormat(job->gfx.PixelFormat);
+#endif
+	if (!S9xGraphicsInit())
+		return (FALSE);
+
+	Worker.Ready = TRUE;
+	Worker.Pitch = job->gfx.Pitch;
+#ifdef GFX_MULTI_FORMAT
+	Worker.PixelFormat = job->gfx.PixelFormat;
+#endif
+	Worker.SupportHiRes = job->settings.SupportHiRes;
+
+	return (TRUE);
+}
+
+// the worker's tile caches only know its own copy of VRAM
+static void InvalidateTiles (uint32 address)
+{
+	for (uint32 i = 0; i < 4; i++)
+		IPPU.VRAMGeneration[(address >> 4) + i]++;
+}
+
+static void RenderJob (const struct SRenderJob *job)
+{
+	bool8	format_changed = FALSE;
+
+#ifdef GFX_MULTI_FORMAT
+	format_changed = Worker.PixelFormat != job->gfx.PixelFormat;
+#endif
+
+	Settings = job->settings;
+
+	if (!Worker.Ready || format_changed || Worker.Pitch != job->gfx.Pitch || Worker.SupportHiRes != job->settings.SupportHiRes)
+	{
+		if (!InitWorker(job))
+		{
+			FreeWorker();
+			return;
+		}
+
+		// S9xGraphicsInit() resets some of them
+		Settings = job->settings;
+	}
+
+	for (uint32 address = 0; address < 0x10000; address += 64)
+	{
+		if (memcmp(Memory.VRAM + address, job->vram + address, 64))
+		{
+			memcpy(Memory.VRAM + address, job->vram + address, 64);
+			InvalidateTiles(address);
+		}
+	}
+
+	uint8	*tile_cache[7], *tile_cached[7];
+	uint32	*tile_stamp[7], *vram_generation = IPPU.VRAMGeneration;
+	memcpy(tile_cache, IPPU.TileCache, sizeof(tile_cache));
+	memcpy(tile_cached, IPPU.TileCached, sizeof(tile_cached));
+	memcpy(tile_stamp, IPPU.TileStamp, sizeof(tile_stamp));
+	IPPU = job->ippu;
+	memcpy(IPPU.TileCache, tile_cache, sizeof(tile_cache));
+	memcpy(IPPU.TileCached, tile_cached, sizeof(tile_cached));
+	memcpy(IPPU.TileStamp, tile_stamp, sizeof(tile_stamp));
+	IPPU.VRAMGeneration = vram_generation;
+
+	uint16	*sub_screen = GFX.SubScreen, *x2 = GFX.X2, *zero = GFX.ZERO;
+	uint8	*z_buffer = GFX.ZBuffer, *sub_z_buffer = GFX.SubZBuffer;
+	uint32	screen_size = GFX.ScreenSize;
+	GFX = job->gfx;
+	GFX.SubScreen = sub_screen;
+	GFX.X2 = x2;
+	GFX.ZERO = zero;
+	GFX.ZBuffer = z_buffer;
+	GFX.SubZBuffer = sub_z_buffer;
+	GFX.ScreenSize = screen_size;
+
+	PPU = job->ppu;
+	memcpy(LineData, job->line_data, sizeof(LineData));
+	memcpy(LineMatrixData, job->line_matrix_data, sizeof(LineMatrixData));
+	memcpy(Memory.FillRAM + 0x2100, job->registers, 0x100);
+	if (!IPPU.DirectColourMapsNeedRebuild)
+		memcpy(DirectColourMaps, job->colour_maps, sizeof(DirectColourMaps));
+
+	// the console clears its depth buffers once per frame, here they hold lines of other batches
+	uint32	first = GFX.StartY * GFX.PPL, count = (GFX.EndY + 1 - GFX.StartY) * GFX.PPL;
+	ZeroMemory(GFX.ZBuffer + first, count);
+	ZeroMemory(GFX.SubZBuffer + first, count);
+
+	S9xRenderScreenLines();
+}
+
+static void WorkerProc (struct SRenderPool *p)
+{
+	std::unique_lock<std::mutex>	lock(p->mutex);
+
+	while (true)
+	{
+		p->wakeup.wait(lock, [p] { return (p->quit || !p->queue.empty()); });
+		if (p->queue.empty())
+			break;
+
+		SRenderJob	*job = p->queue.front();
+		p->queue.pop_front();
+
+		lock.unlock();
+		RenderJob(job);
+		lock.lock();
+
+		p->idle.push_back(job);
+		if (--p->pending == 0)
+			p->finished.notify_all();
+	}
+
+	lock.unlock();
+	FreeWorker();
+}
+
+// copies the state of the current batch into a free job; false if all of them are busy
+static bool8 QueueJob (void)
+{
+	SRenderJob	*job;
+
+	{
+		std::lock_guard<std::mutex>	lock(pool->mutex);
+		if (pool->idle.empty())
+			return (FALSE);
+
+		job = pool->idle.back();
+		pool->idle.pop_back();
+	}
+
+	job->ppu = PPU;
+	job->ippu = IPPU;
+	job->gfx = GFX;
+	job->settings = Settings;
+	memcpy(job->line_data, LineData, sizeof(LineData));
+	memcpy(job->line_matrix_data, LineMatrixData, sizeof(LineMatrixData));
+	memcpy(job->registers, Memory.FillRAM + 0x2100, 0x100);
+	memcpy(job->vram, Memory.VRAM, 0x10000);
+	if (!IPPU.DirectColourMapsNeedRebuild)
+		memcpy(job->colour_maps, DirectColourMaps, sizeof(DirectColourMaps));
+
+	{
+		std::lock_guard<std::mutex>	lock(pool->mutex);
+		pool->queue.push_back(job);
+		pool->pending++;
+		pool->lines += GFX.EndY + 1 - GFX.StartY;
+	}
+
+	pool->wakeup.notify_one();
+	return (TRUE);
+}
+
+bool8 S9xRenderPoolInit (int threads)
+{
+	S9xRenderPoolDeinit();
+
+	if (threads <= 0)
+		return (TRUE);
+
+	pool = new SRenderPool;
+	pool->pending = 0;
+	pool->quit = false;
+	pool->lines = 0;
+
+	// two per worker, so the next batch can be filled while one is drawn
+	for (int i = 0; i < threads * 2; i++)
+	{
+		pool->jobs.push_back(new SRenderJob);
+		pool->idle.push_back(pool->jobs.back());
+	}
+
+	for (int i = 0; i < threads; i++)
+		pool->threads.push_back(std::thread(WorkerProc, pool));
+
+	return (TRUE);
+}
+
+void S9xRenderPoolDeinit (void)
+{
+	if (!pool)
+		return;
+
+	{
+		std::lock_guard<std::mutex>	lock(pool->mutex);
+		pool->quit = true;
+	}
+
+	pool->wakeup.notify_all();
+	for (size_t i = 0; i < pool->threads.size(); i++)
+		pool->threads[i].join();
+
+	for (size_t i = 0; i < pool->jobs.size(); i++)
+		delete pool->jobs[i];
+
+	delete pool;
+	pool = NULL;
+}
+
+int S9xRenderPoolThreads (void)
+{
+	return (pool ? (int) pool->threads.size() : 0);
+}
+
+void S9xRenderPoolDispatch (void)
+{
+	uint32	start = GFX.StartY, end = GFX.EndY;
+
+	if (!pool || end < start || end + 1 - start < S9X_RENDER_MIN_LINES)
+	{
+		S9xRenderScreenLines();
+		return;
+	}
+
+	if (end + 1 >= PPU.ScreenHeight)
+	{
+		// last batch of the frame: the console would only wait, so it takes a share itself
+		uint32	lines = end + 1 - start;
+		uint32	parts = lines / S9X_RENDER_MIN_LINES;
+		uint32	part = 0;
+
+		if (parts > pool->threads.size() + 1)
+			parts = pool->threads.size() + 1;
+
+		for (; part + 1 < parts; part++)
+		{
+			GFX.StartY = start + lines * part / parts;
+			GFX.EndY = start + lines * (part + 1) / parts - 1;
+			if (!QueueJob())
+				break;
+		}
+
+		GFX.StartY = start + lines * part / parts;
+		GFX.EndY = end;
+		S9xRenderScreenLines();
+
+		GFX.StartY = start;
+	}
+	else
+	if (!QueueJob())
+		S9xRenderScreenLines();
+}
+
+void S9xRenderPoolWait (void)
+{
+	if (!pool)
+		return;
+
+	S9X_PROFILE(S9X_PROFILE_RENDER_WAIT);
+
+	std::unique_lock<std::mutex>	lock(pool->mutex);
+	pool->finished.wait(lock, [] { return (pool->pending == 0); });
+}
+
+uint64 S9xRenderPoolLines (void)
+{
+	if (!pool)
+		return (0);
+
+	std::lock_guard<std::mutex>	lock(pool->mutex);
+	return (pool->lines);
+}
+
+#else
+
+bool8 S9xRenderPoolInit (int threads)
+{
+	return (threads <= 0);
+}
+
+void S9xRenderPoolDeinit (void)
+{
+}
+
+int S9xRenderPoolThreads (void)
+{
+	return (0);
+}
+
+void S9xRenderPoolDispatch (void)
+{
+	S9xRenderScreenLines();
+}
+
+void S9xRenderPoolWait (void)
+{
+}
+
+uint64 S9xRenderPoolLines (void)
+{
+	return (0);
+}
+
+#endif
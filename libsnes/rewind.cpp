@@ -0,0 +1,500 @@
+/***********************************************************************************
+  Snes9x - Portable Super Nintendo Entertainment System (TM) emulator.
+
+  (c) Copyright 1996 - 2002  Gary Henderson (gary.henderson@ntlworld.com),
+                             Jerremy Koot (jkoot@snes9x.com)
+
+  (c) Copyright 2002 - 2004  Matthew Kendora
+
+  (c) Copyright 2002 - 2005  Peter Bortas (peter@bortas.org)
+
+  (c) Copyright 2004 - 2005  Joel Yliluoma (http://iki.fi/bisqwit/)
+
+  (c) Copyright 2001 - 2006  John Weidman (jweidman@slip.net)
+
+  (c) Copyright 2002 - 2006  funkyass (funkyass@spam.shaw.ca),
+                             Kris Bleakley (codeviolation@hotmail.com)
+
+  (c) Copyright 2002 - 2010  Brad Jorsch (anomie@users.sourceforge.net),
+                             Nach (n-a-c-h@users.sourceforge.net),
+
+  (c) Copyright 2002 - 2011  zones (kasumitokoduck@yahoo.com)
+
+  (c) Copyright 2006 - 2007  nitsuja
+
+  (c) Copyright 2009 - 2011  BearOso,
+                             OV2
+
+
+  BS-X C emulator code
+  (c) Copyright 2005 - 2006  Dreamer Nom,
+                             zones
+
+  C4 x86 assembler and some C emulation code
+  (c) Copyright 2000 - 2003  _Demo_ (_demo_@zsnes.com),
+                             Nach,
+                             zsKnight (zsknight@zsnes.com)
+
+  C4 C++ code
+  (c) Copyright 2003 - 2006  Brad Jorsch,
+                             Nach
+
+  DSP-1 emulator code
+  (c) Copyright 1998 - 2006  _Demo_,
+                             Andreas Naive (andreasnaive@gmail.com),
+                             Gary Henderson,
+                             Ivar (ivar@snes9x.com),
+                             John Weidman,
+                             Kris Bleakley,
+                             Matthew Kendora,
+                             Nach,
+                             neviksti (neviksti@hotmail.com)
+
+  DSP-2 emulator code
+  (c) Copyright 2003         John Weidman,
+                             Kris Bleakley,
+                             Lord Nightmare (lord_nightmare@users.sourceforge.net),
+                             Matthew Kendora,
+                             neviksti
+
+  DSP-3 emulator code
+  (c) Copyright 2003 - 2006  John Weidman,
+                             Kris Bleakley,
+                             Lancer,
+                             z80 gaiden
+
+  DSP-4 emulator code
+  (c) Copyright 2004 - 2006  Dreamer Nom,
+                             John Weidman,
+                             Kris Bleakley,
+                             Nach,
+                             z80 gaiden
+
+  OBC1 emulator code
+  (c) Copyright 2001 - 2004  zsKnight,
+                             pagefault (pagefault@zsnes.com),
+                             Kris Bleakley
+                             Ported from x86 assembler to C by sanmaiwashi
+
+  SPC7110 and RTC C++ emulator code used in 1.39-1.51
+  (c) Copyright 2002         Matthew Kendora with research by
+                             zsKnight,
+                             John Weidman,
+                             Dark Force
+
+  SPC7110 and RTC C++ emulator code used in 1.52+
+  (c) Copyright 2009         byuu,
+                             neviksti
+
+  S-DD1 C emulator code
+  (c) Copyright 2003         Brad Jorsch with research by
+                             Andreas Naive,
+                             John Weidman
+
+  S-RTC C emulator code
+  (c) Copyright 2001 - 2006  byuu,
+                             John Weidman
+
+  ST010 C++ emulator code
+  (c) Copyright 2003         Feather,
+                             John Weidman,
+                             Kris Bleakley,
+                             Matthew Kendora
+
+  Super FX x86 assembler emulator code
+  (c) Copyright 1998 - 2003  _Demo_,
+                             pagefault,
+                             zsKnight
+
+  Super FX C emulator code
+  (c) Copyright 1997 - 1999  Ivar,
+                             Gary Henderson,
+                             John Weidman
+
+  Sound emulator code used in 1.5-1.51
+  (c) Copyright 1998 - 2003  Brad Martin
+  (c) Copyright 1998 - 2006  Charles Bilyue'
+
+  Sound emulator code used in 1.52+
+  (c) Copyright 2004 - 2007  Shay Green (gblargg@gmail.com)
+
+  SH assembler code partly based on x86 assembler code
+  (c) Copyright 2002 - 2004  Marcus Comstedt (marcus@mc.pp.se)
+
+  2xSaI filter
+  (c) Copyright 1999 - 2001  Derek Liauw Kie Fa
+
+  HQ2x, HQ3x, HQ4x filters
+  (c) Copyright 2003         Maxim Stepin (maxim@hiend3d.com)
+
+  NTSC filter
+  (c) Copyright 2006 - 2007  Shay Green
+
+  GTK+ GUI code
+  (c) Copyright 2004 - 2011  BearOso
+
+  Win32 GUI code
+  (c) Copyright 2003 - 2006  blip,
+                             funkyass,
+                             Matthew Kendora,
+                             Nach,
+                             nitsuja
+  (c) Copyright 2009 - 2011  OV2
+
+  Mac OS GUI code
+  (c) Copyright 1998 - 2001  John Stiles
+  (c) Copyright 2001 - 2011  zones
+
+
+  Specific ports contains the works of other authors. See headers in
+  individual files.
+
+
+  Snes9x homepage: http://www.snes9x.com/
+
+  Permission to use, copy, modify and/or distribute Snes9x in both binary
+  and source form, for non-commercial purposes, is hereby granted without
+  fee, providing that this license information and copyright notice appear
+  with all copies and any derived work.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event shall the authors be held liable for any damages
+  arising from the use of this software or it's derivatives.
+
+  Snes9x is freeware for PERSONAL USE only. Commercial users should
+  seek permission of the copyright holders first. Commercial use includes,
+  but is not limited to, charging money for Snes9x or software derived from
+  Snes9x, including Snes9x or derivatives in commercial game bundles, and/or
+  using Snes9x as a promotion for your commercial product.
+
+  The copyright holders request that bug fixes and improvements to the code
+  should be forwarded to them so everyone can benefit from the modifications
+  in future versions.
+
+  Super NES and Super Nintendo Entertainment System are trademarks of
+  Nintendo Co., Limited and its subsidiary companies.
+ ***********************************************************************************/
+
+
+#include "snes9x.h"
+#include "snapshot.h"
+#include "profiler.h"
+#include "rewind.h"
+
+#include <new>
+
+#ifndef min
+#define min(a,b)	(((a) < (b)) ? (a) : (b))
+#endif
+
+// shorter runs of unchanged bytes are cheaper to store as part of the changed ones
+#define REWIND_MIN_SAME_RUN	16
+
+static S9X_TLS struct SRewind
+{
+	uint8	*Ring;					// deltas, each as [size][delta][size]
+	uint32	Capacity;
+	uint32	Head;					// end of the newest delta
+	uint32	Tail;					// start of the oldest delta
+	uint32	Used;
+	uint32	Count;
+	uint8	*State;					// newest snapshot
+	uint8	*Scratch;				// snapshot being taken
+	uint8	*Delta;					// delta being stored or applied
+	uint32	StateSize;
+	bool8	HaveState;
+	uint32	Interval;
+	uint32	FramesSinceCapture;
+	uint32	LastDeltaSize;
+	uint64	Captures;
+	uint64	Evictions;
+}	Rewind;
+
+static inline uint32 Load32 (const uint8 *ptr)
+{
+	uint32	value;
+	memcpy(&value, ptr, 4);
+	return (value);
+}
+
+static inline void Store32 (uint8 *ptr, uint32 value)
+{
+	memcpy(ptr, &value, 4);
+}
+
+static inline uint64 Load64 (const uint8 *ptr)
+{
+	uint64	value;
+	memcpy(&value, ptr, 8);
+	return (value);
+}
+
+// Stores cur XOR prev as a sequence of [unchanged count][changed count][changed bytes XORed].
+// Needs at most size * 3 / 2 + 16 bytes, as every token but the first skips 16 bytes or more.
+static uint32 EncodeDelta (uint8 *out, const uint8 *cur, const uint8 *prev, uint32 size)
+{
+	uint8	*ptr = out;
+	uint32	i = 0;
+
+	while (i < size)
+	{
+		uint32	start = i;
+
+		while (i + 8 <= size && Load64(cur + i) == Load64(prev + i))
+			i += 8;
+		while (i < size && cur[i] == prev[i])
+			i++;
+
+		uint32	changed = i, same = 0;
+
+		while (i < size && same < REWIND_MIN_SAME_RUN)
+		{
+			same = (cur[i] == prev[i]) ? same + 1 : 0;
+			i++;
+		}
+
+		if (same == REWIND_MIN_SAME_RUN)
+			i -= same;
+
+		Store32(ptr, changed - start);
+		Store32(ptr + 4, i - changed);
+		ptr += 8;
+
+		for (uint32 j = changed; j < i; j++)
+			*ptr++ = cur[j] ^ prev[j];
+	}
+
+	return (ptr - out);
+}
+
+static void ApplyDelta (uint8 *state, const uint8 *delta, uint32 len)
+{
+	const uint8	*end = delta + len;
+	uint32		pos = 0;
+
+	while (delta < end)
+	{
+		uint32	count;
+
+		pos += Load32(delta);
+		count = Load32(delta + 4);
+		delta += 8;
+
+		for (uint32 j = 0; j < count; j++)
+			state[pos++] ^= *delta++;
+	}
+}
+
+static void RingWrite (uint32 pos, const uint8 *src, uint32 len)
+{
+	uint32	first = min(len, Rewind.Capacity - pos);
+
+	memcpy(Rewind.Ring + pos, src, first);
+	memcpy(Rewind.Ring, src + first, len - first);
+}
+
+static void RingRead (uint32 pos, uint8 *dst, uint32 len)
+{
+	uint32	first = min(len, Rewind.Capacity - pos);
+
+	memcpy(dst, Rewind.Ring + pos, first);
+	memcpy(dst + first, Rewind.Ring, len - first);
+}
+
+// pos moved by n <= Capacity either way; never adds Capacity, so it can't overflow past 2 GiB
+static uint32 RingForward (uint32 pos, uint32 n)
+{
+	return (n < Rewind.Capacity - pos ? pos + n : n - (Rewind.Capacity - pos));
+}
+
+static uint32 RingBack (uint32 pos, uint32 n)
+{
+	return (n <= pos ? pos - n : Rewind.Capacity - (n - pos));
+}
+
+static uint32 RingSize (uint32 pos)
+{
+	uint8	size[4];
+
+	RingRead(pos, size, 4);
+	return (Load32(size));
+}
+
+static void PushDelta (uint32 len)
+{
+	uint32	entry = len + 8;
+	uint8	size[4];
+
+	// too large to ever fit, so the history has to start over
+	if (entry > Rewind.Capacity)
+	{
+		Rewind.Evictions += Rewind.Count;
+		Rewind.Head = Rewind.Tail = Rewind.Used = Rewind.Count = 0;
+		return;
+	}
+
+	while (Rewind.Capacity - Rewind.Used < entry)
+	{
+		uint32	oldest = RingSize(Rewind.Tail) + 8;
+
+		Rewind.Tail = RingForward(Rewind.Tail, oldest);
+		Rewind.Used -= oldest;
+		Rewind.Count--;
+		Rewind.Evictions++;
+	}
+
+	Store32(size, len);
+	RingWrite(Rewind.Head, size, 4);
+	RingWrite(RingForward(Rewind.Head, 4), Rewind.Delta, len);
+	RingWrite(RingForward(Rewind.Head, 4 + len), size, 4);
+
+	Rewind.Head = RingForward(Rewind.Head, entry);
+	Rewind.Used += entry;
+	Rewind.Count++;
+}
+
+static uint32 PopDelta (void)
+{
+	uint32	len = RingSize(RingBack(Rewind.Head, 4));
+	uint32	start = RingBack(Rewind.Head, len + 8);
+
+	RingRead(RingForward(start, 4), Rewind.Delta, len);
+
+	Rewind.Head = start;
+	Rewind.Used -= len + 8;
+	Rewind.Count--;
+
+	return (len);
+}
+
+static bool8 AllocateStates (uint32 size)
+{
+	delete [] Rewind.State;
+	delete [] Rewind.Scratch;
+	delete [] Rewind.Delta;
+
+	Rewind.State = new (std::nothrow) uint8[size];
+	Rewind.Scratch = new (std::nothrow) uint8[size];
+	Rewind.Delta = new (std::nothrow) uint8[size + size / 2 + 16];
+	Rewind.StateSize = size;
+
+	return (Rewind.State && Rewind.Scratch && Rewind.Delta);
+}
+
+bool8 S9xRewindInit (uint32 capacity_mb, uint32 interval)
+{
+	S9xRewindDeinit();
+
+	if (capacity_mb == 0)
+		return (TRUE);
+
+	// ring offsets are 32-bit, see RingForward()
+	if (capacity_mb > 4095)
+		capacity_mb = 4095;
+
+	Rewind.Capacity = capacity_mb << 20;
+	Rewind.Ring = new (std::nothrow) uint8[Rewind.Capacity];
+	Rewind.Interval = interval ? interval : 1;
+
+	if (!Rewind.Ring)
+	{
+		S9xRewindDeinit();
+		return (FALSE);
+	}
+
+	return (TRUE);
+}
+
+void S9xRewindDeinit (void)
+{
+	delete [] Rewind.Ring;
+	delete [] Rewind.State;
+	delete [] Rewind.Scratch;
+	delete [] Rewind.Delta;
+
+	memset(&Rewind, 0, sizeof(Rewind));
+}
+
+void S9xRewindReset (void)
+{
+	Rewind.Head = Rewind.Tail = Rewind.Used = Rewind.Count = 0;
+	Rewind.HaveState = FALSE;
+	Rewind.FramesSinceCapture = 0;
+}
+
+void S9xRewindFrame (void)
+{
+	if (!Rewind.Ring)
+		return;
+
+	if (Rewind.HaveState && ++Rewind.FramesSinceCapture < Rewind.Interval)
+		return;
+
+	S9X_PROFILE(S9X_PROFILE_REWIND);
+
+	uint32	size = S9xFreezeSize();
+
+	if (size != Rewind.StateSize)
+	{
+		S9xRewindReset();
+
+		if (!AllocateStates(size))
+		{
+			S9xRewindDeinit();
+			return;
+		}
+	}
+
+	S9xFreezeToMemory(Rewind.Scratch, size);
+
+	if (Rewind.HaveState)
+	{
+		// the delta leads from the new snapshot back to the previous one
+		Rewind.LastDeltaSize = EncodeDelta(Rewind.Delta, Rewind.Scratch, Rewind.State, size);
+		PushDelta(Rewind.LastDeltaSize);
+	}
+
+	uint8	*newest = Rewind.Scratch;
+	Rewind.Scratch = Rewind.State;
+	Rewind.State = newest;
+
+	Rewind.HaveState = TRUE;
+	Rewind.FramesSinceCapture = 0;
+	Rewind.Captures++;
+}
+
+bool8 S9xRewindStep (void)
+{
+	if (!Rewind.HaveState)
+		return (FALSE);
+
+	if (Rewind.FramesSinceCapture == 0)
+	{
+		if (Rewind.Count == 0)
+			return (FALSE);
+
+		ApplyDelta(Rewind.State, Rewind.Delta, PopDelta());
+	}
+
+	if (S9xUnfreezeFromMemory(Rewind.State, Rewind.StateSize) != SUCCESS)
+	{
+		S9xRewindReset();
+		return (FALSE);
+	}
+
+	Rewind.FramesSinceCapture = 0;
+
+	return (TRUE);
+}
+
+void S9xRewindGetStats (struct SRewindStats *stats)
+{
+	stats->Capacity = Rewind.Capacity;
+	stats->Used = Rewind.Used;
+	stats->StateSize = Rewind.StateSize;
+	stats->Snapshots = Rewind.Count + (Rewind.HaveState && Rewind.FramesSinceCapture > 0 ? 1 : 0);
+	stats->Frames = Rewind.Count * Rewind.Interval + Rewind.FramesSinceCapture;
+	stats->LastDeltaSize = Rewind.LastDeltaSize;
+	stats->Captures = Rewind.Captures;
+	stats->Evictions = Rewind.Evictions;
+}
@@ -178,8 +178,9 @@
 
 #include "snes9x.h"
 #include "memmap.h"
+#include "dirty.h"
 
-uint8	SA1OpenBus;
+S9X_TLS uint8	SA1OpenBus;
 
 static void S9xSA1SetBWRAMMemMap (uint8);
 static void S9xSetSA1MemMap (uint32, uint8);
@@ -291,6 +292,31 @@ void S9xSA1PostLoadState (void)
 	S9xSA1SetBWRAMMemMap(Memory.FillRAM[0x2225]);
 }
 
+void S9xSA1CatchUp (void)
+{
+	uint32	count = SA1.Owed;
+	bool8	pending = CPU.IRQExternalPending;
+
+	SA1.Owed = 0;
+	CPU.IRQExternalPending = FALSE;
+
+	uint32	raised = S9xSA1RunSlices(count, &CPU.IRQExternal);
+
+	if (pending && raised && SA1.IRQChecks >= raised)
+	{
+		// the boundaries since the slice that raised the IRQ would have counted IRQPending down, see S9xDoInterruptLines()
+		int32	left = SA1.IRQChecks - raised + 1;
+
+		if (left > CPU.IRQPending)
+		{
+			left -= CPU.IRQPending + 1;
+			CPU.IRQPending = Timings.IRQPendCount - left % (Timings.IRQPendCount + 1);
+		}
+		else
+			CPU.IRQPending -= left;
+	}
+}
+
 static void S9xSetSA1MemMap (uint32 which1, uint8 map)
 {
 	int	start  = which1 * 0x100 + 0xc00;
@@ -961,6 +987,7 @@ void S9xSA1SetByte (uint8 byte, uint32 address)
 	if (SetAddress >= (uint8 *) CMemory::MAP_LAST)
 	{
 		*(SetAddress + (address & 0xffff)) = byte;
+		S9X_DIRTY_POINTER(SetAddress + (address & 0xffff));
 		return;
 	}
 
@@ -973,10 +1000,12 @@ void S9xSA1SetByte (uint8 byte, uint32 address)
 		case CMemory::MAP_LOROM_SRAM:
 		case CMemory::MAP_SA1RAM:
 			*(Memory.SRAM + (address & 0xffff)) = byte;
+			S9X_DIRTY(S9X_DIRTY_SRAM, address & 0xffff);
 			return;
 
 		case CMemory::MAP_BWRAM:
 			*(SA1.BWRAM + ((address & 0x7fff) - 0x6000)) = byte;
+			S9X_DIRTY_POINTER(SA1.BWRAM + ((address & 0x7fff) - 0x6000));
 			return;
 
 		case CMemory::MAP_BWRAM_BITMAP:
@@ -986,12 +1015,14 @@ void S9xSA1SetByte (uint8 byte, uint32 address)
 				uint8	*ptr = &Memory.SRAM[(address >> 2) & 0xffff];
 				*ptr &= ~(3  << ((address & 3) << 1));
 				*ptr |= (byte &  3) << ((address & 3) << 1);
+				S9X_DIRTY_POINTER(ptr);
 			}
 			else
 			{
 				uint8	*ptr = &Memory.SRAM[(address >> 1) & 0xffff];
 				*ptr &= ~(15 << ((address & 1) << 2));
 				*ptr |= (byte & 15) << ((address & 1) << 2);
+				S9X_DIRTY_POINTER(ptr);
 			}
 
 			return;
@@ -1003,12 +1034,14 @@ void S9xSA1SetByte (uint8 byte, uint32 address)
 				uint8	*ptr = &SA1.BWRAM[(address >> 2) & 0xffff];
 				*ptr &= ~(3  << ((address & 3) << 1));
 				*ptr |= (byte &  3) << ((address & 3) << 1);
+				S9X_DIRTY_POINTER(ptr);
 			}
 			else
 			{
 				uint8	*ptr = &SA1.BWRAM[(address >> 1) & 0xffff];
 				*ptr &= ~(15 << ((address & 1) << 2));
 				*ptr |= (byte & 15) << ((address & 1) << 2);
+				S9X_DIRTY_POINTER(ptr);
 			}
 
 			return;
@@ -228,6 +228,9 @@ struct SSA1
 	bool8	overflow;
 	uint8	VirtualBitmapFormat;
 	uint8	variable_bit_pos;
+
+	uint32	Owed;			// slices S9xSA1Step() left for S9xSA1Sync()
+	uint32	IRQChecks;		// instruction boundaries S9xSA1CheckIRQ() counted meanwhile
 };
 
 #define SA1CheckCarry()		(SA1._Carry)
@@ -244,9 +247,9 @@ struct SSA1
 #define SA1ClearFlags(f)	(SA1Registers.P.W &= ~(f))
 #define SA1CheckFlag(f)		(SA1Registers.PL & (f))
 
-extern struct SSA1Registers	SA1Registers;
-extern struct SSA1			SA1;
-extern uint8				SA1OpenBus;
+extern S9X_TLS struct SSA1Registers	SA1Registers;
+extern S9X_TLS struct SSA1			SA1;
+extern S9X_TLS uint8				SA1OpenBus;
 extern struct SOpcodes		S9xSA1OpcodesM1X1[256];
 extern struct SOpcodes		S9xSA1OpcodesM1X0[256];
 extern struct SOpcodes		S9xSA1OpcodesM0X1[256];
@@ -265,8 +268,74 @@ uint8 S9xGetSA1 (uint32);
 void S9xSetSA1 (uint8, uint32);
 void S9xSA1Init (void);
 void S9xSA1MainLoop (void);
+uint32 S9xSA1RunSlices (uint32, const bool8 *);
 void S9xSA1PostLoadState (void);
 
+// SA-1 catch-up. With Settings.SA1CatchUp the slice of SA-1 instructions that follows every S-CPU
+// instruction isn't run right away but owed, and S9xSA1Sync() runs all owed slices in one go. That
+// happens on S-CPU accesses to the SA-1 registers, I-RAM and BW-RAM (mapped as MAP_SA1_IRAM and
+// MAP_SA1_BWRAM for the S-CPU), at the S-CPU interrupt vectors, DMA and HDMA, at the end of every
+// scanline, at the first instruction boundary where an IRQ raised by the SA-1 would be seen, and
+// around frame ends, snapshots, cheats and resets. While the S-CPU runs code from I-RAM or BW-RAM,
+// whose fetches don't sync, and while it could take an IRQ from the SA-1 right away, which would
+// sync at every boundary, slices run in place. Nothing else can see the SA-1 run, so it ends up
+// exactly as if every slice had run in place.
+void S9xSA1CatchUp (void);
+
+static inline void S9xSA1Sync (void)
+{
+	if (SA1.Owed)
+		S9xSA1CatchUp();
+}
+
+// whether the S-CPU could take an IRQ at the next instruction boundary
+static inline bool8 S9xSA1IRQTakeable (void)
+{
+	return (CPU.NMILine || !CheckFlag(IRQ) || CPU.WaitingForInterrupt || CPU.IRQTransition);
+}
+
+static inline void S9xSA1Owe (void)
+{
+	SA1.Owed = 1;
+	SA1.IRQChecks = 0;
+
+	// the owed slices may raise the S-CPU IRQ, see S9xSA1CheckIRQ()
+	CPU.IRQExternalPending = !CPU.IRQExternal && (Memory.FillRAM[0x2201] & 0xa0);
+}
+
+// instruction boundary while CPU.IRQExternalPending is set
+static inline void S9xSA1CheckIRQ (void)
+{
+	// as long as the IRQ couldn't be taken, it could only have counted IRQPending down
+	if (S9xSA1IRQTakeable())
+		S9xSA1Sync();
+	else
+		SA1.IRQChecks++;
+}
+
+// whether the next S-CPU instruction comes from memory the SA-1 can write
+static inline bool8 S9xSA1SharesPC (void)
+{
+	uint8	*GetAddress = Memory.Map[(ICPU.ShiftedPB + Registers.PCw) >> MEMMAP_SHIFT];
+
+	return (GetAddress == (uint8 *) CMemory::MAP_SA1_IRAM || GetAddress == (uint8 *) CMemory::MAP_SA1_BWRAM || GetAddress == (uint8 *) CMemory::MAP_BWRAM);
+}
+
+// after every S-CPU instruction
+static inline void S9xSA1Step (void)
+{
+	if (!Settings.SA1CatchUp || S9xSA1SharesPC() || (!CPU.IRQExternal && (Memory.FillRAM[0x2201] & 0xa0) && S9xSA1IRQTakeable()))
+	{
+		S9xSA1Sync();
+		S9xSA1MainLoop();
+	}
+	else
+	if (!SA1.Owed)
+		S9xSA1Owe();
+	else
+		SA1.Owed++;
+}
+
 static inline void S9xSA1UnpackStatus (void)
 {
 	SA1._Zero = (SA1Registers.PL & Zero) == 0;
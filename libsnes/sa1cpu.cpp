@@ -178,6 +178,7 @@
 
 #include "snes9x.h"
 #include "memmap.h"
+#include "profiler.h"
 
 #define CPU								SA1
 #define ICPU							SA1
@@ -187,6 +188,10 @@
 #define S9xGetWord						S9xSA1GetWord
 #define S9xSetByte						S9xSA1SetByte
 #define S9xSetWord						S9xSA1SetWord
+#define S9xGetByteBank0					S9xSA1GetByte
+#define S9xGetWordBank0					S9xSA1GetWord
+#define S9xSetByteBank0					S9xSA1SetByte
+#define S9xSetWordBank0					S9xSA1SetWord
 #define S9xSetPCBase					S9xSA1SetPCBase
 #define S9xOpcodesM1X1					S9xSA1OpcodesM1X1
 #define S9xOpcodesM1X0					S9xSA1OpcodesM1X0
@@ -227,6 +232,9 @@
 #include "cpuops.cpp"
 
 static void S9xSA1UpdateTimer (void);
+static void S9xSA1Slice (void);
+static bool8 S9xSA1Idle (void);
+static void S9xSA1SkipWait (uint32);
 
 
 void S9xSA1MainLoop (void)
@@ -238,6 +246,88 @@ void S9xSA1MainLoop (void)
 		return;
 	}
 
+	S9X_PROFILE_SAMPLE(S9X_PROFILE_SA1, 1);
+
+	S9xSA1Slice();
+}
+
+// runs count slices like S9xSA1MainLoop(), returns how many it took until *watch was set (0 if it wasn't)
+uint32 S9xSA1RunSlices (uint32 count, const bool8 *watch)
+{
+	uint32	set = 0;
+
+	S9X_PROFILE_SAMPLE(S9X_PROFILE_SA1, count);
+
+	for (uint32 n = 1; n <= count; n++)
+	{
+		if (Memory.FillRAM[0x2200] & 0x60)
+		{
+			SA1.Cycles += 6; // FIXME
+			S9xSA1UpdateTimer();
+		}
+		else
+			S9xSA1Slice();
+
+		if (!set && *watch)
+			set = n;
+
+		// the S-CPU doesn't run until the batch is over, so nothing can wake the SA-1 before then
+		if (n < count && S9xSA1Idle())
+		{
+			S9xSA1SkipWait(count - n);
+			break;
+		}
+	}
+
+	return (set);
+}
+
+// whether the next slices would only run WAI and move the clock
+static bool8 S9xSA1Idle (void)
+{
+	if (!SA1.WaitingForInterrupt || !SA1.PCBase || SA1.PCBase[SA1Registers.PCw] != 0xcb || (SA1Registers.PCw & MEMMAP_MASK) + 1 >= MEMMAP_BLOCK_SIZE)
+		return (FALSE);
+
+#ifdef DEBUGGER
+	if (SA1.Flags & TRACE_FLAG)
+		return (FALSE);
+#endif
+
+	// halted, timer IRQ on, or an interrupt due (see S9xSA1Slice())
+	if ((Memory.FillRAM[0x2200] & 0x60) || (Memory.FillRAM[0x2210] & 0x03))
+		return (FALSE);
+
+	if ((Memory.FillRAM[0x2200] & 0x10) && !(Memory.FillRAM[0x220b] & 0x10))
+		return (FALSE);
+
+	if (!SA1CheckFlag(IRQ) && ((Memory.FillRAM[0x220a] & 0x60 & ~Memory.FillRAM[0x220b]) || ((Memory.FillRAM[0x2200] & 0x80) && !(Memory.FillRAM[0x220b] & 0x80))))
+		return (FALSE);
+
+	// counters in range, so each slice wraps them at most once (see S9xSA1UpdateTimer())
+	int32	hmax = (Memory.FillRAM[0x2210] & 0x80) ? 0x800 : Timings.H_Max_Master;
+	int32	vmax = (Memory.FillRAM[0x2210] & 0x80) ? 0x200 : Timings.V_Max_Master;
+
+	return (SA1.HCounter >= 0 && SA1.HCounter < hmax && SA1.VCounter >= 0 && SA1.VCounter < vmax &&
+		SA1.Cycles >= 0 && SA1.Cycles < Timings.H_Max_Master && SA1.Cycles == SA1.PrevCycles && !SA1.TimerIRQLastState);
+}
+
+// n slices of WAI at once, ends up where S9xSA1Slice() n times would
+static void S9xSA1SkipWait (uint32 n)
+{
+	int32	slice = 3 * TWO_CYCLES;
+	int32	hmax = (Memory.FillRAM[0x2210] & 0x80) ? 0x800 : Timings.H_Max_Master;
+	int32	vmax = (Memory.FillRAM[0x2210] & 0x80) ? 0x200 : Timings.V_Max_Master;
+	int64	h = SA1.HCounter + (int64) n * slice;
+
+	SA1.HCounter = (int16) (h % hmax);
+	SA1.PrevHCounter = SA1.HCounter - slice;
+	SA1.VCounter = (int16) ((SA1.VCounter + h / hmax) % vmax);
+	SA1.Cycles = (int32) ((SA1.Cycles + (int64) n * slice) % Timings.H_Max_Master);
+	SA1.PrevCycles = SA1.Cycles;
+}
+
+static void S9xSA1Slice (void)
+{
 	// SA-1 NMI
 	if ((Memory.FillRAM[0x2200] & 0x10) && !(Memory.FillRAM[0x220b] & 0x10))
 	{
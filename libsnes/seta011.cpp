@@ -180,8 +180,8 @@
 #include "memmap.h"
 #include "seta.h"
 
-static uint8	board[9][9];	// shougi playboard
-static int		line = 0;		// line counter
+static S9X_TLS uint8	board[9][9];	// shougi playboard
+static S9X_TLS int	line = 0;		// line counter
 
 
 uint8 S9xGetST011 (uint32 Address)
@@ -207,7 +207,7 @@ uint8 S9xGetST011 (uint32 Address)
 
 void S9xSetST011 (uint32 Address, uint8 Byte)
 {
-	static bool	reset   = false;
+	static S9X_TLS bool	reset   = false;
 	uint16		address = (uint16) Address & 0xFFFF;
 
 	line++;
@@ -341,7 +341,39 @@ struct SnapshotScreenshotInfo
 	uint8	Data[MAX_SNES_WIDTH * MAX_SNES_HEIGHT * 3];
 };
 
-static struct Obsolete
+// packed sections of a snapshot, NULL if absent
+struct SnapshotBlocks
+{
+	uint8	*cpu;
+	uint8	*registers;
+	uint8	*ppu;
+	uint8	*dma;
+	uint8	*vram;
+	uint8	*ram;
+	uint8	*sram;
+	uint8	*fillram;
+	uint8	*apu_sound;
+	uint8	*control_data;
+	uint8	*timing_data;
+	uint8	*superfx;
+	uint8	*sa1;
+	uint8	*sa1_registers;
+	uint8	*dsp1;
+	uint8	*dsp2;
+	uint8	*dsp4;
+	uint8	*cx4_data;
+	uint8	*st010;
+	uint8	*obc1;
+	uint8	*obc1_data;
+	uint8	*spc7110;
+	uint8	*srtc;
+	uint8	*rtc_data;
+	uint8	*bsx_data;
+	uint8	*screenshot;
+	uint8	*movie_data;
+};
+
+static S9X_TLS struct Obsolete
 {
 	uint8	CPU_IRQActive;
 }	Obsolete;
@@ -1147,13 +1179,16 @@ static int UnfreezeBlockCopy (STREAM, const char *, uint8 **, int);
 static int UnfreezeStruct (STREAM, const char *, void *, FreezeData *, int, int);
 static int UnfreezeStructCopy (STREAM, const char *, uint8 **, FreezeData *, int, int);
 static void UnfreezeStructFromCopy (void *, FreezeData *, int, uint8 *, int);
+static void UnfreezeSnapshotBlocks (struct SnapshotBlocks *, int);
 static void FreezeBlock (STREAM, const char *, uint8 *, int);
 static void FreezeStruct (STREAM, const char *, void *, FreezeData *, int);
+static uint8 * PackStruct (uint8 *, void *, FreezeData *, int);
+static int StructSize (FreezeData *, int, int);
 
 
 void S9xResetSaveTimer (bool8 dontsave)
 {
-	static time_t	t = -1;
+	static S9X_TLS time_t	t = -1;
 
 	if (!Settings.DontSaveOopsSnapshot && !dontsave && t != -1 && time(NULL) - t > 300)
 	{
@@ -1271,6 +1306,9 @@ void S9xFreezeToStream (STREAM stream)
 	char	buffer[1024];
 	uint8	*soundsnapshot = new uint8[SPC_SAVE_STATE_BLOCK_SIZE];
 
+	S9xSuperFXSync();
+	S9xSA1Sync();
+
 	S9xSetSoundMute(TRUE);
 
 	sprintf(buffer, "%s:%04d\n", SNAPSHOT_MAGIC, SNAPSHOT_VERSION);
@@ -1419,6 +1457,9 @@ int S9xUnfreezeFromStream (STREAM stream)
 	int		version, len;
 	char	buffer[PATH_MAX + 1];
 
+	S9xSuperFXSync();
+	S9xSA1Sync();
+
 	len = strlen(SNAPSHOT_MAGIC) + 1 + 4 + 1;
 	if (READ_STREAM(buffer, len, stream) != len)
 		return (WRONG_FORMAT);
@@ -1434,137 +1475,112 @@ int S9xUnfreezeFromStream (STREAM stream)
 	if (result != SUCCESS)
 		return (result);
 
-	uint8	*local_cpu           = NULL;
-	uint8	*local_registers     = NULL;
-	uint8	*local_ppu           = NULL;
-	uint8	*local_dma           = NULL;
-	uint8	*local_vram          = NULL;
-	uint8	*local_ram           = NULL;
-	uint8	*local_sram          = NULL;
-	uint8	*local_fillram       = NULL;
-	uint8	*local_apu_sound     = NULL;
-	uint8	*local_control_data  = NULL;
-	uint8	*local_timing_data   = NULL;
-	uint8	*local_superfx       = NULL;
-	uint8	*local_sa1           = NULL;
-	uint8	*local_sa1_registers = NULL;
-	uint8	*local_dsp1          = NULL;
-	uint8	*local_dsp2          = NULL;
-	uint8	*local_dsp4          = NULL;
-	uint8	*local_cx4_data      = NULL;
-	uint8	*local_st010         = NULL;
-	uint8	*local_obc1          = NULL;
-	uint8	*local_obc1_data     = NULL;
-	uint8	*local_spc7110       = NULL;
-	uint8	*local_srtc          = NULL;
-	uint8	*local_rtc_data      = NULL;
-	uint8	*local_bsx_data      = NULL;
-	uint8	*local_screenshot    = NULL;
-	uint8	*local_movie_data    = NULL;
+	struct SnapshotBlocks	blocks;
+	memset(&blocks, 0, sizeof(blocks));
 
 	do
 	{
-		result = UnfreezeStructCopy(stream, "CPU", &local_cpu, SnapCPU, COUNT(SnapCPU), version);
+		result = UnfreezeStructCopy(stream, "CPU", &blocks.cpu, SnapCPU, COUNT(SnapCPU), version);
 		if (result != SUCCESS)
 			break;
 
-		result = UnfreezeStructCopy(stream, "REG", &local_registers, SnapRegisters, COUNT(SnapRegisters), version);
+		result = UnfreezeStructCopy(stream, "REG", &blocks.registers, SnapRegisters, COUNT(SnapRegisters), version);
 		if (result != SUCCESS)
 			break;
 
-		result = UnfreezeStructCopy(stream, "PPU", &local_ppu, SnapPPU, COUNT(SnapPPU), version);
+		result = UnfreezeStructCopy(stream, "PPU", &blocks.ppu, SnapPPU, COUNT(SnapPPU), version);
 		if (result != SUCCESS)
 			break;
 
-		result = UnfreezeStructCopy(stream, "DMA", &local_dma, SnapDMA, COUNT(SnapDMA), version);
+		result = UnfreezeStructCopy(stream, "DMA", &blocks.dma, SnapDMA, COUNT(SnapDMA), version);
 		if (result != SUCCESS)
 			break;
 
-		result = UnfreezeBlockCopy (stream, "VRA", &local_vram, 0x10000);
+		result = UnfreezeBlockCopy (stream, "VRA", &blocks.vram, 0x10000);
 		if (result != SUCCESS)
 			break;
 
-		result = UnfreezeBlockCopy (stream, "RAM", &local_ram, 0x20000);
+		result = UnfreezeBlockCopy (stream, "RAM", &blocks.ram, 0x20000);
 		if (result != SUCCESS)
 			break;
 
-		result = UnfreezeBlockCopy (stream, "SRA", &local_sram, 0x20000);
+		result = UnfreezeBlockCopy (stream, "SRA", &blocks.sram, 0x20000);
 		if (result != SUCCESS)
 			break;
 
-		result = UnfreezeBlockCopy (stream, "FIL", &local_fillram, 0x8000);
+		result = UnfreezeBlockCopy (stream, "FIL", &blocks.fillram, 0x8000);
 		if (result != SUCCESS)
 			break;
 
-		result = UnfreezeBlockCopy (stream, "SND", &local_apu_sound, SPC_SAVE_STATE_BLOCK_SIZE);
+		result = UnfreezeBlockCopy (stream, "SND", &blocks.apu_sound, SPC_SAVE_STATE_BLOCK_SIZE);
 		if (result != SUCCESS)
 			break;
 
-		result = UnfreezeStructCopy(stream, "CTL", &local_control_data, SnapControls, COUNT(SnapControls), version);
+		result = UnfreezeStructCopy(stream, "CTL", &blocks.control_data, SnapControls, COUNT(SnapControls), version);
 		if (result != SUCCESS)
 			break;
 
-		result = UnfreezeStructCopy(stream, "TIM", &local_timing_data, SnapTimings, COUNT(SnapTimings), version);
+		result = UnfreezeStructCopy(stream, "TIM", &blocks.timing_data, SnapTimings, COUNT(SnapTimings), version);
 		if (result != SUCCESS)
 			break;
 
-		result = UnfreezeStructCopy(stream, "SFX", &local_superfx, SnapFX, COUNT(SnapFX), version);
+		result = UnfreezeStructCopy(stream, "SFX", &blocks.superfx, SnapFX, COUNT(SnapFX), version);
 		if (result != SUCCESS && Settings.SuperFX)
 			break;
 
-		result = UnfreezeStructCopy(stream, "SA1", &local_sa1, SnapSA1, COUNT(SnapSA1), version);
+		result = UnfreezeStructCopy(stream, "SA1", &blocks.sa1, SnapSA1, COUNT(SnapSA1), version);
 		if (result != SUCCESS && Settings.SA1)
 			break;
 
-		result = UnfreezeStructCopy(stream, "SAR", &local_sa1_registers, SnapSA1Registers, COUNT(SnapSA1Registers), version);
+		result = UnfreezeStructCopy(stream, "SAR", &blocks.sa1_registers, SnapSA1Registers, COUNT(SnapSA1Registers), version);
 		if (result != SUCCESS && Settings.SA1)
 			break;
 
-		result = UnfreezeStructCopy(stream, "DP1", &local_dsp1, SnapDSP1, COUNT(SnapDSP1), version);
+		result = UnfreezeStructCopy(stream, "DP1", &blocks.dsp1, SnapDSP1, COUNT(SnapDSP1), version);
 		if (result != SUCCESS && Settings.DSP == 1)
 			break;
 
-		result = UnfreezeStructCopy(stream, "DP2", &local_dsp2, SnapDSP2, COUNT(SnapDSP2), version);
+		result = UnfreezeStructCopy(stream, "DP2", &blocks.dsp2, SnapDSP2, COUNT(SnapDSP2), version);
 		if (result != SUCCESS && Settings.DSP == 2)
 			break;
 
-		result = UnfreezeStructCopy(stream, "DP4", &local_dsp4, SnapDSP4, COUNT(SnapDSP4), version);
+		result = UnfreezeStructCopy(stream, "DP4", &blocks.dsp4, SnapDSP4, COUNT(SnapDSP4), version);
 		if (result != SUCCESS && Settings.DSP == 4)
 			break;
 
-		result = UnfreezeBlockCopy (stream, "CX4", &local_cx4_data, 8192);
+		result = UnfreezeBlockCopy (stream, "CX4", &blocks.cx4_data, 8192);
 		if (result != SUCCESS && Settings.C4)
 			break;
 
-		result = UnfreezeStructCopy(stream, "ST0", &local_st010, SnapST010, COUNT(SnapST010), version);
+		result = UnfreezeStructCopy(stream, "ST0", &blocks.st010, SnapST010, COUNT(SnapST010), version);
 		if (result != SUCCESS && Settings.SETA == ST_010)
 			break;
 
-		result = UnfreezeStructCopy(stream, "OBC", &local_obc1, SnapOBC1, COUNT(SnapOBC1), version);
+		result = UnfreezeStructCopy(stream, "OBC", &blocks.obc1, SnapOBC1, COUNT(SnapOBC1), version);
 		if (result != SUCCESS && Settings.OBC1)
 			break;
 
-		result = UnfreezeBlockCopy (stream, "OBM", &local_obc1_data, 8192);
+		result = UnfreezeBlockCopy (stream, "OBM", &blocks.obc1_data, 8192);
 		if (result != SUCCESS && Settings.OBC1)
 			break;
 
-		result = UnfreezeStructCopy(stream, "S71", &local_spc7110, SnapSPC7110Snap, COUNT(SnapSPC7110Snap), version);
+		result = UnfreezeStructCopy(stream, "S71", &blocks.spc7110, SnapSPC7110Snap, COUNT(SnapSPC7110Snap), version);
 		if (result != SUCCESS && Settings.SPC7110)
 			break;
 
-		result = UnfreezeStructCopy(stream, "SRT", &local_srtc, SnapSRTCSnap, COUNT(SnapSRTCSnap), version);
+		result = UnfreezeStructCopy(stream, "SRT", &blocks.srtc, SnapSRTCSnap, COUNT(SnapSRTCSnap), version);
 		if (result != SUCCESS && Settings.SRTC)
 			break;
 
-		result = UnfreezeBlockCopy (stream, "CLK", &local_rtc_data, 20);
+		result = UnfreezeBlockCopy (stream, "CLK", &blocks.rtc_data, 20);
 		if (result != SUCCESS && (Settings.SRTC || Settings.SPC7110RTC))
 			break;
 
-		result = UnfreezeStructCopy(stream, "BSX", &local_bsx_data, SnapBSX, COUNT(SnapBSX), version);
+		result = UnfreezeStructCopy(stream, "BSX", &blocks.bsx_data, SnapBSX, COUNT(SnapBSX), version);
 		if (result != SUCCESS && Settings.BS)
 			break;
 
-		result = UnfreezeStructCopy(stream, "SHO", &local_screenshot, SnapScreenshot, COUNT(SnapScreenshot), version);
+		result = UnfreezeStructCopy(stream, "SHO", &blocks.screenshot, SnapScreenshot, COUNT(SnapScreenshot), version);
 
 		SnapshotMovieInfo	mi;
 
@@ -1579,7 +1595,7 @@ int S9xUnfreezeFromStream (STREAM stream)
 		}
 		else
 		{
-			result = UnfreezeBlockCopy(stream, "MID", &local_movie_data, mi.MovieInputDataSize);
+			result = UnfreezeBlockCopy(stream, "MID", &blocks.movie_data, mi.MovieInputDataSize);
 			if (result != SUCCESS)
 			{
 				if (S9xMovieActive())
@@ -1591,7 +1607,7 @@ int S9xUnfreezeFromStream (STREAM stream)
 
 			if (S9xMovieActive())
 			{
-				result = S9xMovieUnfreeze(local_movie_data, mi.MovieInputDataSize);
+				result = S9xMovieUnfreeze(blocks.movie_data, mi.MovieInputDataSize);
 				if (result != SUCCESS)
 					break;
 			}
@@ -1602,265 +1618,545 @@ int S9xUnfreezeFromStream (STREAM stream)
 
 	if (result == SUCCESS)
 	{
-		uint32 old_flags     = CPU.Flags;
-		uint32 sa1_old_flags = SA1.Flags;
-
 		S9xSetSoundMute(TRUE);
 
-		S9xReset();
+		UnfreezeSnapshotBlocks(&blocks, version);
 
-		UnfreezeStructFromCopy(&CPU, SnapCPU, COUNT(SnapCPU), local_cpu, version);
+		if (blocks.screenshot)
+		{
+			SnapshotScreenshotInfo	*ssi = new SnapshotScreenshotInfo;
 
-		UnfreezeStructFromCopy(&Registers, SnapRegisters, COUNT(SnapRegisters), local_registers, version);
+			UnfreezeStructFromCopy(ssi, SnapScreenshot, COUNT(SnapScreenshot), blocks.screenshot, version);
 
-		UnfreezeStructFromCopy(&PPU, SnapPPU, COUNT(SnapPPU), local_ppu, version);
+			IPPU.RenderedScreenWidth  = min(ssi->Width,  IMAGE_WIDTH);
+			IPPU.RenderedScreenHeight = min(ssi->Height, IMAGE_HEIGHT);
+			const bool8 scaleDownX = IPPU.RenderedScreenWidth  < ssi->Width;
+			const bool8 scaleDownY = IPPU.RenderedScreenHeight < ssi->Height && ssi->Height > SNES_HEIGHT_EXTENDED;
+			GFX.DoInterlace = Settings.SupportHiRes ? ssi->Interlaced : 0;
 
-		struct SDMASnapshot	dma_snap;
-		UnfreezeStructFromCopy(&dma_snap, SnapDMA, COUNT(SnapDMA), local_dma, version);
+			uint8	*rowpix = ssi->Data;
+			uint16	*screen = GFX.Screen;
 
-		memcpy(Memory.VRAM, local_vram, 0x10000);
+			for (int y = 0; y < IPPU.RenderedScreenHeight; y++, screen += GFX.RealPPL)
+			{
+				for (int x = 0; x < IPPU.RenderedScreenWidth; x++)
+				{
+					uint32	r, g, b;
 
-		memcpy(Memory.RAM, local_ram, 0x20000);
+					r = *(rowpix++);
+					g = *(rowpix++);
+					b = *(rowpix++);
 
-		memcpy(Memory.SRAM, local_sram, 0x20000);
+					if (scaleDownX)
+					{
+						r = (r + *(rowpix++)) >> 1;
+						g = (g + *(rowpix++)) >> 1;
+						b = (b + *(rowpix++)) >> 1;
 
-		memcpy(Memory.FillRAM, local_fillram, 0x8000);
+						if (x + x + 1 >= ssi->Width)
+							break;
+					}
 
-		S9xAPULoadState(local_apu_sound);
+					screen[x] = BUILD_PIXEL(r, g, b);
+				}
 
-		struct SControlSnapshot	ctl_snap;
-		UnfreezeStructFromCopy(&ctl_snap, SnapControls, COUNT(SnapControls), local_control_data, version);
+				if (scaleDownY)
+				{
+					rowpix += 3 * ssi->Width;
+					if (y + y + 1 >= ssi->Height)
+						break;
+				}
+			}
 
-		UnfreezeStructFromCopy(&Timings, SnapTimings, COUNT(SnapTimings), local_timing_data, version);
+			// black out what we might have missed
+			for (uint32 y = IPPU.RenderedScreenHeight; y < (uint32) (IMAGE_HEIGHT); y++)
+				memset(GFX.Screen + y * GFX.RealPPL, 0, GFX.RealPPL * 2);
 
-		if (local_superfx)
+			delete ssi;
+		}
+		else
 		{
-			GSU.avRegAddr = (uint8 *) &GSU.avReg;
-			UnfreezeStructFromCopy(&GSU, SnapFX, COUNT(SnapFX), local_superfx, version);
+			// couldn't load graphics, so black out the screen instead
+			for (uint32 y = 0; y < (uint32) (IMAGE_HEIGHT); y++)
+				memset(GFX.Screen + y * GFX.RealPPL, 0, GFX.RealPPL * 2);
 		}
 
-		if (local_sa1)
-			UnfreezeStructFromCopy(&SA1, SnapSA1, COUNT(SnapSA1), local_sa1, version);
+		S9xSetSoundMute(FALSE);
+	}
+
+	if (blocks.cpu)					delete [] blocks.cpu;
+	if (blocks.registers)			delete [] blocks.registers;
+	if (blocks.ppu)					delete [] blocks.ppu;
+	if (blocks.dma)					delete [] blocks.dma;
+	if (blocks.vram)				delete [] blocks.vram;
+	if (blocks.ram)					delete [] blocks.ram;
+	if (blocks.sram)				delete [] blocks.sram;
+	if (blocks.fillram)				delete [] blocks.fillram;
+	if (blocks.apu_sound)			delete [] blocks.apu_sound;
+	if (blocks.control_data)		delete [] blocks.control_data;
+	if (blocks.timing_data)			delete [] blocks.timing_data;
+	if (blocks.superfx)				delete [] blocks.superfx;
+	if (blocks.sa1)					delete [] blocks.sa1;
+	if (blocks.sa1_registers)		delete [] blocks.sa1_registers;
+	if (blocks.dsp1)				delete [] blocks.dsp1;
+	if (blocks.dsp2)				delete [] blocks.dsp2;
+	if (blocks.dsp4)				delete [] blocks.dsp4;
+	if (blocks.cx4_data)			delete [] blocks.cx4_data;
+	if (blocks.st010)				delete [] blocks.st010;
+	if (blocks.obc1)				delete [] blocks.obc1;
+	if (blocks.obc1_data)			delete [] blocks.obc1_data;
+	if (blocks.spc7110)				delete [] blocks.spc7110;
+	if (blocks.srtc)				delete [] blocks.srtc;
+	if (blocks.rtc_data)			delete [] blocks.rtc_data;
+	if (blocks.bsx_data)			delete [] blocks.bsx_data;
+	if (blocks.screenshot)			delete [] blocks.screenshot;
+	if (blocks.movie_data)			delete [] blocks.movie_data;
+
+	return (result);
+}
+
+// applies snapshot blocks read by S9xUnfreezeFromStream() or S9xUnfreezeFromMemory()
+static void UnfreezeSnapshotBlocks (struct SnapshotBlocks *blocks, int version)
+{
+	uint32 old_flags     = CPU.Flags;
+	uint32 sa1_old_flags = SA1.Flags;
 
-		if (local_sa1_registers)
-			UnfreezeStructFromCopy(&SA1Registers, SnapSA1Registers, COUNT(SnapSA1Registers), local_sa1_registers, version);
+	S9xReset();
 
-		if (local_dsp1)
-			UnfreezeStructFromCopy(&DSP1, SnapDSP1, COUNT(SnapDSP1), local_dsp1, version);
+	UnfreezeStructFromCopy(&CPU, SnapCPU, COUNT(SnapCPU), blocks->cpu, version);
 
-		if (local_dsp2)
-			UnfreezeStructFromCopy(&DSP2, SnapDSP2, COUNT(SnapDSP2), local_dsp2, version);
+	UnfreezeStructFromCopy(&Registers, SnapRegisters, COUNT(SnapRegisters), blocks->registers, version);
 
-		if (local_dsp4)
-			UnfreezeStructFromCopy(&DSP4, SnapDSP4, COUNT(SnapDSP4), local_dsp4, version);
+	UnfreezeStructFromCopy(&PPU, SnapPPU, COUNT(SnapPPU), blocks->ppu, version);
 
-		if (local_cx4_data)
-			memcpy(Memory.C4RAM, local_cx4_data, 8192);
+	struct SDMASnapshot	dma_snap;
+	UnfreezeStructFromCopy(&dma_snap, SnapDMA, COUNT(SnapDMA), blocks->dma, version);
 
-		if (local_st010)
-			UnfreezeStructFromCopy(&ST010, SnapST010, COUNT(SnapST010), local_st010, version);
+	memcpy(Memory.VRAM, blocks->vram, 0x10000);
 
-		if (local_obc1)
-			UnfreezeStructFromCopy(&OBC1, SnapOBC1, COUNT(SnapOBC1), local_obc1, version);
+	memcpy(Memory.RAM, blocks->ram, 0x20000);
 
-		if (local_obc1_data)
-			memcpy(Memory.OBC1RAM, local_obc1_data, 8192);
+	memcpy(Memory.SRAM, blocks->sram, 0x20000);
 
-		if (local_spc7110)
-			UnfreezeStructFromCopy(&s7snap, SnapSPC7110Snap, COUNT(SnapSPC7110Snap), local_spc7110, version);
+	memcpy(Memory.FillRAM, blocks->fillram, 0x8000);
 
-		if (local_srtc)
-			UnfreezeStructFromCopy(&srtcsnap, SnapSRTCSnap, COUNT(SnapSRTCSnap), local_srtc, version);
+	S9xAPULoadState(blocks->apu_sound);
 
-		if (local_rtc_data)
-			memcpy(RTCData.reg, local_rtc_data, 20);
+	struct SControlSnapshot	ctl_snap;
+	UnfreezeStructFromCopy(&ctl_snap, SnapControls, COUNT(SnapControls), blocks->control_data, version);
 
-		if (local_bsx_data)
-			UnfreezeStructFromCopy(&BSX, SnapBSX, COUNT(SnapBSX), local_bsx_data, version);
+	UnfreezeStructFromCopy(&Timings, SnapTimings, COUNT(SnapTimings), blocks->timing_data, version);
 
-		if (version < SNAPSHOT_VERSION)
-		{
-			printf("Converting old snapshot version %d to %d\n...", version, SNAPSHOT_VERSION);
+	if (blocks->superfx)
+	{
+		GSU.avRegAddr = (uint8 *) &GSU.avReg;
+		UnfreezeStructFromCopy(&GSU, SnapFX, COUNT(SnapFX), blocks->superfx, version);
+	}
 
-			CPU.NMILine = (CPU.Flags & (1 <<  7)) ? TRUE : FALSE;
-			CPU.IRQLine = (CPU.Flags & (1 << 11)) ? TRUE : FALSE;
-			CPU.IRQTransition = FALSE;
-			CPU.IRQLastState = FALSE;
-			CPU.IRQExternal = (Obsolete.CPU_IRQActive & ~(1 << 1)) ? TRUE : FALSE;
+	if (blocks->sa1)
+		UnfreezeStructFromCopy(&SA1, SnapSA1, COUNT(SnapSA1), blocks->sa1, version);
 
-			switch (CPU.WhichEvent)
-			{
-				case 12:	case   1:	CPU.WhichEvent = 1; break;
-				case  2:	case   3:	CPU.WhichEvent = 2; break;
-				case  4:	case   5:	CPU.WhichEvent = 3; break;
-				case  6:	case   7:	CPU.WhichEvent = 4; break;
-				case  8:	case   9:	CPU.WhichEvent = 5; break;
-				case 10:	case  11:	CPU.WhichEvent = 6; break;
-			}
+	if (blocks->sa1_registers)
+		UnfreezeStructFromCopy(&SA1Registers, SnapSA1Registers, COUNT(SnapSA1Registers), blocks->sa1_registers, version);
 
-			if (local_sa1) // FIXME
-			{
-				SA1.Cycles = SA1.PrevCycles = 0;
-				SA1.TimerIRQLastState = FALSE;
-				SA1.HTimerIRQPos = Memory.FillRAM[0x2212] | (Memory.FillRAM[0x2213] << 8);
-				SA1.VTimerIRQPos = Memory.FillRAM[0x2214] | (Memory.FillRAM[0x2215] << 8);
-				SA1.HCounter = 0;
-				SA1.VCounter = 0;
-				SA1.PrevHCounter = 0;
-				SA1.MemSpeed = SLOW_ONE_CYCLE;
-				SA1.MemSpeedx2 = SLOW_ONE_CYCLE * 2;
-			}
-		}
+	if (blocks->dsp1)
+		UnfreezeStructFromCopy(&DSP1, SnapDSP1, COUNT(SnapDSP1), blocks->dsp1, version);
+
+	if (blocks->dsp2)
+		UnfreezeStructFromCopy(&DSP2, SnapDSP2, COUNT(SnapDSP2), blocks->dsp2, version);
+
+	if (blocks->dsp4)
+		UnfreezeStructFromCopy(&DSP4, SnapDSP4, COUNT(SnapDSP4), blocks->dsp4, version);
+
+	if (blocks->cx4_data)
+		memcpy(Memory.C4RAM, blocks->cx4_data, 8192);
+
+	if (blocks->st010)
+		UnfreezeStructFromCopy(&ST010, SnapST010, COUNT(SnapST010), blocks->st010, version);
+
+	if (blocks->obc1)
+		UnfreezeStructFromCopy(&OBC1, SnapOBC1, COUNT(SnapOBC1), blocks->obc1, version);
 
-		CPU.Flags |= old_flags & (DEBUG_MODE_FLAG | TRACE_FLAG | SINGLE_STEP_FLAG | FRAME_ADVANCE_FLAG);
-		ICPU.ShiftedPB = Registers.PB << 16;
-		ICPU.ShiftedDB = Registers.DB << 16;
-		S9xSetPCBase(Registers.PBPC);
-		S9xUnpackStatus();
-		S9xFixCycles();
+	if (blocks->obc1_data)
+		memcpy(Memory.OBC1RAM, blocks->obc1_data, 8192);
 
-		for (int d = 0; d < 8; d++)
-			DMA[d] = dma_snap.dma[d];
-		CPU.InDMA = CPU.InHDMA = FALSE;
-		CPU.InDMAorHDMA = CPU.InWRAMDMAorHDMA = FALSE;
-		CPU.HDMARanInDMA = 0;
+	if (blocks->spc7110)
+		UnfreezeStructFromCopy(&s7snap, SnapSPC7110Snap, COUNT(SnapSPC7110Snap), blocks->spc7110, version);
 
-		S9xFixColourBrightness();
-		IPPU.ColorsChanged = TRUE;
-		IPPU.OBJChanged = TRUE;
-		IPPU.RenderThisFrame = TRUE;
+	if (blocks->srtc)
+		UnfreezeStructFromCopy(&srtcsnap, SnapSRTCSnap, COUNT(SnapSRTCSnap), blocks->srtc, version);
 
-		uint8 hdma_byte = Memory.FillRAM[0x420c];
-		S9xSetCPU(hdma_byte, 0x420c);
+	if (blocks->rtc_data)
+		memcpy(RTCData.reg, blocks->rtc_data, 20);
 
-		S9xControlPostLoadState(&ctl_snap);
+	if (blocks->bsx_data)
+		UnfreezeStructFromCopy(&BSX, SnapBSX, COUNT(SnapBSX), blocks->bsx_data, version);
 
-		if (local_superfx)
+	if (version < SNAPSHOT_VERSION)
+	{
+		printf("Converting old snapshot version %d to %d\n...", version, SNAPSHOT_VERSION);
+
+		CPU.NMILine = (CPU.Flags & (1 <<  7)) ? TRUE : FALSE;
+		CPU.IRQLine = (CPU.Flags & (1 << 11)) ? TRUE : FALSE;
+		CPU.IRQTransition = FALSE;
+		CPU.IRQLastState = FALSE;
+		CPU.IRQExternal = (Obsolete.CPU_IRQActive & ~(1 << 1)) ? TRUE : FALSE;
+
+		switch (CPU.WhichEvent)
 		{
-			GSU.pfPlot = fx_PlotTable[GSU.vMode];
-			GSU.pfRpix = fx_PlotTable[GSU.vMode + 5];
+			case 12:	case   1:	CPU.WhichEvent = 1; break;
+			case  2:	case   3:	CPU.WhichEvent = 2; break;
+			case  4:	case   5:	CPU.WhichEvent = 3; break;
+			case  6:	case   7:	CPU.WhichEvent = 4; break;
+			case  8:	case   9:	CPU.WhichEvent = 5; break;
+			case 10:	case  11:	CPU.WhichEvent = 6; break;
 		}
 
-		if (local_sa1 && local_sa1_registers)
+		if (blocks->sa1) // FIXME
 		{
-			SA1.Flags |= sa1_old_flags & TRACE_FLAG;
-			S9xSA1PostLoadState();
+			SA1.Cycles = SA1.PrevCycles = 0;
+			SA1.TimerIRQLastState = FALSE;
+			SA1.HTimerIRQPos = Memory.FillRAM[0x2212] | (Memory.FillRAM[0x2213] << 8);
+			SA1.VTimerIRQPos = Memory.FillRAM[0x2214] | (Memory.FillRAM[0x2215] << 8);
+			SA1.HCounter = 0;
+			SA1.VCounter = 0;
+			SA1.PrevHCounter = 0;
+			SA1.MemSpeed = SLOW_ONE_CYCLE;
+			SA1.MemSpeedx2 = SLOW_ONE_CYCLE * 2;
 		}
+	}
 
-		if (Settings.SDD1)
-			S9xSDD1PostLoadState();
+	CPU.Flags |= old_flags & (DEBUG_MODE_FLAG | TRACE_FLAG | SINGLE_STEP_FLAG | FRAME_ADVANCE_FLAG);
+	ICPU.ShiftedPB = Registers.PB << 16;
+	ICPU.ShiftedDB = Registers.DB << 16;
+	S9xSetPCBase(Registers.PBPC);
+	S9xUnpackStatus();
+	S9xFixCycles();
+	ICPU.IdleLoop.Armed = FALSE;
 
-		if (local_spc7110)
-			S9xSPC7110PostLoadState(version);
+	for (int d = 0; d < 8; d++)
+		DMA[d] = dma_snap.dma[d];
+	S9xInvalidateHDMAPrograms();
+	CPU.InDMA = CPU.InHDMA = FALSE;
+	CPU.InDMAorHDMA = CPU.InWRAMDMAorHDMA = FALSE;
+	CPU.HDMARanInDMA = 0;
 
-		if (local_srtc)
-			S9xSRTCPostLoadState(version);
+	S9xFixColourBrightness();
+	IPPU.ColorsChanged = TRUE;
+	IPPU.OBJChanged = TRUE;
+	IPPU.RenderThisFrame = TRUE;
 
-		if (local_bsx_data)
-			S9xBSXPostLoadState();
+	uint8 hdma_byte = Memory.FillRAM[0x420c];
+	S9xSetCPU(hdma_byte, 0x420c);
 
-		if (local_movie_data)
-		{
-			// restore last displayed pad_read status
-			extern bool8	pad_read, pad_read_last;
-			bool8			pad_read_temp = pad_read;
+	S9xControlPostLoadState(&ctl_snap);
 
-			pad_read = pad_read_last;
-			S9xUpdateFrameCounter(-1);
-			pad_read = pad_read_temp;
-		}
+	if (blocks->superfx)
+	{
+		GSU.pfPlot = fx_PlotTable[GSU.vMode];
+		GSU.pfRpix = fx_PlotTable[GSU.vMode + 5];
+	}
 
-		if (local_screenshot)
-		{
-			SnapshotScreenshotInfo	*ssi = new SnapshotScreenshotInfo;
+	if (blocks->sa1 && blocks->sa1_registers)
+	{
+		SA1.Flags |= sa1_old_flags & TRACE_FLAG;
+		S9xSA1PostLoadState();
+	}
 
-			UnfreezeStructFromCopy(ssi, SnapScreenshot, COUNT(SnapScreenshot), local_screenshot, version);
+	if (Settings.SDD1)
+		S9xSDD1PostLoadState();
 
-			IPPU.RenderedScreenWidth  = min(ssi->Width,  IMAGE_WIDTH);
-			IPPU.RenderedScreenHeight = min(ssi->Height, IMAGE_HEIGHT);
-			const bool8 scaleDownX = IPPU.RenderedScreenWidth  < ssi->Width;
-			const bool8 scaleDownY = IPPU.RenderedScreenHeight < ssi->Height && ssi->Height > SNES_HEIGHT_EXTENDED;
-			GFX.DoInterlace = Settings.SupportHiRes ? ssi->Interlaced : 0;
+	if (blocks->spc7110)
+		S9xSPC7110PostLoadState(version);
 
-			uint8	*rowpix = ssi->Data;
-			uint16	*screen = GFX.Screen;
+	if (blocks->srtc)
+		S9xSRTCPostLoadState(version);
 
-			for (int y = 0; y < IPPU.RenderedScreenHeight; y++, screen += GFX.RealPPL)
-			{
-				for (int x = 0; x < IPPU.RenderedScreenWidth; x++)
-				{
-					uint32	r, g, b;
+	if (blocks->bsx_data)
+		S9xBSXPostLoadState();
 
-					r = *(rowpix++);
-					g = *(rowpix++);
-					b = *(rowpix++);
+	if (blocks->movie_data)
+	{
+		// restore last displayed pad_read status
+		extern S9X_TLS bool8	pad_read, pad_read_last;
+		bool8			pad_read_temp = pad_read;
 
-					if (scaleDownX)
-					{
-						r = (r + *(rowpix++)) >> 1;
-						g = (g + *(rowpix++)) >> 1;
-						b = (b + *(rowpix++)) >> 1;
+		pad_read = pad_read_last;
+		S9xUpdateFrameCounter(-1);
+		pad_read = pad_read_temp;
+	}
+}
 
-						if (x + x + 1 >= ssi->Width)
-							break;
-					}
+#define MEMORY_SNAPSHOT_HEADER_SIZE	20
 
-					screen[x] = BUILD_PIXEL(r, g, b);
-				}
+static void PutDWord (uint8 *ptr, uint32 dword)
+{
+	ptr[0] = (uint8) (dword >> 24);
+	ptr[1] = (uint8) (dword >> 16);
+	ptr[2] = (uint8) (dword >> 8);
+	ptr[3] = (uint8) dword;
+}
 
-				if (scaleDownY)
-				{
-					rowpix += 3 * ssi->Width;
-					if (y + y + 1 >= ssi->Height)
-						break;
-				}
-			}
+static uint32 GetDWord (const uint8 *ptr)
+{
+	return ((ptr[0] << 24) | (ptr[1] << 16) | (ptr[2] << 8) | ptr[3]);
+}
 
-			// black out what we might have missed
-			for (uint32 y = IPPU.RenderedScreenHeight; y < (uint32) (IMAGE_HEIGHT); y++)
-				memset(GFX.Screen + y * GFX.RealPPL, 0, GFX.RealPPL * 2);
+static uint8 * PutBlock (uint8 *ptr, const uint8 *block, int size)
+{
+	memcpy(ptr, block, size);
+	return (ptr + size);
+}
 
-			delete ssi;
-		}
-		else
-		{
-			// couldn't load graphics, so black out the screen instead
-			for (uint32 y = 0; y < (uint32) (IMAGE_HEIGHT); y++)
-				memset(GFX.Screen + y * GFX.RealPPL, 0, GFX.RealPPL * 2);
-		}
+static uint8 * TakeBlock (const uint8 **ptr, int size)
+{
+	uint8	*block = (uint8 *) *ptr;
 
-		S9xSetSoundMute(FALSE);
+	*ptr += size;
+	return (block);
+}
+
+// The memory snapshot holds the same sections as the stream format, packed back to back
+// without block names and without screenshot and movie data. The layout depends on the
+// loaded ROM's chips, so it can only be restored into the same ROM and snapshot version.
+uint32 S9xFreezeSize (void)
+{
+	uint32	size = MEMORY_SNAPSHOT_HEADER_SIZE;
+
+	size += StructSize(SnapCPU, COUNT(SnapCPU), SNAPSHOT_VERSION);
+	size += StructSize(SnapRegisters, COUNT(SnapRegisters), SNAPSHOT_VERSION);
+	size += StructSize(SnapPPU, COUNT(SnapPPU), SNAPSHOT_VERSION);
+	size += StructSize(SnapDMA, COUNT(SnapDMA), SNAPSHOT_VERSION);
+	size += 0x10000 + 0x20000 + 0x20000 + 0x8000;
+	size += SPC_SAVE_STATE_BLOCK_SIZE;
+	size += StructSize(SnapControls, COUNT(SnapControls), SNAPSHOT_VERSION);
+	size += StructSize(SnapTimings, COUNT(SnapTimings), SNAPSHOT_VERSION);
+
+	if (Settings.SuperFX)
+		size += StructSize(SnapFX, COUNT(SnapFX), SNAPSHOT_VERSION);
+
+	if (Settings.SA1)
+	{
+		size += StructSize(SnapSA1, COUNT(SnapSA1), SNAPSHOT_VERSION);
+		size += StructSize(SnapSA1Registers, COUNT(SnapSA1Registers), SNAPSHOT_VERSION);
 	}
 
-	if (local_cpu)				delete [] local_cpu;
-	if (local_registers)		delete [] local_registers;
-	if (local_ppu)				delete [] local_ppu;
-	if (local_dma)				delete [] local_dma;
-	if (local_vram)				delete [] local_vram;
-	if (local_ram)				delete [] local_ram;
-	if (local_sram)				delete [] local_sram;
-	if (local_fillram)			delete [] local_fillram;
-	if (local_apu_sound)		delete [] local_apu_sound;
-	if (local_control_data)		delete [] local_control_data;
-	if (local_timing_data)		delete [] local_timing_data;
-	if (local_superfx)			delete [] local_superfx;
-	if (local_sa1)				delete [] local_sa1;
-	if (local_sa1_registers)	delete [] local_sa1_registers;
-	if (local_dsp1)				delete [] local_dsp1;
-	if (local_dsp2)				delete [] local_dsp2;
-	if (local_dsp4)				delete [] local_dsp4;
-	if (local_cx4_data)			delete [] local_cx4_data;
-	if (local_st010)			delete [] local_st010;
-	if (local_obc1)				delete [] local_obc1;
-	if (local_obc1_data)		delete [] local_obc1_data;
-	if (local_spc7110)			delete [] local_spc7110;
-	if (local_srtc)				delete [] local_srtc;
-	if (local_rtc_data)			delete [] local_rtc_data;
-	if (local_bsx_data)			delete [] local_bsx_data;
-	if (local_screenshot)		delete [] local_screenshot;
-	if (local_movie_data)		delete [] local_movie_data;
+	if (Settings.DSP == 1)
+		size += StructSize(SnapDSP1, COUNT(SnapDSP1), SNAPSHOT_VERSION);
 
-	return (result);
+	if (Settings.DSP == 2)
+		size += StructSize(SnapDSP2, COUNT(SnapDSP2), SNAPSHOT_VERSION);
+
+	if (Settings.DSP == 4)
+		size += StructSize(SnapDSP4, COUNT(SnapDSP4), SNAPSHOT_VERSION);
+
+	if (Settings.C4)
+		size += 8192;
+
+	if (Settings.SETA == ST_010)
+		size += StructSize(SnapST010, COUNT(SnapST010), SNAPSHOT_VERSION);
+
+	if (Settings.OBC1)
+		size += StructSize(SnapOBC1, COUNT(SnapOBC1), SNAPSHOT_VERSION) + 8192;
+
+	if (Settings.SPC7110)
+		size += StructSize(SnapSPC7110Snap, COUNT(SnapSPC7110Snap), SNAPSHOT_VERSION);
+
+	if (Settings.SRTC)
+		size += StructSize(SnapSRTCSnap, COUNT(SnapSRTCSnap), SNAPSHOT_VERSION);
+
+	if (Settings.SRTC || Settings.SPC7110RTC)
+		size += 20;
+
+	if (Settings.BS)
+		size += StructSize(SnapBSX, COUNT(SnapBSX), SNAPSHOT_VERSION);
+
+	return (size);
+}
+
+bool8 S9xFreezeToMemory (uint8 *buf, uint32 size)
+{
+	uint32	len = S9xFreezeSize();
+	uint8	*ptr = buf;
+
+	S9xSuperFXSync();
+	S9xSA1Sync();
+
+	if (size < len)
+		return (FALSE);
+
+	memcpy(ptr, SNAPSHOT_MEMORY_MAGIC, 8);
+	PutDWord(ptr + 8, SNAPSHOT_VERSION);
+	PutDWord(ptr + 12, len);
+	PutDWord(ptr + 16, Memory.ROMCRC32);
+	ptr += MEMORY_SNAPSHOT_HEADER_SIZE;
+
+	ptr = PackStruct(ptr, &CPU, SnapCPU, COUNT(SnapCPU));
+	ptr = PackStruct(ptr, &Registers, SnapRegisters, COUNT(SnapRegisters));
+	ptr = PackStruct(ptr, &PPU, SnapPPU, COUNT(SnapPPU));
+
+	struct SDMASnapshot	dma_snap;
+	for (int d = 0; d < 8; d++)
+		dma_snap.dma[d] = DMA[d];
+	ptr = PackStruct(ptr, &dma_snap, SnapDMA, COUNT(SnapDMA));
+
+	ptr = PutBlock(ptr, Memory.VRAM, 0x10000);
+	ptr = PutBlock(ptr, Memory.RAM, 0x20000);
+	ptr = PutBlock(ptr, Memory.SRAM, 0x20000);
+	ptr = PutBlock(ptr, Memory.FillRAM, 0x8000);
+
+	S9xAPUSaveState(ptr);
+	ptr += SPC_SAVE_STATE_BLOCK_SIZE;
+
+	struct SControlSnapshot	ctl_snap;
+	S9xControlPreSaveState(&ctl_snap);
+	ptr = PackStruct(ptr, &ctl_snap, SnapControls, COUNT(SnapControls));
+
+	ptr = PackStruct(ptr, &Timings, SnapTimings, COUNT(SnapTimings));
+
+	if (Settings.SuperFX)
+	{
+		GSU.avRegAddr = (uint8 *) &GSU.avReg;
+		ptr = PackStruct(ptr, &GSU, SnapFX, COUNT(SnapFX));
+	}
+
+	if (Settings.SA1)
+	{
+		S9xSA1PackStatus();
+		ptr = PackStruct(ptr, &SA1, SnapSA1, COUNT(SnapSA1));
+		ptr = PackStruct(ptr, &SA1Registers, SnapSA1Registers, COUNT(SnapSA1Registers));
+	}
+
+	if (Settings.DSP == 1)
+		ptr = PackStruct(ptr, &DSP1, SnapDSP1, COUNT(SnapDSP1));
+
+	if (Settings.DSP == 2)
+		ptr = PackStruct(ptr, &DSP2, SnapDSP2, COUNT(SnapDSP2));
+
+	if (Settings.DSP == 4)
+		ptr = PackStruct(ptr, &DSP4, SnapDSP4, COUNT(SnapDSP4));
+
+	if (Settings.C4)
+		ptr = PutBlock(ptr, Memory.C4RAM, 8192);
+
+	if (Settings.SETA == ST_010)
+		ptr = PackStruct(ptr, &ST010, SnapST010, COUNT(SnapST010));
+
+	if (Settings.OBC1)
+	{
+		ptr = PackStruct(ptr, &OBC1, SnapOBC1, COUNT(SnapOBC1));
+		ptr = PutBlock(ptr, Memory.OBC1RAM, 8192);
+	}
+
+	if (Settings.SPC7110)
+	{
+		S9xSPC7110PreSaveState();
+		ptr = PackStruct(ptr, &s7snap, SnapSPC7110Snap, COUNT(SnapSPC7110Snap));
+	}
+
+	if (Settings.SRTC)
+	{
+		S9xSRTCPreSaveState();
+		ptr = PackStruct(ptr, &srtcsnap, SnapSRTCSnap, COUNT(SnapSRTCSnap));
+	}
+
+	if (Settings.SRTC || Settings.SPC7110RTC)
+		ptr = PutBlock(ptr, RTCData.reg, 20);
+
+	if (Settings.BS)
+		ptr = PackStruct(ptr, &BSX, SnapBSX, COUNT(SnapBSX));
+
+	assert((uint32) (ptr - buf) == len);
+
+	return (TRUE);
+}
+
+int S9xUnfreezeFromMemory (const uint8 *buf, uint32 size)
+{
+	const uint8	*ptr = buf;
+	const uint32	len = S9xFreezeSize();
+	const int		version = SNAPSHOT_VERSION;
+
+	S9xSuperFXSync();
+	S9xSA1Sync();
+
+	if (size < MEMORY_SNAPSHOT_HEADER_SIZE || memcmp(ptr, SNAPSHOT_MEMORY_MAGIC, 8) != 0)
+		return (WRONG_FORMAT);
+
+	if (GetDWord(ptr + 8) != SNAPSHOT_VERSION)
+		return (WRONG_VERSION);
+
+	if (GetDWord(ptr + 12) != len || size < len || GetDWord(ptr + 16) != Memory.ROMCRC32)
+		return (SNAPSHOT_INCONSISTENT);
+
+	// a movie can't continue from a snapshot that doesn't carry its input data
+	if (S9xMovieActive())
+		return (NOT_A_MOVIE_SNAPSHOT);
+
+	ptr += MEMORY_SNAPSHOT_HEADER_SIZE;
+
+	struct SnapshotBlocks	blocks;
+	memset(&blocks, 0, sizeof(blocks));
+
+	blocks.cpu = TakeBlock(&ptr, StructSize(SnapCPU, COUNT(SnapCPU), version));
+	blocks.registers = TakeBlock(&ptr, StructSize(SnapRegisters, COUNT(SnapRegisters), version));
+	blocks.ppu = TakeBlock(&ptr, StructSize(SnapPPU, COUNT(SnapPPU), version));
+	blocks.dma = TakeBlock(&ptr, StructSize(SnapDMA, COUNT(SnapDMA), version));
+	blocks.vram = TakeBlock(&ptr, 0x10000);
+	blocks.ram = TakeBlock(&ptr, 0x20000);
+	blocks.sram = TakeBlock(&ptr, 0x20000);
+	blocks.fillram = TakeBlock(&ptr, 0x8000);
+	blocks.apu_sound = TakeBlock(&ptr, SPC_SAVE_STATE_BLOCK_SIZE);
+	blocks.control_data = TakeBlock(&ptr, StructSize(SnapControls, COUNT(SnapControls), version));
+	blocks.timing_data = TakeBlock(&ptr, StructSize(SnapTimings, COUNT(SnapTimings), version));
+
+	if (Settings.SuperFX)
+		blocks.superfx = TakeBlock(&ptr, StructSize(SnapFX, COUNT(SnapFX), version));
+
+	if (Settings.SA1)
+	{
+		blocks.sa1 = TakeBlock(&ptr, StructSize(SnapSA1, COUNT(SnapSA1), version));
+		blocks.sa1_registers = TakeBlock(&ptr, StructSize(SnapSA1Registers, COUNT(SnapSA1Registers), version));
+	}
+
+	if (Settings.DSP == 1)
+		blocks.dsp1 = TakeBlock(&ptr, StructSize(SnapDSP1, COUNT(SnapDSP1), version));
+
+	if (Settings.DSP == 2)
+		blocks.dsp2 = TakeBlock(&ptr, StructSize(SnapDSP2, COUNT(SnapDSP2), version));
+
+	if (Settings.DSP == 4)
+		blocks.dsp4 = TakeBlock(&ptr, StructSize(SnapDSP4, COUNT(SnapDSP4), version));
+
+	if (Settings.C4)
+		blocks.cx4_data = TakeBlock(&ptr, 8192);
+
+	if (Settings.SETA == ST_010)
+		blocks.st010 = TakeBlock(&ptr, StructSize(SnapST010, COUNT(SnapST010), version));
+
+	if (Settings.OBC1)
+	{
+		blocks.obc1 = TakeBlock(&ptr, StructSize(SnapOBC1, COUNT(SnapOBC1), version));
+		blocks.obc1_data = TakeBlock(&ptr, 8192);
+	}
+
+	if (Settings.SPC7110)
+		blocks.spc7110 = TakeBlock(&ptr, StructSize(SnapSPC7110Snap, COUNT(SnapSPC7110Snap), version));
+
+	if (Settings.SRTC)
+		blocks.srtc = TakeBlock(&ptr, StructSize(SnapSRTCSnap, COUNT(SnapSRTCSnap), version));
+
+	if (Settings.SRTC || Settings.SPC7110RTC)
+		blocks.rtc_data = TakeBlock(&ptr, 20);
+
+	if (Settings.BS)
+		blocks.bsx_data = TakeBlock(&ptr, StructSize(SnapBSX, COUNT(SnapBSX), version));
+
+	S9xSetSoundMute(TRUE);
+	UnfreezeSnapshotBlocks(&blocks, version);
+	S9xSetSoundMute(FALSE);
+
+	return (SUCCESS);
 }
 
 static int FreezeSize (int size, int type)
@@ -1883,9 +2179,8 @@ static int FreezeSize (int size, int type)
 static void FreezeStruct (STREAM stream, const char *name, void *base, FreezeData *fields, int num_fields)
 {
 	int	len = 0;
-	int	i, j;
 
-	for (i = 0; i < num_fields; i++)
+	for (int i = 0; i < num_fields; i++)
 	{
 		if (SNAPSHOT_VERSION < fields[i].debuted_in)
 		{
@@ -1898,12 +2193,21 @@ static void FreezeStruct (STREAM stream, const char *name, void *base, FreezeDat
 	}
 
 	uint8	*block = new uint8[len];
-	uint8	*ptr = block;
+	PackStruct(block, base, fields, num_fields);
+
+	FreezeBlock(stream, name, block, len);
+	delete [] block;
+}
+
+// packs the fields of the current version into ptr and returns the end of the packed data
+static uint8 * PackStruct (uint8 *ptr, void *base, FreezeData *fields, int num_fields)
+{
 	uint8	*addr;
 	uint16	word;
 	uint32	dword;
 	int64	qaword;
 	int		relativeAddr;
+	int		i, j;
 
 	for (i = 0; i < num_fields; i++)
 	{
@@ -1998,8 +2302,7 @@ static void FreezeStruct (STREAM stream, const char *name, void *base, FreezeDat
 		}
 	}
 
-	FreezeBlock(stream, name, block, len);
-	delete [] block;
+	return (ptr);
 }
 
 static void FreezeBlock (STREAM stream, const char *name, uint8 *block, int size)
@@ -2120,7 +2423,7 @@ static int UnfreezeStruct (STREAM stream, const char *name, void *base, FreezeDa
 	return (SUCCESS);
 }
 
-static int UnfreezeStructCopy (STREAM stream, const char *name, uint8 **block, FreezeData *fields, int num_fields, int version)
+static int StructSize (FreezeData *fields, int num_fields, int version)
 {
 	int	len = 0;
 
@@ -2130,7 +2433,12 @@ static int UnfreezeStructCopy (STREAM stream, const char *name, uint8 **block, F
 			len += FreezeSize(fields[i].size, fields[i].type);
 	}
 
-	return (UnfreezeBlockCopy(stream, name, block, len));
+	return (len);
+}
+
+static int UnfreezeStructCopy (STREAM stream, const char *name, uint8 **block, FreezeData *fields, int num_fields, int version)
+{
+	return (UnfreezeBlockCopy(stream, name, block, StructSize(fields, num_fields, version)));
 }
 
 static void UnfreezeStructFromCopy (void *sbase, FreezeData *fields, int num_fields, uint8 *block, int version)
@@ -181,6 +181,7 @@
 
 #define SNAPSHOT_MAGIC			"#!s9xsnp"
 #define SNAPSHOT_VERSION		7
+#define SNAPSHOT_MEMORY_MAGIC	"#!s9xmem"
 
 #define SUCCESS					1
 #define WRONG_FORMAT			(-1)
@@ -195,6 +196,9 @@ bool8 S9xFreezeGame (const char *);
 bool8 S9xUnfreezeGame (const char *);
 void S9xFreezeToStream (STREAM);
 int	 S9xUnfreezeFromStream (STREAM);
+uint32 S9xFreezeSize (void);
+bool8 S9xFreezeToMemory (uint8 *, uint32);
+int	 S9xUnfreezeFromMemory (const uint8 *, uint32);
 bool8 S9xSPCDump (const char *);
 
 #endif
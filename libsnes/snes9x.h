@@ -281,6 +281,7 @@ struct SCPUState
 	bool8	IRQTransition;
 	bool8	IRQLastState;
 	bool8	IRQExternal;
+	bool8	IRQExternalPending;
 	int32	IRQPending;
 	int32	MemSpeed;
 	int32	MemSpeedx2;
@@ -401,6 +402,8 @@ struct SSettings
 	bool8	BlockInvalidVRAMAccessMaster;
 	bool8	BlockInvalidVRAMAccess;
 	int32	HDMATimingHack;
+	bool8	SkipIdleLoops;
+	bool8	SA1CatchUp;
 
 	bool8	ForcedPause;
 	bool8	Paused;
@@ -460,10 +463,10 @@ void S9xClearPause(uint32);
 void S9xExit(void);
 void S9xMessage(int, int, const char *);
 
-extern struct SSettings			Settings;
-extern struct SCPUState			CPU;
-extern struct STimings			Timings;
-extern struct SSNESGameFixes	SNESGameFixes;
-extern char						String[513];
+extern S9X_TLS struct SSettings			Settings;
+extern S9X_TLS struct SCPUState			CPU;
+extern S9X_TLS struct STimings			Timings;
+extern S9X_TLS struct SSNESGameFixes	SNESGameFixes;
+extern S9X_TLS char						String[513];
 
 #endif
@@ -189,9 +189,23 @@
 #include "ppu.h"
 #include "tile.h"
 
-static uint32	pixbit[8][16];
-static uint8	hrbit_odd[256];
-static uint8	hrbit_even[256];
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define S9X_TILE_SIMD
+#include <emmintrin.h>
+#endif
+
+static S9X_TLS uint32	pixbit[8][16];
+static S9X_TLS uint8	hrbit_odd[256];
+static S9X_TLS uint8	hrbit_even[256];
+
+#ifdef S9X_TILE_SIMD
+static S9X_TLS struct
+{
+	uint16	FieldMask[3];
+	uint16	FieldShift[3];	// moves the top bit of a field to bit 15
+	uint16	LowMask;		// lowest bit of every field
+}	TileSIMD;
+#endif
 
 
 void S9xInitTileRenderer (void)
@@ -474,10 +488,456 @@ static uint8 ConvertTile4h_even (uint8 *pCache, uint32 TileAddr, uint32 Tile)
 
 #undef DOBIT
 
+// SSE2 bitplane to chunky conversion. A row of planes is spread over the eight pixels of the row with
+// one compare per plane, two rows at a time. Hires tiles first pack the odd or even pixels of the two
+// tiles into a planar tile of their own.
+
+#ifdef S9X_TILE_SIMD
+
+// pairs are 16-byte groups of two planes interleaved by row, as they are stored in VRAM
+static uint8 ConvertPlanesSIMD (uint8 *pCache, const uint8 *tp, int pairs)
+{
+	const __m128i	bits = _mm_setr_epi8((char) 0x80, 0x40, 0x20, 0x10, 8, 4, 2, 1, (char) 0x80, 0x40, 0x20, 0x10, 8, 4, 2, 1);
+	__m128i			rows[4] = { _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+
+	for (int k = 0; k < pairs; k++)
+	{
+		__m128i	planes = _mm_loadu_si128((const __m128i *) (tp + (k << 4)));
+		__m128i	lo = _mm_unpacklo_epi8(planes, planes);
+		__m128i	hi = _mm_unpackhi_epi8(planes, planes);
+		__m128i	quads[4] = { _mm_unpacklo_epi16(lo, lo), _mm_unpackhi_epi16(lo, lo), _mm_unpacklo_epi16(hi, hi), _mm_unpackhi_epi16(hi, hi) };
+		__m128i	even_bit = _mm_set1_epi8(1 << (k * 2));
+		__m128i	odd_bit  = _mm_set1_epi8(2 << (k * 2));
+
+		for (int r = 0; r < 4; r++)
+		{
+			// each 32-bit lane holds one plane byte of one row, rows 2r and 2r + 1
+			__m128i	even = _mm_and_si128(_mm_shuffle_epi32(quads[r], _MM_SHUFFLE(2, 2, 0, 0)), bits);
+			__m128i	odd  = _mm_and_si128(_mm_shuffle_epi32(quads[r], _MM_SHUFFLE(3, 3, 1, 1)), bits);
+
+			rows[r] = _mm_or_si128(rows[r], _mm_and_si128(_mm_cmpeq_epi8(even, bits), even_bit));
+			rows[r] = _mm_or_si128(rows[r], _mm_and_si128(_mm_cmpeq_epi8(odd, bits), odd_bit));
+		}
+	}
+
+	for (int r = 0; r < 4; r++)
+		_mm_storeu_si128((__m128i *) (pCache + (r << 4)), rows[r]);
+
+	__m128i	any = _mm_or_si128(_mm_or_si128(rows[0], rows[1]), _mm_or_si128(rows[2], rows[3]));
+
+	return ((_mm_movemask_epi8(_mm_cmpeq_epi8(any, _mm_setzero_si128())) != 0xffff) ? TRUE : BLANK_TILE);
+}
+
+// keeps the odd (shift 0) or even (shift 1) bits of every byte, packed into its low nibble like hrbit_odd/hrbit_even
+static inline __m128i HiresBitsSIMD (__m128i planes, int shift)
+{
+	__m128i	x = _mm_and_si128(_mm_srli_epi16(planes, shift), _mm_set1_epi8(0x55));
+
+	x = _mm_and_si128(_mm_or_si128(x, _mm_srli_epi16(x, 1)), _mm_set1_epi8(0x33));
+	return (_mm_and_si128(_mm_or_si128(x, _mm_srli_epi16(x, 2)), _mm_set1_epi8(0x0f)));
+}
+
+static uint8 ConvertHiresSIMD (uint8 *pCache, uint32 TileAddr, uint32 Tile, int pairs, int shift)
+{
+	uint8	planes[64];
+	uint32	size = pairs << 4;
+	uint8	*tp1 = &Memory.VRAM[TileAddr], *tp2;
+
+	if (Tile == 0x3ff)
+		tp2 = tp1 - 0x3ff * size;
+	else
+		tp2 = tp1 + size;
+
+	for (int k = 0; k < pairs; k++)
+	{
+		__m128i	left  = HiresBitsSIMD(_mm_loadu_si128((const __m128i *) (tp1 + (k << 4))), shift);
+		__m128i	right = HiresBitsSIMD(_mm_loadu_si128((const __m128i *) (tp2 + (k << 4))), shift);
+
+		_mm_storeu_si128((__m128i *) (planes + (k << 4)), _mm_or_si128(_mm_slli_epi16(left, 4), right));
+	}
+
+	return (ConvertPlanesSIMD(pCache, planes, pairs));
+}
+
+static uint8 ConvertTile2SIMD (uint8 *pCache, uint32 TileAddr, uint32)
+{
+	return (ConvertPlanesSIMD(pCache, &Memory.VRAM[TileAddr], 1));
+}
+
+static uint8 ConvertTile4SIMD (uint8 *pCache, uint32 TileAddr, uint32)
+{
+	return (ConvertPlanesSIMD(pCache, &Memory.VRAM[TileAddr], 2));
+}
+
+static uint8 ConvertTile8SIMD (uint8 *pCache, uint32 TileAddr, uint32)
+{
+	return (ConvertPlanesSIMD(pCache, &Memory.VRAM[TileAddr], 4));
+}
+
+static uint8 ConvertTile2h_oddSIMD (uint8 *pCache, uint32 TileAddr, uint32 Tile)
+{
+	return (ConvertHiresSIMD(pCache, TileAddr, Tile, 1, 0));
+}
+
+static uint8 ConvertTile2h_evenSIMD (uint8 *pCache, uint32 TileAddr, uint32 Tile)
+{
+	return (ConvertHiresSIMD(pCache, TileAddr, Tile, 1, 1));
+}
+
+static uint8 ConvertTile4h_oddSIMD (uint8 *pCache, uint32 TileAddr, uint32 Tile)
+{
+	return (ConvertHiresSIMD(pCache, TileAddr, Tile, 2, 0));
+}
+
+static uint8 ConvertTile4h_evenSIMD (uint8 *pCache, uint32 TileAddr, uint32 Tile)
+{
+	return (ConvertHiresSIMD(pCache, TileAddr, Tile, 2, 1));
+}
+
+#endif
+
+// converters by tile type (TILE_2BIT...), S9xSelectTileConverter() takes the fastest set compiled in
+
+typedef uint8 (*TileConverter) (uint8 *, uint32, uint32);
+
+static TileConverter	ScalarConverters[7] =
+{
+	ConvertTile2, ConvertTile4, ConvertTile8,
+	ConvertTile2h_even, ConvertTile2h_odd, ConvertTile4h_even, ConvertTile4h_odd
+};
+
+#ifdef S9X_TILE_SIMD
+static TileConverter	SIMDConverters[7] =
+{
+	ConvertTile2SIMD, ConvertTile4SIMD, ConvertTile8SIMD,
+	ConvertTile2h_evenSIMD, ConvertTile2h_oddSIMD, ConvertTile4h_evenSIMD, ConvertTile4h_oddSIMD
+};
+
+static TileConverter	* const Converters = SIMDConverters;
+#else
+static TileConverter	* const Converters = ScalarConverters;
+#endif
+
+bool8 S9xHasSIMDTileConverter (void)
+{
+	return (Converters != ScalarConverters);
+}
+
+uint8 S9xConvertTile (int type, bool8 simd, uint8 *pCache, uint32 TileAddr, uint32 Tile)
+{
+#ifdef S9X_TILE_SIMD
+	if (simd)
+		return (SIMDConverters[type](pCache, TileAddr, Tile));
+#endif
+	return (ScalarConverters[type](pCache, TileAddr, Tile));
+}
+
+// VRAM writes only count up the generation of their 16-byte block. A cached tile is current as long as
+// the sum of the generations of the blocks it was converted from is the one stored with it; hires tiles
+// also read the next tile (tile 0x3ff wraps around to tile 0 like in the converters).
+
+static inline uint32 TileGeneration (uint32 TileAddr, uint32 Tile)
+{
+	uint32	*generation = IPPU.VRAMGeneration;
+	uint32	blocks = 1 << (BG.TileShift - 4);
+	uint32	block = TileAddr >> 4;
+	uint32	sum = 0;
+
+	for (uint32 i = 0; i < blocks; i++)
+		sum += generation[(block + i) & (MAX_VRAM_BLOCKS - 1)];
+
+	if (BG.TilePairs)
+	{
+		block = ((Tile == 0x3ff) ? TileAddr - (0x3ff << BG.TileShift) : TileAddr + (1 << BG.TileShift)) >> 4;
+
+		for (uint32 i = 0; i < blocks; i++)
+			sum += generation[(block + i) & (MAX_VRAM_BLOCKS - 1)];
+	}
+
+	return (sum);
+}
+
+// Mode 7 fetch shared by all DrawMode7 renderers. Reads the pixels of Count screen pixels starting at
+// map position ((AA + BB) >> 8, (CC + DD) >> 8) and stepping by (aa, cc); what Mode7Repeat leaves
+// transparent outside the 1024x1024 map comes out as 0. With SSE2 the affine steps, wrap and VRAM
+// addresses are worked out four pixels at a time, only the two dependent loads stay scalar.
+
+static void FetchMode7Line (uint8 *Pixels, uint32 Count, int AA, int BB, int CC, int DD, int aa, int cc)
+{
+	uint8	*VRAM1 = Memory.VRAM + 1;
+	uint8	repeat = PPU.Mode7Repeat;
+	uint32	x = 0;
+
+#ifdef S9X_TILE_SIMD
+	const __m128i	map_mask = _mm_set1_epi32(repeat ? ~0x3ff : 0);
+	const __m128i	wrap_mask = _mm_set1_epi32(0x3ff);
+	const __m128i	step_x = _mm_set1_epi32(aa * 4);
+	const __m128i	step_y = _mm_set1_epi32(cc * 4);
+	__m128i			xs = _mm_setr_epi32(AA + BB, AA + BB + aa, AA + BB + aa * 2, AA + BB + aa * 3);
+	__m128i			ys = _mm_setr_epi32(CC + DD, CC + DD + cc, CC + DD + cc * 2, CC + DD + cc * 3);
+
+	for (; x + 4 <= Count; x += 4, xs = _mm_add_epi32(xs, step_x), ys = _mm_add_epi32(ys, step_y))
+	{
+		__m128i	X = _mm_srai_epi32(xs, 8);
+		__m128i	Y = _mm_srai_epi32(ys, 8);
+		__m128i	outside = _mm_and_si128(_mm_or_si128(X, Y), map_mask);
+
+		X = _mm_and_si128(X, wrap_mask);
+		Y = _mm_and_si128(Y, wrap_mask);
+
+		__m128i	tile = _mm_add_epi32(_mm_slli_epi32(_mm_and_si128(Y, _mm_set1_epi32(0x3f8)), 5), _mm_and_si128(_mm_srli_epi32(X, 2), _mm_set1_epi32(0xfe)));
+		__m128i	texel = _mm_add_epi32(_mm_slli_epi32(_mm_and_si128(Y, _mm_set1_epi32(7)), 4), _mm_slli_epi32(_mm_and_si128(X, _mm_set1_epi32(7)), 1));
+		int32	tiles[4], texels[4], outsides[4];
+
+		_mm_storeu_si128((__m128i *) tiles, tile);
+		_mm_storeu_si128((__m128i *) texels, texel);
+		_mm_storeu_si128((__m128i *) outsides, outside);
+
+		for (int i = 0; i < 4; i++)
+		{
+			if (!outsides[i])
+				Pixels[x + i] = VRAM1[(Memory.VRAM[tiles[i]] << 7) + texels[i]];
+			else
+				Pixels[x + i] = (repeat == 3) ? VRAM1[texels[i]] : 0;
+		}
+	}
+
+	AA += aa * x;
+	CC += cc * x;
+#endif
+
+	for (; x < Count; x++, AA += aa, CC += cc)
+	{
+		int	X = ((AA + BB) >> 8);
+		int	Y = ((CC + DD) >> 8);
+
+		if (!repeat)
+		{
+			X &= 0x3ff;
+			Y &= 0x3ff;
+		}
+
+		if (((X | Y) & ~0x3ff) == 0)
+		{
+			uint8	*TileData = VRAM1 + (Memory.VRAM[((Y & ~7) << 5) + ((X >> 2) & ~1)] << 7);
+			Pixels[x] = *(TileData + ((Y & 7) << 4) + ((X & 7) << 1));
+		}
+		else
+		if (repeat == 3)
+			Pixels[x] = *(VRAM1    + ((Y & 7) << 4) + ((X & 7) << 1));
+		else
+			Pixels[x] = 0;
+	}
+}
+
 // First-level include: Get all the renderers.
 
 #include "tile.cpp"
 
+// SSE2 versions of the DrawTile16 Normal1x1 renderers, the ones nearly every frame is drawn
+// with. A tile row of 8 pixels is depth tested, looked up and blended at once. Colour math works
+// on the colour fields in place, which matches the X2/ZERO tables of gfx.cpp for the layouts
+// SelectTileSIMD() accepts (green in the middle, no alpha). The clipped, mosaic, hires and
+// interlace renderers stay scalar, as they draw partial rows.
+
+#ifdef S9X_TILE_SIMD
+
+static inline __m128i SelectBits (__m128i mask, __m128i a, __m128i b)
+{
+	return (_mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b)));
+}
+
+// reverses the 8 pixels of a tile row, SSE2 is always little endian
+static inline uint64 FlipRow (uint64 row)
+{
+	row = ((row & 0x00ff00ff00ff00ffULL) << 8)  | ((row >> 8)  & 0x00ff00ff00ff00ffULL);
+	row = ((row & 0x0000ffff0000ffffULL) << 16) | ((row >> 16) & 0x0000ffff0000ffffULL);
+	return ((row << 32) | (row >> 32));
+}
+
+// COLOR_ADD: per field saturating add, done with each field moved up to bit 15
+static inline __m128i TileColorAdd (__m128i a, __m128i b)
+{
+	__m128i	result = _mm_setzero_si128();
+
+	for (int i = 0; i < 3; i++)
+	{
+		__m128i	mask  = _mm_set1_epi16(TileSIMD.FieldMask[i]);
+		__m128i	shift = _mm_cvtsi32_si128(TileSIMD.FieldShift[i]);
+		__m128i	sum   = _mm_adds_epu16(_mm_sll_epi16(_mm_and_si128(a, mask), shift), _mm_sll_epi16(_mm_and_si128(b, mask), shift));
+
+		result = _mm_or_si128(result, _mm_and_si128(_mm_srl_epi16(sum, shift), mask));
+	}
+
+	return (result);
+}
+
+// COLOR_ADD1_2: the sum of the fields with their low bits removed is even, so the rounding of avg does not matter
+static inline __m128i TileColorAdd1_2 (__m128i a, __m128i b)
+{
+	__m128i	low = _mm_set1_epi16(TileSIMD.LowMask);
+
+	return (_mm_add_epi16(_mm_avg_epu16(_mm_andnot_si128(low, a), _mm_andnot_si128(low, b)), _mm_and_si128(_mm_and_si128(a, b), low)));
+}
+
+// COLOR_SUB: per field saturating subtract
+static inline __m128i TileColorSub (__m128i a, __m128i b)
+{
+	__m128i	result = _mm_setzero_si128();
+
+	for (int i = 0; i < 3; i++)
+	{
+		__m128i	mask = _mm_set1_epi16(TileSIMD.FieldMask[i]);
+
+		result = _mm_or_si128(result, _mm_subs_epu16(_mm_and_si128(a, mask), _mm_and_si128(b, mask)));
+	}
+
+	return (result);
+}
+
+// COLOR_SUB1_2: the ZERO table halves the difference against b without its low bits
+static inline __m128i TileColorSub1_2 (__m128i a, __m128i b)
+{
+	__m128i	result = _mm_setzero_si128();
+	__m128i	b_high = _mm_andnot_si128(_mm_set1_epi16(TileSIMD.LowMask), b);
+
+	for (int i = 0; i < 3; i++)
+	{
+		__m128i	mask = _mm_set1_epi16(TileSIMD.FieldMask[i]);
+		__m128i	diff = _mm_subs_epu16(_mm_and_si128(a, mask), _mm_and_si128(b_high, mask));
+
+		result = _mm_or_si128(result, _mm_and_si128(_mm_srli_epi16(diff, 1), mask));
+	}
+
+	return (result);
+}
+
+// the seven math modes of the scalar renderers, in the order of the Renderers_ tables
+template<int Math>
+static inline __m128i TileMath (__m128i main, __m128i sub, __m128i use_sub)
+{
+	__m128i	fixed = _mm_set1_epi16((uint16) GFX.FixedColour);
+
+	switch (Math)
+	{
+		case 1:	return (TileColorAdd(main, SelectBits(use_sub, sub, fixed)));
+		case 2:	return (GFX.ClipColors ? TileColorAdd(main, fixed) : TileColorAdd1_2(main, fixed));
+		case 3:	return (GFX.ClipColors ? TileColorAdd(main, SelectBits(use_sub, sub, fixed)) : SelectBits(use_sub, TileColorAdd1_2(main, sub), TileColorAdd(main, fixed)));
+		case 4:	return (TileColorSub(main, SelectBits(use_sub, sub, fixed)));
+		case 5:	return (GFX.ClipColors ? TileColorSub(main, fixed) : TileColorSub1_2(main, fixed));
+		case 6:	return (GFX.ClipColors ? TileColorSub(main, SelectBits(use_sub, sub, fixed)) : SelectBits(use_sub, TileColorSub1_2(main, sub), TileColorSub(main, fixed)));
+		default: return (main);
+	}
+}
+
+template<int Math>
+static void DrawTile16SIMD (uint32 Tile, uint32 Offset, uint32 StartLine, uint32 LineCount)
+{
+	uint8	*pCache;
+	uint8	*bp;
+	int32	step;
+
+	GET_CACHED_TILE();
+	if (IS_BLANK_TILE())
+		return;
+	SELECT_PALETTE();
+
+	if (Tile & V_FLIP)
+	{
+		bp = pCache + 56 - StartLine;
+		step = -8;
+	}
+	else
+	{
+		bp = pCache + StartLine;
+		step = 8;
+	}
+
+	const __m128i	bias = _mm_set1_epi8((char) 0x80);
+	const __m128i	z1 = _mm_set1_epi8((char) (GFX.Z1 ^ 0x80));
+	const __m128i	z2 = _mm_set1_epi8((char) GFX.Z2);
+	const __m128i	zero = _mm_setzero_si128();
+	const __m128i	sub_bit = _mm_set1_epi16(0x20);
+	const uint16	*colors = GFX.ScreenColors;
+
+	for (uint32 l = LineCount; l > 0; l--, bp += step, Offset += GFX.PPL)
+	{
+		uint64	row;
+		memcpy(&row, bp, 8);
+		if (!row)
+			continue;
+
+		if (Tile & H_FLIP)
+			row = FlipRow(row);
+
+		__m128i	pix   = _mm_loadl_epi64((const __m128i *) &row);
+		__m128i	depth = _mm_loadl_epi64((const __m128i *) (GFX.DB + Offset));
+		__m128i	draw  = _mm_andnot_si128(_mm_cmpeq_epi8(pix, zero), _mm_cmpgt_epi8(z1, _mm_xor_si128(depth, bias)));
+
+		if (!(_mm_movemask_epi8(draw) & 0xff))
+			continue;
+
+		uint16	main[8];
+		for (int i = 0; i < 8; i++, row >>= 8)
+			main[i] = colors[row & 0xff];
+
+		__m128i	color = _mm_loadu_si128((const __m128i *) main);
+
+		if (Math)
+		{
+			__m128i	sub     = _mm_loadu_si128((const __m128i *) (GFX.SubScreen + Offset));
+			__m128i	sd      = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (GFX.SubZBuffer + Offset)), zero);
+			__m128i	use_sub = _mm_cmpeq_epi16(_mm_and_si128(sd, sub_bit), sub_bit);
+
+			color = TileMath<Math>(color, sub, use_sub);
+		}
+
+		__m128i	draw16 = _mm_unpacklo_epi8(draw, draw);
+		__m128i	screen = _mm_loadu_si128((const __m128i *) (GFX.S + Offset));
+
+		_mm_storeu_si128((__m128i *) (GFX.S + Offset), SelectBits(draw16, color, screen));
+		_mm_storel_epi64((__m128i *) (GFX.DB + Offset), SelectBits(draw, z2, depth));
+	}
+}
+
+static void (*Renderers_DrawTile16Normal1x1SIMD[7]) (uint32, uint32, uint32, uint32) =
+{
+	DrawTile16SIMD<0>,
+	DrawTile16SIMD<1>,
+	DrawTile16SIMD<2>,
+	DrawTile16SIMD<3>,
+	DrawTile16SIMD<4>,
+	DrawTile16SIMD<5>,
+	DrawTile16SIMD<6>
+};
+
+// whether the current pixel format is one the vector colour math was checked against
+static bool8 SelectTileSIMD (void)
+{
+	uint32	masks[3] = { FIRST_COLOR_MASK, SECOND_COLOR_MASK, THIRD_COLOR_MASK };
+
+	if (ALPHA_BITS_MASK || masks[2] != 0x001f ||
+		!((masks[0] == 0xf800 && masks[1] == 0x07e0) || (masks[0] == 0x7c00 && masks[1] == 0x03e0)))
+		return (FALSE);
+
+	TileSIMD.LowMask = 0;
+
+	for (int i = 0; i < 3; i++)
+	{
+		uint16	shift = 0;
+		while (!((masks[i] << shift) & 0x8000))
+			shift++;
+
+		TileSIMD.FieldMask[i] = (uint16) masks[i];
+		TileSIMD.FieldShift[i] = shift;
+		TileSIMD.LowMask |= masks[i] & (0 - masks[i]);
+	}
+
+	return (TRUE);
+}
+
+#endif
+
 // Functions to select which converter and renderer to use.
 
 void S9xSelectTileRenderers (int BGMode, bool8 sub, bool8 obj)
@@ -499,6 +959,10 @@ void S9xSelectTileRenderers (int BGMode, bool8 sub, bool8 obj)
 	if (!IPPU.DoubleWidthPixels)	// normal width
 	{
 		DT     = Renderers_DrawTile16Normal1x1;
+	#ifdef S9X_TILE_SIMD
+		if (SelectTileSIMD())
+			DT = Renderers_DrawTile16Normal1x1SIMD;
+	#endif
 		DCT    = Renderers_DrawClippedTile16Normal1x1;
 		DMP    = Renderers_DrawMosaicPixel16Normal1x1;
 		DB     = Renderers_DrawBackdrop16Normal1x1;
@@ -588,10 +1052,12 @@ void S9xSelectTileConverter (int depth, bool8 hires, bool8 sub, bool8 mosaic)
 	switch (depth)
 	{
 		case 8:
-			BG.ConvertTile      = BG.ConvertTileFlip = ConvertTile8;
+			BG.ConvertTile      = BG.ConvertTileFlip = Converters[TILE_8BIT];
 			BG.Buffer           = BG.BufferFlip      = IPPU.TileCache[TILE_8BIT];
 			BG.Buffered         = BG.BufferedFlip    = IPPU.TileCached[TILE_8BIT];
+			BG.Stamp            = BG.StampFlip       = IPPU.TileStamp[TILE_8BIT];
 			BG.TileShift        = 6;
+			BG.TilePairs        = FALSE;
 			BG.PaletteShift     = 0;
 			BG.PaletteMask      = 0;
 			BG.DirectColourMode = Memory.FillRAM[0x2130] & 1;
@@ -603,31 +1069,37 @@ void S9xSelectTileConverter (int depth, bool8 hires, bool8 sub, bool8 mosaic)
 			{
 				if (sub || mosaic)
 				{
-					BG.ConvertTile     = ConvertTile4h_even;
+					BG.ConvertTile     = Converters[TILE_4BIT_EVEN];
 					BG.Buffer          = IPPU.TileCache[TILE_4BIT_EVEN];
 					BG.Buffered        = IPPU.TileCached[TILE_4BIT_EVEN];
-					BG.ConvertTileFlip = ConvertTile4h_odd;
+					BG.Stamp           = IPPU.TileStamp[TILE_4BIT_EVEN];
+					BG.ConvertTileFlip = Converters[TILE_4BIT_ODD];
 					BG.BufferFlip      = IPPU.TileCache[TILE_4BIT_ODD];
 					BG.BufferedFlip    = IPPU.TileCached[TILE_4BIT_ODD];
+					BG.StampFlip       = IPPU.TileStamp[TILE_4BIT_ODD];
 				}
 				else
 				{
-					BG.ConvertTile     = ConvertTile4h_odd;
+					BG.ConvertTile     = Converters[TILE_4BIT_ODD];
 					BG.Buffer          = IPPU.TileCache[TILE_4BIT_ODD];
 					BG.Buffered        = IPPU.TileCached[TILE_4BIT_ODD];
-					BG.ConvertTileFlip = ConvertTile4h_even;
+					BG.Stamp           = IPPU.TileStamp[TILE_4BIT_ODD];
+					BG.ConvertTileFlip = Converters[TILE_4BIT_EVEN];
 					BG.BufferFlip      = IPPU.TileCache[TILE_4BIT_EVEN];
 					BG.BufferedFlip    = IPPU.TileCached[TILE_4BIT_EVEN];
+					BG.StampFlip       = IPPU.TileStamp[TILE_4BIT_EVEN];
 				}
 			}
 			else
 			{
-				BG.ConvertTile = BG.ConvertTileFlip = ConvertTile4;
+				BG.ConvertTile = BG.ConvertTileFlip = Converters[TILE_4BIT];
 				BG.Buffer      = BG.BufferFlip      = IPPU.TileCache[TILE_4BIT];
 				BG.Buffered    = BG.BufferedFlip    = IPPU.TileCached[TILE_4BIT];
+				BG.Stamp       = BG.StampFlip       = IPPU.TileStamp[TILE_4BIT];
 			}
 
 			BG.TileShift        = 5;
+			BG.TilePairs        = hires;
 			BG.PaletteShift     = 10 - 4;
 			BG.PaletteMask      = 7 << 4;
 			BG.DirectColourMode = FALSE;
@@ -639,31 +1111,37 @@ void S9xSelectTileConverter (int depth, bool8 hires, bool8 sub, bool8 mosaic)
 			{
 				if (sub || mosaic)
 				{
-					BG.ConvertTile     = ConvertTile2h_even;
+					BG.ConvertTile     = Converters[TILE_2BIT_EVEN];
 					BG.Buffer          = IPPU.TileCache[TILE_2BIT_EVEN];
 					BG.Buffered        = IPPU.TileCached[TILE_2BIT_EVEN];
-					BG.ConvertTileFlip = ConvertTile2h_odd;
+					BG.Stamp           = IPPU.TileStamp[TILE_2BIT_EVEN];
+					BG.ConvertTileFlip = Converters[TILE_2BIT_ODD];
 					BG.BufferFlip      = IPPU.TileCache[TILE_2BIT_ODD];
 					BG.BufferedFlip    = IPPU.TileCached[TILE_2BIT_ODD];
+					BG.StampFlip       = IPPU.TileStamp[TILE_2BIT_ODD];
 				}
 				else
 				{
-					BG.ConvertTile     = ConvertTile2h_odd;
+					BG.ConvertTile     = Converters[TILE_2BIT_ODD];
 					BG.Buffer          = IPPU.TileCache[TILE_2BIT_ODD];
 					BG.Buffered        = IPPU.TileCached[TILE_2BIT_ODD];
-					BG.ConvertTileFlip = ConvertTile2h_even;
+					BG.Stamp           = IPPU.TileStamp[TILE_2BIT_ODD];
+					BG.ConvertTileFlip = Converters[TILE_2BIT_EVEN];
 					BG.BufferFlip      = IPPU.TileCache[TILE_2BIT_EVEN];
 					BG.BufferedFlip    = IPPU.TileCached[TILE_2BIT_EVEN];
+					BG.StampFlip       = IPPU.TileStamp[TILE_2BIT_EVEN];
 				}
 			}
 			else
 			{
-				BG.ConvertTile = BG.ConvertTileFlip = ConvertTile2;
+				BG.ConvertTile = BG.ConvertTileFlip = Converters[TILE_2BIT];
 				BG.Buffer      = BG.BufferFlip      = IPPU.TileCache[TILE_2BIT];
 				BG.Buffered    = BG.BufferedFlip    = IPPU.TileCached[TILE_2BIT];
+				BG.Stamp       = BG.StampFlip       = IPPU.TileStamp[TILE_2BIT];
 			}
 
 			BG.TileShift        = 4;
+			BG.TilePairs        = hires;
 			BG.PaletteShift     = 10 - 2;
 			BG.PaletteMask      = 7 << 2;
 			BG.DirectColourMode = FALSE;
@@ -684,21 +1162,31 @@ void S9xSelectTileConverter (int depth, bool8 hires, bool8 sub, bool8 mosaic)
 		TileAddr += BG.NameSelect; \
 	TileAddr &= 0xffff; \
 	TileNumber = TileAddr >> BG.TileShift; \
+	uint32	TileStamp = TileGeneration(TileAddr, Tile & 0x3ff); \
+	uint8	*pBuffered; \
 	if (Tile & H_FLIP) \
 	{ \
 		pCache = &BG.BufferFlip[TileNumber << 6]; \
-		if (!BG.BufferedFlip[TileNumber]) \
-			BG.BufferedFlip[TileNumber] = BG.ConvertTileFlip(pCache, TileAddr, Tile & 0x3ff); \
+		pBuffered = &BG.BufferedFlip[TileNumber]; \
+		if (!*pBuffered || BG.StampFlip[TileNumber] != TileStamp) \
+		{ \
+			*pBuffered = BG.ConvertTileFlip(pCache, TileAddr, Tile & 0x3ff); \
+			BG.StampFlip[TileNumber] = TileStamp; \
+		} \
 	} \
 	else \
 	{ \
 		pCache = &BG.Buffer[TileNumber << 6]; \
-		if (!BG.Buffered[TileNumber]) \
-			BG.Buffered[TileNumber] = BG.ConvertTile(pCache, TileAddr, Tile & 0x3ff); \
+		pBuffered = &BG.Buffered[TileNumber]; \
+		if (!*pBuffered || BG.Stamp[TileNumber] != TileStamp) \
+		{ \
+			*pBuffered = BG.ConvertTile(pCache, TileAddr, Tile & 0x3ff); \
+			BG.Stamp[TileNumber] = TileStamp; \
+		} \
 	}
 
 #define IS_BLANK_TILE() \
-	(BG.Buffered[TileNumber] == BLANK_TILE)
+	(*pBuffered == BLANK_TILE)
 
 #define SELECT_PALETTE() \
 	if (BG.DirectColourMode) \
@@ -1023,7 +1511,7 @@ void S9xSelectTileConverter (int depth, bool8 hires, bool8 sub, bool8 mosaic)
 
 #define CLIP_10_BIT_SIGNED(a)	(((a) & 0x2000) ? ((a) | ~0x3ff) : ((a) & 0x3ff))
 
-extern struct SLineMatrixData	LineMatrixData[240];
+extern S9X_TLS struct SLineMatrixData	LineMatrixData[240];
 
 #define NO_INTERLACE	1
 #define Z1				(D + 7)
@@ -1033,8 +1521,6 @@ extern struct SLineMatrixData	LineMatrixData[240];
 #define BG				0
 
 #define DRAW_TILE_NORMAL() \
-	uint8	*VRAM1 = Memory.VRAM + 1; \
-	\
 	if (DCMODE) \
 	{ \
 		if (IPPU.DirectColourMapsNeedRebuild) \
@@ -1090,48 +1576,19 @@ extern struct SLineMatrixData	LineMatrixData[240];
 		int	CC = l->MatrixC * startx + ((l->MatrixC * xx) & ~63); \
 		\
 		uint8	Pix; \
+		uint8	Pixels[256]; \
+		\
+		FetchMode7Line(Pixels, Right - Left, AA, BB, CC, DD, aa, cc); \
 		\
-		if (!PPU.Mode7Repeat) \
+		for (uint32 x = Left; x < Right; x++) \
 		{ \
-			for (uint32 x = Left; x < Right; x++, AA += aa, CC += cc) \
-			{ \
-				int	X = ((AA + BB) >> 8) & 0x3ff; \
-				int	Y = ((CC + DD) >> 8) & 0x3ff; \
-				\
-				uint8	*TileData = VRAM1 + (Memory.VRAM[((Y & ~7) << 5) + ((X >> 2) & ~1)] << 7); \
-				uint8	b = *(TileData + ((Y & 7) << 4) + ((X & 7) << 1)); \
-				\
-				DRAW_PIXEL(x, Pix = (b & MASK)); \
-			} \
-		} \
-		else \
-		{ \
-			for (uint32 x = Left; x < Right; x++, AA += aa, CC += cc) \
-			{ \
-				int	X = ((AA + BB) >> 8); \
-				int	Y = ((CC + DD) >> 8); \
-				\
-				uint8	b; \
-				\
-				if (((X | Y) & ~0x3ff) == 0) \
-				{ \
-					uint8	*TileData = VRAM1 + (Memory.VRAM[((Y & ~7) << 5) + ((X >> 2) & ~1)] << 7); \
-					b = *(TileData + ((Y & 7) << 4) + ((X & 7) << 1)); \
-				} \
-				else \
-				if (PPU.Mode7Repeat == 3) \
-					b = *(VRAM1    + ((Y & 7) << 4) + ((X & 7) << 1)); \
-				else \
-					continue; \
-				\
-				DRAW_PIXEL(x, Pix = (b & MASK)); \
-			} \
+			uint8	b = Pixels[x - Left]; \
+			\
+			DRAW_PIXEL(x, Pix = (b & MASK)); \
 		} \
 	}
 
 #define DRAW_TILE_MOSAIC() \
-	uint8	*VRAM1 = Memory.VRAM + 1; \
-	\
 	if (DCMODE) \
 	{ \
 		if (IPPU.DirectColourMapsNeedRebuild) \
@@ -1208,63 +1665,20 @@ extern struct SLineMatrixData	LineMatrixData[240];
 		int	CC = l->MatrixC * startx + ((l->MatrixC * xx) & ~63); \
 		\
 		uint8	Pix; \
-		uint8	ctr = 1; \
+		uint8	Pixels[256]; \
 		\
-		if (!PPU.Mode7Repeat) \
-		{ \
-			for (int32 x = MLeft; x < MRight; x++, AA += aa, CC += cc) \
-			{ \
-				if (--ctr) \
-					continue; \
-				ctr = HMosaic; \
-				\
-				int	X = ((AA + BB) >> 8) & 0x3ff; \
-				int	Y = ((CC + DD) >> 8) & 0x3ff; \
-				\
-				uint8	*TileData = VRAM1 + (Memory.VRAM[((Y & ~7) << 5) + ((X >> 2) & ~1)] << 7); \
-				uint8	b = *(TileData + ((Y & 7) << 4) + ((X & 7) << 1)); \
-				\
-				if ((Pix = (b & MASK))) \
-				{ \
-					for (int32 h = MosaicStart; h < VMosaic; h++) \
-					{ \
-						for (int32 w = x + HMosaic - 1; w >= x; w--) \
-							DRAW_PIXEL(w + h * GFX.PPL, (w >= (int32) Left && w < (int32) Right)); \
-					} \
-				} \
-			} \
-		} \
-		else \
+		FetchMode7Line(Pixels, (MRight - MLeft) / HMosaic, AA, BB, CC, DD, aa * HMosaic, cc * HMosaic); \
+		\
+		for (int32 x = MLeft, i = 0; x < MRight; x += HMosaic, i++) \
 		{ \
-			for (int32 x = MLeft; x < MRight; x++, AA += aa, CC += cc) \
+			uint8	b = Pixels[i]; \
+			\
+			if ((Pix = (b & MASK))) \
 			{ \
-				if (--ctr) \
-					continue; \
-				ctr = HMosaic; \
-				\
-				int	X = ((AA + BB) >> 8); \
-				int	Y = ((CC + DD) >> 8); \
-				\
-				uint8	b; \
-				\
-				if (((X | Y) & ~0x3ff) == 0) \
-				{ \
-					uint8	*TileData = VRAM1 + (Memory.VRAM[((Y & ~7) << 5) + ((X >> 2) & ~1)] << 7); \
-					b = *(TileData + ((Y & 7) << 4) + ((X & 7) << 1)); \
-				} \
-				else \
-				if (PPU.Mode7Repeat == 3) \
-					b = *(VRAM1    + ((Y & 7) << 4) + ((X & 7) << 1)); \
-				else \
-					continue; \
-				\
-				if ((Pix = (b & MASK))) \
+				for (int32 h = MosaicStart; h < VMosaic; h++) \
 				{ \
-					for (int32 h = MosaicStart; h < VMosaic; h++) \
-					{ \
-						for (int32 w = x + HMosaic - 1; w >= x; w--) \
-							DRAW_PIXEL(w + h * GFX.PPL, (w >= (int32) Left && w < (int32) Right)); \
-					} \
+					for (int32 w = x + HMosaic - 1; w >= x; w--) \
+						DRAW_PIXEL(w + h * GFX.PPL, (w >= (int32) Left && w < (int32) Right)); \
 				} \
 			} \
 		} \
@@ -182,5 +182,9 @@
 void S9xInitTileRenderer (void);
 void S9xSelectTileRenderers (int, bool8, bool8);
 void S9xSelectTileConverter (int, bool8, bool8, bool8);
+// Converts one tile of VRAM like the renderers do, with the scalar or the SIMD converters; for
+// benchmarks. Without SIMD support both run the scalar code.
+bool8 S9xHasSIMDTileConverter (void);
+uint8 S9xConvertTile (int, bool8, uint8 *, uint32, uint32);
 
 #endif
@@ -0,0 +1,92 @@
+#include "PixelConverter.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+using namespace SNESOnline;
+
+// Measures the throughput of every pixel conversion kernel the CPU supports, on a frame
+// with the emulator's extended pitch, in megapixels per second. Exits with 1 if a kernel
+// doesn't turn white into full intensity on all channels.
+
+static const int Width = 512;
+static const int Height = 478;
+static const int Pitch = (512 + 4) * 2;
+static const int Iterations = 500;
+
+static const char* formatNames[] = { "RGB565", "RGB555", "BGR565", "BGR555", "GBR565", "GBR555", "RGB5551" };
+static const char* layoutNames[] = { "RGBA", "BGRA", "ARGB" };
+// BUILD_PIXEL(31, 31, 31) of every format, spare bits clear
+static const uint16_t whitePixels[] = { 0xffdf, 0x7fff, 0xffdf, 0x7fff, 0xffdf, 0x7fff, 0xfffe };
+
+static bool ConvertsWhite(const PixelConverter& converter, int format)
+{
+	uint16_t white[16];
+	uint8_t target[16 * 4];
+
+	for (auto& pixel : white)
+		pixel = whitePixels[format];
+
+	converter.ConvertRow(white, target, 16);
+
+	for (auto byte : target)
+	{
+		if (byte != 255)
+			return false;
+	}
+
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<uint16_t> source(Pitch / 2 * Height);
+	std::vector<uint8_t> target(Width * Height * 4);
+
+	uint32_t seed = 12345;
+	for (auto& pixel : source)
+	{
+		seed = seed * 1664525 + 1013904223;
+		pixel = (uint16_t)(seed >> 16);
+	}
+
+	int result = 0;
+
+	for (int format = 0; format < 7; format++)
+	{
+		for (int layout = 0; layout < 3; layout++)
+		{
+			for (auto& name : PixelConverter::GetAvailableKernels())
+			{
+				PixelConverter converter((SourceFormat)format, (TargetLayout)layout);
+				converter.SelectKernel(name);
+
+				if (!ConvertsWhite(converter, format))
+				{
+					std::cout << formatNames[format] << " -> " << layoutNames[layout] << " " << name << ": white is not (255,255,255)" << std::endl;
+					result = 1;
+				}
+
+				// warm up caches and let the CPU leave its power saving states
+				for (int i = 0; i < 10; i++)
+					converter.Convert(source.data(), Pitch, target.data(), Width * 4, Width, Height);
+
+				auto start = std::chrono::high_resolution_clock::now();
+
+				for (int i = 0; i < Iterations; i++)
+					converter.Convert(source.data(), Pitch, target.data(), Width * 4, Width, Height);
+
+				std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+				double pixelsPerSecond = (double)Width * Height * Iterations / elapsed.count();
+
+				std::cout << std::left << std::setw(8) << formatNames[format] << " -> " << std::setw(5) << layoutNames[layout]
+					<< std::setw(8) << name << std::right << std::fixed << std::setprecision(1)
+					<< std::setw(10) << pixelsPerSecond / 1e6 << " MPixel/s" << std::endl;
+			}
+		}
+	}
+
+	return result;
+}
@@ -0,0 +1,470 @@
+#include "S9xContext.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <thread>
+
+using namespace SNESOnline;
+
+// Runs a ROM without window, audio device or pacing and reports framebuffer/audio hashes and
+// timing. Meant for regression and throughput runs on build machines.
+//
+// Arguments (same style as snes-player):
+//   ROM:<file>          ROM to load (required)
+//   SRAM:<file>         SRAM to load
+//   FRAMES:<count>      amount of frames to run, defaults to 600
+//   INPUT:<file>        input script, see LoadInputScript()
+//   HASH-EVERY:<count>  print the framebuffer hash every <count> frames
+//   EXPECT:<hash>       exit with 1 if the final framebuffer hash differs
+//   PROFILE             print frame cost percentiles per subsystem (needs -DSNES_PROFILER=ON)
+//   INSTANCES:<count>   run that many consoles side by side, each on its own thread; all of
+//                       them must end up with identical hashes
+//   STATE-CHECK:<frame> save an in-memory state before that frame, restore it after the last
+//                       frame and replay the rest; the replay must end up with the same picture
+//   REWIND:<megabytes>  keep a rewind history of that size, step back through all of it after the
+//                       last frame and replay from there; the replay must end up with the same picture
+//   RENDER-THREADS:<n>  draw the screen on that many extra threads per console
+//   SUPERFX-THREAD:<m>  run the Super FX on its own thread: ON, or VERIFY to also replay every
+//                       chunk in place; exits with 1 if any of them came out different
+
+static const uint64_t FnvOffset = 14695981039346656037ULL;
+static const uint64_t FnvPrime = 1099511628211ULL;
+
+static uint64_t HashBytes(uint64_t hash, const void* data, size_t size)
+{
+	auto bytes = (const unsigned char*)data;
+
+	for (size_t i = 0; i < size; i++)
+		hash = (hash ^ bytes[i]) * FnvPrime;
+
+	return hash;
+}
+
+static uint64_t HashFrame(const ScreenFrame& frame)
+{
+	uint64_t hash = FnvOffset;
+
+	// only the visible part, the pitch may contain garbage from earlier resolutions
+	for (int y = 0; y < frame.height; y++)
+		hash = HashBytes(hash, (const unsigned char*)frame.pixels + y * frame.pitch, frame.width * 2);
+
+	return hash;
+}
+
+static std::string FormatHash(uint64_t hash)
+{
+	std::ostringstream stream;
+	stream << std::hex << std::setw(16) << std::setfill('0') << hash;
+	return stream.str();
+}
+
+typedef std::map<uint64_t, std::array<std::vector<SNES::S9xGamepadButtons>, 2>> InputScript;
+
+// One line per change of input: "<frame> <pad> [buttons...]", e.g. "120 0 Start A".
+// The buttons stay pressed until the next line for that pad. Lines starting with '#' are ignored.
+static bool LoadInputScript(std::string fileName, InputScript& script)
+{
+	static const std::map<std::string, SNES::S9xGamepadButtons> names =
+	{
+		{ "X", SNES::S9xGamepadButtons::X }, { "B", SNES::S9xGamepadButtons::B },
+		{ "A", SNES::S9xGamepadButtons::A }, { "R", SNES::S9xGamepadButtons::R },
+		{ "L", SNES::S9xGamepadButtons::L }, { "Y", SNES::S9xGamepadButtons::Y },
+		{ "Start", SNES::S9xGamepadButtons::Start }, { "Select", SNES::S9xGamepadButtons::Select },
+		{ "Left", SNES::S9xGamepadButtons::Left }, { "Up", SNES::S9xGamepadButtons::Up },
+		{ "Down", SNES::S9xGamepadButtons::Down }, { "Right", SNES::S9xGamepadButtons::Right },
+	};
+
+	std::ifstream file(fileName);
+	if (!file)
+		return false;
+
+	std::array<std::vector<SNES::S9xGamepadButtons>, 2> state;
+	std::string line;
+	int lineNumber = 0;
+
+	while (std::getline(file, line))
+	{
+		lineNumber++;
+
+		if (line.empty() || (line[0] == '#'))
+			continue;
+
+		std::istringstream stream(line);
+		uint64_t frame;
+		int pad;
+		std::string button;
+
+		if (!(stream >> frame >> pad) || (pad < 0) || (pad > 1))
+		{
+			std::cerr << "[ERROR]: Invalid input script line " << lineNumber << ": \"" << line << "\"." << std::endl;
+			return false;
+		}
+
+		state[pad].clear();
+
+		while (stream >> button)
+		{
+			auto it = names.find(button);
+			if (it == names.end())
+			{
+				std::cerr << "[ERROR]: Unknown button \"" << button << "\" in input script line " << lineNumber << "." << std::endl;
+				return false;
+			}
+
+			state[pad].push_back(it->second);
+		}
+
+		script[frame] = state;
+	}
+
+	return true;
+}
+
+struct SessionResult
+{
+	bool started = false;
+	int width = 0;
+	int height = 0;
+	uint64_t videoHash = 0;
+	uint64_t audioHash = FnvOffset;
+	uint64_t sampleCount = 0;
+	double seconds = 0;			// all frames, without loading the ROM
+	double slowestFrame = 0;
+
+	// STATE-CHECK only
+	size_t stateSize = 0;
+	double saveMicroseconds = 0;	// average of several saves
+	double loadMicroseconds = 0;
+	uint64_t replayVideoHash = 0;
+	uint64_t replayAudioHash = 0;
+
+	// REWIND only
+	RewindStats rewind;
+	int rewindSteps = 0;
+	double stepMicroseconds = 0;	// average
+	uint64_t rewindVideoHash = 0;
+
+	uint64_t renderThreadLines = 0;
+	SuperFXThreadStats superFXThread;
+};
+
+// one line per section, times in milliseconds per frame
+static void PrintProfile(const ProfileSummary& summary)
+{
+	auto print = [](const ProfileSection& section)
+	{
+		std::ostringstream line;
+		line << "profile " << std::left << std::setw(14) << section.name << std::right << std::fixed << std::setprecision(3)
+			<< " p50 " << section.p50 << " p95 " << section.p95 << " p99 " << section.p99 << " max " << section.max
+			<< std::setprecision(1) << " calls " << section.callsPerFrame;
+		std::cout << line.str() << std::endl;
+	};
+
+	std::cout << "profile-frames " << summary.frames << " opcodes-per-frame " << summary.opcodesPerFrame << std::endl;
+	print(summary.frame);
+
+	for (auto& section : summary.sections)
+		print(section);
+}
+
+// applies the input script entry of the given frame; when resuming, the one in effect instead
+static void ApplyInput(S9xContext& console, const InputScript& script, uint64_t frame, bool resume)
+{
+	auto input = script.find(frame);
+
+	if (resume)
+	{
+		input = script.upper_bound(frame);
+		input = (input == script.begin()) ? script.end() : std::prev(input);
+	}
+
+	if (input != script.end())
+	{
+		console.SetGamepadState(0, input->second[0]);
+		console.SetGamepadState(1, input->second[1]);
+	}
+}
+
+// runs one console from ROM load to the last frame; only the first session prints progress
+static SessionResult RunSession(std::string romFile, std::string sramFile, uint64_t frameCount, uint64_t hashEvery, const InputScript& script, bool verbose, bool profile, int64_t stateFrame, int rewindMegabytes, int renderThreads, SuperFXThreadMode superFXThread)
+{
+	SessionResult result;
+	S9xContext console;
+
+	console.EnableRewind(rewindMegabytes);
+	console.SetRenderThreads(renderThreads);
+	console.SetSuperFXThread(superFXThread);
+
+	if (!console.Startup(romFile, sramFile))
+		return result;
+
+	result.started = true;
+	std::vector<int16_t> samples;
+
+	// runs frames [first, last) and chains their audio into audioHash
+	auto runFrames = [&](uint64_t first, uint64_t last, uint64_t& audioHash, bool timed)
+	{
+		for (uint64_t frame = first; frame < last; frame++)
+		{
+			ApplyInput(console, script, frame, frame == first);
+
+			auto frameStart = std::chrono::high_resolution_clock::now();
+			console.RunFrames(1);
+			std::chrono::duration<double> frameTime = std::chrono::high_resolution_clock::now() - frameStart;
+			if (timed)
+				result.slowestFrame = std::max(result.slowestFrame, frameTime.count());
+
+			// drain the audio ring every frame, it would overflow after a few frames otherwise
+			samples.resize(console.GetBufferedSampleCount());
+			console.ReadAudio(samples.data(), samples.size());
+			audioHash = HashBytes(audioHash, samples.data(), samples.size() * 2);
+			if (timed)
+				result.sampleCount += samples.size();
+
+			if (timed && verbose && (hashEvery > 0) && ((frame + 1) % hashEvery == 0))
+				std::cout << "frame " << (frame + 1) << " video " << FormatHash(HashFrame(console.GetFrames().AcquireLatest())) << std::endl;
+		}
+	};
+
+	const uint64_t stateAt = (stateFrame >= 0) ? std::min<uint64_t>(stateFrame, frameCount) : frameCount;
+	std::vector<uint8_t> state;
+	uint64_t audioHashAtState = 0;
+	double saveSeconds = 0;
+	auto start = std::chrono::high_resolution_clock::now();
+
+	runFrames(0, stateAt, result.audioHash, true);
+
+	if (stateFrame >= 0)
+	{
+		const int saves = 100;
+		auto saveStart = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < saves; i++)
+			console.SaveState(state);
+		std::chrono::duration<double, std::micro> saveTime = std::chrono::high_resolution_clock::now() - saveStart;
+
+		result.saveMicroseconds = saveTime.count() / saves;
+		result.stateSize = state.size();
+		audioHashAtState = result.audioHash;
+		saveSeconds = saveTime.count() / 1e6;
+	}
+
+	runFrames(stateAt, frameCount, result.audioHash, true);
+
+	std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+	result.seconds = elapsed.count() - saveSeconds;
+
+	const ScreenFrame& lastFrame = console.GetFrames().AcquireLatest();
+	result.width = lastFrame.width;
+	result.height = lastFrame.height;
+	result.videoHash = HashFrame(lastFrame);
+	result.renderThreadLines = console.GetRenderThreadLines();
+	result.superFXThread = console.GetSuperFXThreadStats();
+
+	if (verbose && profile)
+		PrintProfile(console.GetProfileSummary());
+
+	if (rewindMegabytes > 0)
+	{
+		result.rewind = console.GetRewindStats();
+
+		auto stepStart = std::chrono::high_resolution_clock::now();
+		while (console.RewindStep())
+			result.rewindSteps++;
+		std::chrono::duration<double, std::micro> stepTime = std::chrono::high_resolution_clock::now() - stepStart;
+		result.stepMicroseconds = result.rewindSteps ? stepTime.count() / result.rewindSteps : 0;
+
+		uint64_t ignored = FnvOffset;
+		runFrames(frameCount - result.rewind.frames, frameCount, ignored, false);
+		result.rewindVideoHash = HashFrame(console.GetFrames().AcquireLatest());
+	}
+
+	if (stateFrame >= 0)
+	{
+		auto loadStart = std::chrono::high_resolution_clock::now();
+		bool loaded = console.LoadState(state);
+		std::chrono::duration<double, std::micro> loadTime = std::chrono::high_resolution_clock::now() - loadStart;
+		result.loadMicroseconds = loadTime.count();
+
+		if (loaded)
+		{
+			result.replayAudioHash = audioHashAtState;
+			runFrames(stateAt, frameCount, result.replayAudioHash, false);
+			result.replayVideoHash = HashFrame(console.GetFrames().AcquireLatest());
+		}
+	}
+
+	console.Shutdown();
+	return result;
+}
+
+int main(int argc, char** argv)
+{
+	std::string romFile, sramFile, inputFile, expectedHash;
+	uint64_t frameCount = 600, hashEvery = 0, instanceCount = 1;
+	int64_t stateFrame = -1;
+	int rewindMegabytes = 0;
+	int renderThreads = 0;
+	SuperFXThreadMode superFXThread = SuperFXThreadMode::Off;
+	bool profile = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+
+		if (arg.find("ROM:") == 0)
+			romFile = arg.substr(4);
+		else if (arg.find("SRAM:") == 0)
+			sramFile = arg.substr(5);
+		else if (arg.find("FRAMES:") == 0)
+			frameCount = std::stoull(arg.substr(7));
+		else if (arg.find("INPUT:") == 0)
+			inputFile = arg.substr(6);
+		else if (arg.find("HASH-EVERY:") == 0)
+			hashEvery = std::stoull(arg.substr(11));
+		else if (arg.find("EXPECT:") == 0)
+			expectedHash = arg.substr(7);
+		else if (arg == "PROFILE")
+			profile = true;
+		else if (arg.find("INSTANCES:") == 0)
+			instanceCount = std::max(1ULL, std::stoull(arg.substr(10)));
+		else if (arg.find("STATE-CHECK:") == 0)
+			stateFrame = std::stoll(arg.substr(12));
+		else if (arg.find("REWIND:") == 0)
+			rewindMegabytes = std::stoi(arg.substr(7));
+		else if (arg.find("RENDER-THREADS:") == 0)
+			renderThreads = std::stoi(arg.substr(15));
+		else if (arg == "SUPERFX-THREAD:ON")
+			superFXThread = SuperFXThreadMode::On;
+		else if (arg == "SUPERFX-THREAD:VERIFY")
+			superFXThread = SuperFXThreadMode::Verify;
+		else
+		{
+			std::cerr << "[FATAL-ERROR]: Unknown argument \"" << arg << "\"." << std::endl;
+			return 2;
+		}
+	}
+
+	InputScript script;
+	if (!inputFile.empty() && !LoadInputScript(inputFile, script))
+	{
+		std::cerr << "[FATAL-ERROR]: Could not load input script '" << inputFile << "'." << std::endl;
+		return 2;
+	}
+
+	std::vector<SessionResult> results(instanceCount);
+	std::vector<std::thread> sessions;
+
+	for (uint64_t i = 0; i < instanceCount; i++)
+	{
+		sessions.emplace_back([&, i]
+		{
+			results[i] = RunSession(romFile, sramFile, frameCount, hashEvery, script, i == 0, profile, stateFrame, rewindMegabytes, renderThreads, superFXThread);
+		});
+	}
+
+	for (auto& session : sessions)
+		session.join();
+
+	const SessionResult& first = results[0];
+	if (!first.started)
+	{
+		std::cerr << "[FATAL-ERROR]: Could not load ROM file '" << romFile << "'." << std::endl;
+		return 2;
+	}
+
+	std::string videoHash = FormatHash(first.videoHash);
+	// sessions run in parallel, so the slowest one decides the overall throughput
+	double seconds = 0;
+	for (auto& result : results)
+		seconds = std::max(seconds, result.seconds);
+
+	std::cout << "frames " << frameCount << std::endl;
+	std::cout << "resolution " << first.width << "x" << first.height << std::endl;
+	std::cout << "video " << videoHash << std::endl;
+	std::cout << "audio " << FormatHash(first.audioHash) << " (" << first.sampleCount << " samples)" << std::endl;
+	std::cout << "seconds " << seconds << std::endl;
+	std::cout << "fps " << (seconds > 0 ? frameCount * instanceCount / seconds : 0) << std::endl;
+	std::cout << "slowest-frame-ms " << first.slowestFrame * 1000 << std::endl;
+
+	if (renderThreads > 0)
+		std::cout << "render-threads " << renderThreads << " (" << first.renderThreadLines << " lines drawn by them)" << std::endl;
+
+	if (superFXThread != SuperFXThreadMode::Off)
+	{
+		std::cout << "superfx-thread " << first.superFXThread.lines << " chunks";
+		if (superFXThread == SuperFXThreadMode::Verify)
+			std::cout << ", " << first.superFXThread.mismatches << " different";
+		std::cout << std::endl;
+
+		if (first.superFXThread.mismatches > 0)
+		{
+			std::cerr << "[ERROR]: " << first.superFXThread.mismatches << " Super FX chunks came out different on the thread." << std::endl;
+			return 1;
+		}
+	}
+
+	if (instanceCount > 1)
+	{
+		std::cout << "instances " << instanceCount << std::endl;
+
+		for (uint64_t i = 1; i < instanceCount; i++)
+		{
+			if ((results[i].videoHash != first.videoHash) || (results[i].audioHash != first.audioHash))
+			{
+				std::cerr << "[ERROR]: Instance " << i << " diverged: video " << FormatHash(results[i].videoHash) << ", audio " << FormatHash(results[i].audioHash) << "." << std::endl;
+				return 1;
+			}
+		}
+	}
+
+	if (stateFrame >= 0)
+	{
+		std::cout << "state-size " << first.stateSize << std::endl;
+		std::cout << "state-save-us " << first.saveMicroseconds << std::endl;
+		std::cout << "state-load-us " << first.loadMicroseconds << std::endl;
+
+		// samples waiting in the core's resampler are not part of a state (neither in snes9x's
+		// file format), so the replayed audio may start a few samples off
+		std::cout << "state-replay-audio " << (first.replayAudioHash == first.audioHash ? "identical" : "differs") << std::endl;
+
+		for (uint64_t i = 0; i < instanceCount; i++)
+		{
+			if (results[i].replayVideoHash != results[i].videoHash)
+			{
+				std::cerr << "[ERROR]: Replay from the state of instance " << i << " diverged: video " << FormatHash(results[i].replayVideoHash) << "." << std::endl;
+				return 1;
+			}
+		}
+	}
+
+	if (rewindMegabytes > 0)
+	{
+		const RewindStats& rewind = first.rewind;
+
+		std::cout << "rewind-used " << rewind.used << " of " << rewind.capacity << " bytes" << std::endl;
+		std::cout << "rewind-snapshots " << rewind.snapshots << " (" << rewind.frames << " frames, " << rewind.evictions << " evicted)" << std::endl;
+		std::cout << "rewind-bytes-per-minute " << (rewind.frames > 0 ? rewind.used * 3600 / rewind.frames : 0) << " (state " << rewind.stateSize << " bytes)" << std::endl;
+		std::cout << "rewind-step-us " << first.stepMicroseconds << std::endl;
+
+		for (uint64_t i = 0; i < instanceCount; i++)
+		{
+			if ((results[i].rewindSteps != results[i].rewind.snapshots) || (results[i].rewindVideoHash != results[i].videoHash))
+			{
+				std::cerr << "[ERROR]: Replay after rewinding instance " << i << " diverged: " << results[i].rewindSteps << " steps, video " << FormatHash(results[i].rewindVideoHash) << "." << std::endl;
+				return 1;
+			}
+		}
+	}
+
+	if (!expectedHash.empty() && (expectedHash != videoHash))
+	{
+		std::cerr << "[ERROR]: Expected video hash " << expectedHash << " but got " << videoHash << "." << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
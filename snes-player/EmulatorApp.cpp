@@ -4,11 +4,10 @@ using namespace Engine2D;
 using namespace Framework;
 
 
-extern "C" void gameconsole_read_screen(int width, int height, int* picelsRgbX);
+extern "C" uint64_t gameconsole_acquire_screen(int* width, int* height);
+extern "C" bool gameconsole_convert_screen(void* target, int targetPitch, bool bgra);
 extern "C" bool gameconsole_reset(const char* romFile, const char* sramFile);
 extern "C" void gameconsole_read_audio(uint64_t audioTime, int16_t* pcmData, int pcmDataSizeInBytes);
-extern "C" int gameconsole_get_screen_width();
-extern "C" int gameconsole_get_screen_height();
 
 namespace SNESOnline
 {
@@ -39,8 +38,8 @@ namespace SNESOnline
 
 	void EmulatorApp::OnRender()
 	{
-		int width = gameconsole_get_screen_width();
-		int height = gameconsole_get_screen_height();
+		int width, height;
+		uint64_t sequence = gameconsole_acquire_screen(&width, &height);
 
 		if ((width == 0) || (height == 0))
 		{
@@ -49,18 +48,22 @@ namespace SNESOnline
 		}
 
 		if ((renderTarget == nullptr) || (height != renderTarget->GetHeight()) || (width != renderTarget->GetWidth())){
-			pixels.resize(width * height * 4);
-			renderTarget = std::make_shared<Engine2D::Surface>(width, height);
+			renderTarget = std::make_shared<Engine2D::Surface>(width, height, true);
+			lastFrameSequence = 0;
 		}
 
-		std::cout << "Render. " <<  pixels[10000] << std::endl;
+		// only upload when the emulator finished a new frame, converting straight into texture memory
+		if (sequence != lastFrameSequence)
+		{
+			bool bgra = Engine2D::Surface::GetNativeLayout() == Engine2D::PixelLayout::BGRA;
 
-		gameconsole_read_screen(width, height, (int*)pixels.data());
+			renderTarget->MapTexturePixels([&](void* target, int pitch)
+			{
+				gameconsole_convert_screen(target, pitch, bgra);
+			});
 
-		renderTarget->MapPixels(pixels.size(), [&](void* target)
-		{
-			memcpy(target, pixels.data(), pixels.size());
-		});
+			lastFrameSequence = sequence;
+		}
 
 			SetLogicalViewport(renderTarget->GetWidth(), renderTarget->GetHeight());
 			DrawTexture(renderTarget, { 0, 0, renderTarget->GetWidth(), renderTarget->GetHeight() });
@@ -11,7 +11,7 @@ namespace SNESOnline
 		static Engine2D::AppSettings GetAppSettings();
 
 		std::shared_ptr<Engine2D::Surface> renderTarget;
-		std::vector<unsigned char> pixels;
+		uint64_t lastFrameSequence = 0;
 
 	protected:
 
@@ -0,0 +1,82 @@
+#include "snes9x.h"
+#include "memmap.h"
+#include "ppu.h"
+#include "tile.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+// Measures how fast the tile converters turn VRAM bitplanes into the chunky tile cache, for every
+// tile type, with the table driven and the SIMD code, in megatiles per second. Both have to
+// produce the same cache contents.
+
+static const int Iterations = 200;
+
+static const char* typeNames[] = { "2bit", "4bit", "8bit", "2bit-even", "2bit-odd", "4bit-even", "4bit-odd" };
+static const int tileSizes[] = { 16, 32, 64, 16, 16, 32, 32 };
+
+static void ConvertAll(int type, bool8 simd, uint8_t* cache, uint8_t* results)
+{
+	int count = 0x10000 / tileSizes[type];
+
+	for (int i = 0; i < count; i++)
+		results[i] = S9xConvertTile(type, simd, cache + i * 64, i * tileSizes[type], i & 0x3ff);
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<uint8_t> vram(0x10000);
+	std::vector<uint8_t> scalarCache(4096 * 64), simdCache(4096 * 64);
+	std::vector<uint8_t> scalarResults(4096), simdResults(4096);
+
+	// mostly random tiles, with some blank ones
+	uint32_t seed = 12345;
+	for (size_t i = 0; i < vram.size(); i++)
+	{
+		seed = seed * 1664525 + 1013904223;
+		vram[i] = ((i >> 6) % 5 == 0) ? 0 : (uint8_t)(seed >> 16);
+	}
+
+	Memory.VRAM = vram.data();
+	S9xInitTileRenderer();
+
+	if (!S9xHasSIMDTileConverter())
+		std::cout << "no SIMD converters in this build, both rows run the scalar code" << std::endl;
+
+	for (int type = TILE_2BIT; type <= TILE_4BIT_ODD; type++)
+	{
+		int count = 0x10000 / tileSizes[type];
+
+		ConvertAll(type, FALSE, scalarCache.data(), scalarResults.data());
+		ConvertAll(type, TRUE, simdCache.data(), simdResults.data());
+
+		if (memcmp(scalarCache.data(), simdCache.data(), count * 64) || memcmp(scalarResults.data(), simdResults.data(), count))
+		{
+			std::cout << typeNames[type] << ": SIMD result differs from the scalar converter" << std::endl;
+			return 1;
+		}
+
+		for (int simd = 0; simd < 2; simd++)
+		{
+			uint8_t* cache = simd ? simdCache.data() : scalarCache.data();
+			uint8_t* results = simd ? simdResults.data() : scalarResults.data();
+
+			auto start = std::chrono::high_resolution_clock::now();
+
+			for (int i = 0; i < Iterations; i++)
+				ConvertAll(type, simd, cache, results);
+
+			std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+			double tilesPerSecond = (double)count * Iterations / elapsed.count();
+
+			std::cout << std::left << std::setw(10) << typeNames[type] << std::setw(8) << (simd ? "simd" : "scalar")
+				<< std::right << std::fixed << std::setprecision(1)
+				<< std::setw(10) << tilesPerSecond / 1e6 << " MTiles/s" << std::endl;
+		}
+	}
+
+	return 0;
+}